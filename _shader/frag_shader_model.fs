@@ -0,0 +1,72 @@
+#version 450
+// pairs with vertex_shader_model.vs, writes the HDR color and the bright part bloom blurs.
+// SNGO_BINDLESS: set 1 is EngineGltfModel::layouts.bindless instead of the per-material set
+#ifdef SNGO_BINDLESS
+#extension GL_EXT_nonuniform_qualifier : require
+#endif
+
+layout(set = 0, binding = 0) uniform uniform_buffer_object {
+  mat4 projection;
+  mat4 modelView;
+  mat4 inverseModelview;
+  float exposure;
+}
+ubo;
+
+#ifdef SNGO_BINDLESS
+// BindlessMaterialData
+struct Material {
+  vec4 baseColor_factor;
+  float metallicFactor;
+  float roughnessFactor;
+  float alphaCutoff;
+  uint alphaMode;
+  uint base_color;
+  uint metallic_roughness;
+  uint normal;
+  uint occlusion;
+  uint emissive;
+  uint padding[3];
+};
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+layout(std430, set = 1, binding = 1) readonly buffer material_buffer {
+  Material materials[];
+};
+#else
+layout(set = 1, binding = 0) uniform sampler2D samplerColorMap;
+#endif
+
+layout(location = 0) in vec3 inNormal;
+layout(location = 1) in vec2 inUV;
+layout(location = 2) in vec4 inColor;
+layout(location = 3) in vec3 inViewPos;
+#ifdef SNGO_BINDLESS
+layout(location = 4) flat in uint inMaterial;
+#endif
+
+layout(location = 0) out vec4 outColor;
+layout(location = 1) out vec4 outBright;
+
+void main() {
+#ifdef SNGO_BINDLESS
+  Material material = materials[inMaterial];
+  vec4 base = texture(textures[nonuniformEXT(material.base_color)], inUV)
+              * material.baseColor_factor * inColor;
+  // ALPHAMODE_MASK
+  if (material.alphaMode == 1u && base.a < material.alphaCutoff) {
+    discard;
+  }
+#else
+  vec4 base = texture(samplerColorMap, inUV) * inColor;
+#endif
+
+  // head light, the camera sits at the view space origin
+  vec3 N = normalize(inNormal);
+  vec3 V = normalize(-inViewPos);
+  vec3 color = base.rgb * (0.15 + 0.85 * abs(dot(N, V))) * ubo.exposure;
+
+  outColor = vec4(color, base.a);
+  float luminance = dot(color, vec3(0.2126, 0.7152, 0.0722));
+  outBright = luminance > 1.0 ? vec4(color, 1.0) : vec4(0.0, 0.0, 0.0, 1.0);
+}
@@ -0,0 +1,75 @@
+#version 450
+// EngineGltfModel variants built by construct_pipeline: the SNGO_* input macros come from
+// Vertex_ShaderPrologue, so the float and every compact vertex layout share this source.
+// SNGO_BINDLESS: draws pass the material index as firstInstance, forwarded to the fragment stage.
+// SNGO_INDIRECT: firstInstance indexes the IndirectDrawData update_indirect wrote instead
+
+layout(set = 0, binding = 0) uniform uniform_buffer_object {
+  mat4 projection;
+  mat4 modelView;
+  mat4 inverseModelview;
+  float exposure;
+}
+ubo;
+
+#ifdef SNGO_INDIRECT
+// IndirectDrawData
+struct DrawData {
+  mat4 world;
+  uint material;
+  uint padding[3];
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer draw_buffer {
+  DrawData draws[];
+};
+#endif
+
+layout(location = SNGO_LOC_POS) in SNGO_POS_TYPE inPos;
+#ifdef SNGO_HAS_NORMAL
+layout(location = SNGO_LOC_NORMAL) in SNGO_NORMAL_TYPE inNormal;
+#endif
+#ifdef SNGO_HAS_UV
+layout(location = SNGO_LOC_UV) in SNGO_UV_TYPE inUV;
+#endif
+#ifdef SNGO_HAS_COLOR
+layout(location = SNGO_LOC_COLOR) in SNGO_COLOR_TYPE inColor;
+#endif
+
+layout(location = 0) out vec3 outNormal;
+layout(location = 1) out vec2 outUV;
+layout(location = 2) out vec4 outColor;
+layout(location = 3) out vec3 outViewPos;
+#ifdef SNGO_BINDLESS
+layout(location = 4) flat out uint outMaterial;
+#endif
+
+void main() {
+  vec3 normal = vec3(0.0, 0.0, 1.0);
+#ifdef SNGO_HAS_NORMAL
+  normal = SNGO_DECODE_NORMAL(inNormal);
+#endif
+  outUV = vec2(0.0);
+#ifdef SNGO_HAS_UV
+  outUV = SNGO_DECODE_UV(inUV);
+#endif
+  outColor = vec4(1.0);
+#ifdef SNGO_HAS_COLOR
+  outColor = SNGO_DECODE_COLOR(inColor);
+#endif
+
+#ifdef SNGO_INDIRECT
+  mat4 model_view = ubo.modelView * draws[gl_InstanceIndex].world;
+#else
+  mat4 model_view = ubo.modelView;
+#endif
+  vec4 view_pos = model_view * vec4(SNGO_DECODE_POS(inPos), 1.0);
+  outNormal = mat3(model_view) * normal;
+  outViewPos = view_pos.xyz;
+#if defined(SNGO_INDIRECT)
+  outMaterial = draws[gl_InstanceIndex].material;
+#elif defined(SNGO_BINDLESS)
+  outMaterial = uint(gl_InstanceIndex);
+#endif
+  gl_Position = ubo.projection * view_pos;
+}
@@ -1,8 +1,14 @@
+#include <cstdint>
 #include <cstdlib>
 #include <exception>
 #include <iostream>
 #include <ostream>
+#include <string>
+#include <vector>
 
+#include "src/Core/Source/Buffer/VertexBuffer.hpp"
+#include "src/Core/Utils/FileParse.hpp"
+#include "src/Core/Utils/ObjImport.hpp"
 #include "src/IMGUI/Imgui.h"
 
 #define GLFW_INCLUDE_VULKAN
@@ -16,8 +22,74 @@
 #include <glm/mat4x4.hpp>
 #include <glm/vec4.hpp>
 
-int main()
+// benchmarks instead of the app:
+//   --bench-floats <file> [iterations]  Read_FloatFile against the stdio reader
+//   --bench-obj <file>                  serial against parallel .obj import
+//   --bench-ktx <file> [iterations]     KTX2 transcode throughput, needs the device
+// app options, anywhere on the command line:
+//   --compact-vertices                  quantized vertex regions and their shader variants
+//   --bindless                          one texture table and material buffer for the model
+//   --indirect                          CPU culled multi-draw indirect, implies --bindless
+int main(int argc, char** argv)
 {
+  std::string benchmark_Ktx;
+  uint32_t iterations{16};
+  bool compact_vertices{false};
+  bool bindless_materials{false};
+  bool indirect_draws{false};
+
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; i++)
+    {
+      const std::string arg{argv[i]};
+      if (arg == "--compact-vertices")
+        compact_vertices = true;
+      else if (arg == "--bindless")
+        bindless_materials = true;
+      else if (arg == "--indirect")
+        indirect_draws = true;
+      else
+        args.push_back(arg);
+    }
+
+  if (args.size() >= 2)
+    {
+      const std::string& mode{args[0]};
+      const std::string& file{args[1]};
+      if (args.size() >= 3)
+        iterations = static_cast<uint32_t>(std::stoul(args[2]));
+
+      if (mode == "--bench-floats")
+        {
+          SngoEngine::Core::Utils::Benchmark_FloatFile(file, iterations);
+          return 0;
+        }
+      if (mode == "--bench-obj")
+        {
+          SngoEngine::Core::Utils::Benchmark_ObjImport<
+              SngoEngine::Core::Source::Buffer::DEFAULT_EngineModelVertexData,
+              uint32_t>(file);
+          return 0;
+        }
+      if (mode == "--bench-ktx")
+        benchmark_Ktx = file;
+      else
+        {
+          fmt::println("unknown option {}", mode);
+          return 1;
+        }
+    }
+  else if (!args.empty())
+    {
+      fmt::println("unknown option {}", args[0]);
+      return 1;
+    }
+
   SngoEngine::Imgui::ImguiApplication app;
+  app.benchmark_Ktx = benchmark_Ktx;
+  app.benchmark_Iterations = iterations;
+  app.compact_vertices = compact_vertices;
+  app.bindless_materials = bindless_materials;
+  app.indirect_draws = indirect_draws;
   app.init();
-}
\ No newline at end of file
+}
@@ -35,6 +35,9 @@ void SngoEngine::Core::Device::LogicalDevice::EngineDevice::creator(
   VkPhysicalDeviceFeatures device_features{};
   device_features.sampleRateShading = VK_TRUE;
   device_features.samplerAnisotropy = VK_TRUE;
+  // indirect submission batches whole models with these, and falls back without them
+  device_features.multiDrawIndirect = pPD->enabled_features.multiDrawIndirect;
+  device_features.drawIndirectFirstInstance = pPD->enabled_features.drawIndirectFirstInstance;
 
   // device_features.samplerAnisotropy = VK_TRUE;
 
@@ -58,6 +61,54 @@ void SngoEngine::Core::Device::LogicalDevice::EngineDevice::creator(
   create_info.queueCreateInfoCount = static_cast<uint32_t>(queue_create_infos.size());
   create_info.pEnabledFeatures = &device_features;
 
+  // bindless material tables (EngineGltfModel BindlessMaterials), core since Vulkan 1.2
+  VkPhysicalDeviceDescriptorIndexingFeatures indexing_supported{};
+  indexing_supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+  // frame pacing, core since Vulkan 1.2 as well
+  VkPhysicalDeviceTimelineSemaphoreFeatures timeline_supported{};
+  timeline_supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+  indexing_supported.pNext = &timeline_supported;
+  VkPhysicalDeviceFeatures2 supported{};
+  supported.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  supported.pNext = &indexing_supported;
+  VkPhysicalDeviceDescriptorIndexingFeatures indexing_features{};
+  indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES;
+  VkPhysicalDeviceTimelineSemaphoreFeatures timeline_features{};
+  timeline_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES;
+  VkPhysicalDeviceFeatures2 features2{};
+  features2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+  if (pPD->properties.apiVersion >= VK_API_VERSION_1_2)
+    {
+      vkGetPhysicalDeviceFeatures2(pPD->physical_device, &supported);
+      descriptor_indexing = indexing_supported.shaderSampledImageArrayNonUniformIndexing
+                            && indexing_supported.descriptorBindingSampledImageUpdateAfterBind
+                            && indexing_supported.descriptorBindingPartiallyBound
+                            && indexing_supported.runtimeDescriptorArray;
+      timeline_semaphore = timeline_supported.timelineSemaphore;
+    }
+  void** features_tail{&features2.pNext};
+  if (descriptor_indexing)
+    {
+      indexing_features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+      indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+      indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
+      indexing_features.runtimeDescriptorArray = VK_TRUE;
+      *features_tail = &indexing_features;
+      features_tail = &indexing_features.pNext;
+    }
+  if (timeline_semaphore)
+    {
+      timeline_features.timelineSemaphore = VK_TRUE;
+      *features_tail = &timeline_features;
+      features_tail = &timeline_features.pNext;
+    }
+  if (features2.pNext)
+    {
+      features2.features = device_features;
+      create_info.pNext = &features2;
+      create_info.pEnabledFeatures = nullptr;
+    }
+
   std::vector<const char*> ext_chars{};
   for (auto& iter : required_EXTs)
     ext_chars.push_back(iter.c_str());
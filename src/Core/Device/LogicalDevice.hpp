@@ -49,6 +49,10 @@ struct EngineDevice
 
   // properties
   std::set<std::string> extensions;
+  // sampled image arrays indexed non-uniformly, partially bound and updated after bind
+  bool descriptor_indexing{};
+  // frame pacing with one semaphore (Siganlis::EngineFrameTimeline)
+  bool timeline_semaphore{};
 
  private:
   void creator(PhysicalDevice::EnginePhysicalDevice* _physical_device,
@@ -8,7 +8,11 @@
 
 namespace SngoEngine::Core::Macro
 {
-const int32_t MAX_FRAMES_IN_FLIGHT = 2;
+// slots of every per-frame ring (uniform slices, descriptor pools, command buffers), also the
+// upper bound of the runtime setting; how many frames actually overlap is chosen at startup
+// (Siganlis::EngineFrameTimeline::frames_in_flight)
+const int32_t MAX_FRAMES_IN_FLIGHT = 4;
+const uint32_t DEFAULT_FRAMES_IN_FLIGHT = 2;
 
 const bool ENABLE_VALIDATION_LAYERS = true;
 
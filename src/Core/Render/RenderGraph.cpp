@@ -0,0 +1,686 @@
+#include "RenderGraph.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+#include <utility>
+
+#include "src/Core/Data.h"
+#include "src/Core/Render/RenderPass.hpp"
+#include "src/Core/Source/Image/Image.hpp"
+
+namespace
+{
+using SngoEngine::Core::Render::GraphUsage;
+
+struct UsageState
+{
+  VkImageLayout layout{};
+  VkPipelineStageFlags stage{};
+  VkAccessFlags access{};
+  VkAccessFlags write_access{};
+  VkImageUsageFlags image_usage{};
+};
+
+UsageState usage_state(GraphUsage usage)
+{
+  switch (usage)
+    {
+      case GraphUsage::ColorAttachment:
+        return {VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT};
+      case GraphUsage::DepthAttachment:
+        return {VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT
+                    | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT
+                    | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT,
+                VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT};
+      case GraphUsage::Sampled:
+        return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_ACCESS_SHADER_READ_BIT,
+                0,
+                VK_IMAGE_USAGE_SAMPLED_BIT};
+      case GraphUsage::TransferSrc:
+        return {VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_ACCESS_TRANSFER_READ_BIT,
+                0,
+                VK_IMAGE_USAGE_TRANSFER_SRC_BIT};
+      case GraphUsage::TransferDst:
+        return {VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                VK_PIPELINE_STAGE_TRANSFER_BIT,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_ACCESS_TRANSFER_WRITE_BIT,
+                VK_IMAGE_USAGE_TRANSFER_DST_BIT};
+    }
+  throw std::invalid_argument("unsupported render graph usage!");
+}
+
+VkImageAspectFlags format_aspect(VkFormat format)
+{
+  switch (format)
+    {
+      case VK_FORMAT_D16_UNORM:
+      case VK_FORMAT_X8_D24_UNORM_PACK32:
+      case VK_FORMAT_D32_SFLOAT:
+        return VK_IMAGE_ASPECT_DEPTH_BIT;
+      case VK_FORMAT_D16_UNORM_S8_UINT:
+      case VK_FORMAT_D24_UNORM_S8_UINT:
+      case VK_FORMAT_D32_SFLOAT_S8_UINT:
+        return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+      case VK_FORMAT_S8_UINT:
+        return VK_IMAGE_ASPECT_STENCIL_BIT;
+      default:
+        return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+}
+}  // namespace
+
+//===========================================================================================================================
+// EngineRenderGraph::PassBuilder
+//===========================================================================================================================
+
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder&
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder::read(GraphResource resource,
+                                                               GraphUsage usage)
+{
+  graph->add_access(pass, resource, usage, false);
+  return *this;
+}
+
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder&
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder::write(GraphResource resource,
+                                                                GraphUsage usage)
+{
+  graph->add_access(pass, resource, usage, true);
+  return *this;
+}
+
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder&
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder::side_effect()
+{
+  graph->passes[pass].side_effect = true;
+  return *this;
+}
+
+//===========================================================================================================================
+// EngineRenderGraph
+//===========================================================================================================================
+
+void SngoEngine::Core::Render::EngineRenderGraph::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    const VkAllocationCallbacks* alloc)
+{
+  destroyer();
+  device = _device;
+  Alloc = alloc;
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::destroyer()
+{
+  release();
+  passes.clear();
+  resources.clear();
+  order.clear();
+}
+
+SngoEngine::Core::Render::GraphResource SngoEngine::Core::Render::EngineRenderGraph::create_image(
+    const std::string& name,
+    const GraphImage_Info& info)
+{
+  Resource resource{};
+  resource.name = name;
+  resource.info = info;
+  resources.push_back(resource);
+  return static_cast<GraphResource>(resources.size() - 1);
+}
+
+SngoEngine::Core::Render::GraphResource SngoEngine::Core::Render::EngineRenderGraph::import_image(
+    const std::string& name,
+    const GraphImage_Info& info,
+    VkImageLayout initial_layout,
+    VkImageLayout final_layout,
+    VkPipelineStageFlags initial_stage)
+{
+  Resource resource{};
+  resource.name = name;
+  resource.info = info;
+  resource.imported = true;
+  resource.initial_layout = initial_layout;
+  resource.final_layout = final_layout;
+  resource.initial_stage = initial_stage;
+  resources.push_back(resource);
+  return static_cast<GraphResource>(resources.size() - 1);
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::bind_import(GraphResource resource,
+                                                              VkImage image,
+                                                              VkImageView view)
+{
+  if (!resources.at(resource).imported)
+    {
+      throw std::invalid_argument("failed to bind render graph image, it is not imported!");
+    }
+  resources[resource].image = image;
+  resources[resource].view = view;
+}
+
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder
+SngoEngine::Core::Render::EngineRenderGraph::add_pass(const std::string& name, Execute execute)
+{
+  Pass pass{};
+  pass.name = name;
+  pass.execute = std::move(execute);
+  passes.push_back(std::move(pass));
+  return {this, static_cast<uint32_t>(passes.size() - 1)};
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::add_access(uint32_t pass,
+                                                             GraphResource resource,
+                                                             GraphUsage usage,
+                                                             bool write)
+{
+  if (resource >= resources.size())
+    {
+      throw std::out_of_range("failed to declare render graph access, unknown resource!");
+    }
+  for (const auto& access : passes[pass].accesses)
+    {
+      if (access.resource == resource)
+        {
+          throw std::invalid_argument("failed to declare render graph access, "
+                                      + resources[resource].name + " is used twice by "
+                                      + passes[pass].name);
+        }
+    }
+  passes[pass].accesses.push_back({resource, usage, write});
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::compile()
+{
+  release();
+  cull();
+  sort();
+
+  for (auto& resource : resources)
+    {
+      resource.first = UINT32_MAX;
+      resource.last = 0;
+      resource.usage = resource.info.usage;
+      resource.alias_previous = GRAPH_NO_RESOURCE;
+      resource.state = {};
+    }
+  for (uint32_t position = 0; position < order.size(); position++)
+    {
+      for (const auto& access : passes[order[position]].accesses)
+        {
+          Resource& resource{resources[access.resource]};
+          resource.first = std::min(resource.first, position);
+          resource.last = std::max(resource.last, position);
+          resource.usage |= usage_state(access.usage).image_usage;
+        }
+    }
+
+  // a transient attachment's contents do not survive its render pass
+  for (uint32_t position = 0; position < order.size(); position++)
+    {
+      for (const auto& access : passes[order[position]].accesses)
+        {
+          const Resource& resource{resources[access.resource]};
+          if (!(resource.info.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT))
+            continue;
+          if (resource.imported || resource.first != resource.last
+              || (access.usage != GraphUsage::ColorAttachment
+                  && access.usage != GraphUsage::DepthAttachment))
+            {
+              throw std::runtime_error("failed to compile render graph, transient image "
+                                       + resource.name + " is not only an attachment of "
+                                       + passes[order[resource.first]].name);
+            }
+        }
+    }
+
+  allocate();
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::cull()
+{
+  // a pass survives while something reads one of its writes, imported images always count
+  // as read since they leave the graph
+  std::vector<uint32_t> pass_refs(passes.size());
+  std::vector<uint32_t> resource_refs(resources.size());
+  std::vector<std::vector<uint32_t>> producers(resources.size());
+  for (uint32_t p = 0; p < passes.size(); p++)
+    {
+      passes[p].culled = false;
+      for (const auto& access : passes[p].accesses)
+        {
+          if (access.write)
+            {
+              pass_refs[p]++;
+              producers[access.resource].push_back(p);
+            }
+          else
+            {
+              resource_refs[access.resource]++;
+            }
+        }
+    }
+
+  std::vector<GraphResource> unused;
+  auto cull_pass = [&](uint32_t p) {
+    passes[p].culled = true;
+    for (const auto& access : passes[p].accesses)
+      {
+        if (!access.write && --resource_refs[access.resource] == 0
+            && !resources[access.resource].imported)
+          unused.push_back(access.resource);
+      }
+  };
+
+  for (uint32_t p = 0; p < passes.size(); p++)
+    {
+      if (pass_refs[p] == 0 && !passes[p].side_effect)
+        cull_pass(p);
+    }
+  for (GraphResource r = 0; r < resources.size(); r++)
+    {
+      if (resource_refs[r] == 0 && !resources[r].imported)
+        unused.push_back(r);
+    }
+  while (!unused.empty())
+    {
+      const GraphResource r{unused.back()};
+      unused.pop_back();
+      for (uint32_t p : producers[r])
+        {
+          if (!passes[p].culled && --pass_refs[p] == 0 && !passes[p].side_effect)
+            cull_pass(p);
+        }
+    }
+
+  report.culled = static_cast<uint32_t>(
+      std::count_if(passes.begin(), passes.end(), [](const Pass& pass) { return pass.culled; }));
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::sort()
+{
+  // writers of an image run before its readers, ties keep the declaration order
+  std::vector<std::vector<uint32_t>> next(passes.size());
+  std::vector<uint32_t> incoming(passes.size());
+  std::vector<std::vector<uint32_t>> writers(resources.size());
+  std::vector<std::vector<uint32_t>> readers(resources.size());
+  for (uint32_t p = 0; p < passes.size(); p++)
+    {
+      if (passes[p].culled)
+        continue;
+      for (const auto& access : passes[p].accesses)
+        (access.write ? writers : readers)[access.resource].push_back(p);
+    }
+  for (GraphResource r = 0; r < resources.size(); r++)
+    {
+      for (size_t w = 0; w < writers[r].size(); w++)
+        {
+          if (w + 1 < writers[r].size())
+            next[writers[r][w]].push_back(writers[r][w + 1]);
+          for (uint32_t reader : readers[r])
+            next[writers[r][w]].push_back(reader);
+        }
+    }
+  for (const auto& edges : next)
+    for (uint32_t p : edges)
+      incoming[p]++;
+
+  std::set<uint32_t> ready;
+  uint32_t alive{0};
+  for (uint32_t p = 0; p < passes.size(); p++)
+    {
+      if (passes[p].culled)
+        continue;
+      alive++;
+      if (incoming[p] == 0)
+        ready.insert(p);
+    }
+
+  order.clear();
+  while (!ready.empty())
+    {
+      const uint32_t p{*ready.begin()};
+      ready.erase(ready.begin());
+      order.push_back(p);
+      for (uint32_t n : next[p])
+        {
+          if (--incoming[n] == 0)
+            ready.insert(n);
+        }
+    }
+  if (order.size() != alive)
+    {
+      throw std::runtime_error("failed to compile render graph, its passes form a cycle!");
+    }
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::allocate()
+{
+  struct Candidate
+  {
+    GraphResource resource{};
+    VkMemoryRequirements requirements{};
+  };
+  std::vector<Candidate> candidates;
+
+  for (GraphResource r = 0; r < resources.size(); r++)
+    {
+      Resource& resource{resources[r]};
+      if (resource.imported || resource.first == UINT32_MAX)
+        continue;
+
+      VkImageCreateInfo image_info{Data::ImageCreate_Info{
+          resource.info.format,
+          VkExtent3D{resource.info.extent.width, resource.info.extent.height, 1},
+          VK_IMAGE_TILING_OPTIMAL,
+          resource.usage,
+          1,
+          1,
+          resource.info.samples}};
+      if (vkCreateImage(device->logical_device, &image_info, Alloc, &resource.image) != VK_SUCCESS)
+        {
+          throw std::runtime_error("failed to create render graph image " + resource.name);
+        }
+
+      Candidate candidate{r, {}};
+      vkGetImageMemoryRequirements(device->logical_device, resource.image, &candidate.requirements);
+      candidates.push_back(candidate);
+      report.requested += candidate.requirements.size;
+    }
+
+  // largest first, so a block is sized by its first occupant; everything is bound at offset 0
+  // and all images are optimal tiling, so neither alignment nor granularity can conflict
+  std::sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+    return a.requirements.size > b.requirements.size;
+  });
+  const VkMemoryPropertyFlags local_properties{VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
+  const VkMemoryPropertyFlags lazy_properties{local_properties
+                                              | VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT};
+  for (const auto& candidate : candidates)
+    {
+      const Resource& resource{resources[candidate.resource]};
+      uint32_t lazy_type{};
+      if ((resource.usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+          && Source::Image::Find_MemoryType(device->pPD->physical_device,
+                                            candidate.requirements.memoryTypeBits,
+                                            lazy_properties,
+                                            lazy_type))
+        {
+          // nothing to gain from sharing memory that is never backed
+          blocks.push_back({VK_NULL_HANDLE,
+                            candidate.requirements.size,
+                            candidate.requirements.memoryTypeBits,
+                            {candidate.resource},
+                            true});
+          continue;
+        }
+
+      Block* target{};
+      for (auto& block : blocks)
+        {
+          if (block.lazy || !(block.type_bits & candidate.requirements.memoryTypeBits)
+              || block.size < candidate.requirements.size)
+            continue;
+          const bool disjoint{
+              std::all_of(block.occupants.begin(), block.occupants.end(), [&](GraphResource o) {
+                return resources[o].last < resource.first || resource.last < resources[o].first;
+              })};
+          if (disjoint)
+            {
+              target = &block;
+              break;
+            }
+        }
+      if (!target)
+        {
+          blocks.push_back({VK_NULL_HANDLE,
+                            candidate.requirements.size,
+                            candidate.requirements.memoryTypeBits,
+                            {}});
+          target = &blocks.back();
+        }
+      target->type_bits &= candidate.requirements.memoryTypeBits;
+      target->occupants.push_back(candidate.resource);
+    }
+
+  for (auto& block : blocks)
+    {
+      VkMemoryAllocateInfo alloc_info{};
+      alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+      alloc_info.allocationSize = block.size;
+      alloc_info.memoryTypeIndex = Source::Image::Find_MemoryType(
+          device->pPD->physical_device,
+          block.type_bits,
+          block.lazy ? lazy_properties : local_properties);
+      if (vkAllocateMemory(device->logical_device, &alloc_info, Alloc, &block.memory)
+          != VK_SUCCESS)
+        {
+          throw std::runtime_error("failed to allocate render graph memory!");
+        }
+      (block.lazy ? report.lazy : report.allocated) += block.size;
+
+      // the first occupant waits on the last one, which ran in the previous frame
+      std::sort(block.occupants.begin(),
+                block.occupants.end(),
+                [this](GraphResource a, GraphResource b) {
+                  return resources[a].first < resources[b].first;
+                });
+      for (size_t i = 0; i < block.occupants.size(); i++)
+        {
+          Resource& resource{resources[block.occupants[i]]};
+          if (block.occupants.size() > 1)
+            resource.alias_previous =
+                block.occupants[(i + block.occupants.size() - 1) % block.occupants.size()];
+
+          vkBindImageMemory(device->logical_device, resource.image, block.memory, 0);
+
+          VkImageViewCreateInfo view_info{Data::ImageViewCreate_Info{
+              resource.image,
+              resource.info.format,
+              Data::ImageSubresourceRange_Info{format_aspect(resource.info.format), 0, 1, 0, 1}}};
+          if (vkCreateImageView(device->logical_device, &view_info, Alloc, &resource.view)
+              != VK_SUCCESS)
+            {
+              throw std::runtime_error("failed to create render graph image view "
+                                       + resource.name);
+            }
+        }
+    }
+  report.blocks = static_cast<uint32_t>(blocks.size());
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::release()
+{
+  if (!device)
+    return;
+  for (auto& resource : resources)
+    {
+      if (resource.imported)
+        continue;
+      if (resource.view)
+        vkDestroyImageView(device->logical_device, resource.view, Alloc);
+      if (resource.image)
+        vkDestroyImage(device->logical_device, resource.image, Alloc);
+      resource.view = VK_NULL_HANDLE;
+      resource.image = VK_NULL_HANDLE;
+    }
+  for (auto& block : blocks)
+    vkFreeMemory(device->logical_device, block.memory, Alloc);
+  blocks.clear();
+  report = {};
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::transition(
+    Source::Buffer::EngineBarrierBatch& batch,
+    const Access& access)
+{
+  Resource& resource{resources[access.resource]};
+  State& state{resource.state};
+  const UsageState want{usage_state(access.usage)};
+
+  VkPipelineStageFlags src_stage{state.write_stage | state.read_stages};
+  VkAccessFlags src_access{state.write_access};
+  if (!state.touched && resource.alias_previous != GRAPH_NO_RESOURCE)
+    {
+      const State& previous{resources[resource.alias_previous].state};
+      src_stage |= previous.write_stage | previous.read_stages;
+      src_access |= previous.write_access;
+    }
+
+  // write-after-anything and layout changes always sync, reads only wait for a write they
+  // have not seen yet
+  const bool layout_change{state.layout != want.layout};
+  bool needed{};
+  if (access.write || layout_change)
+    needed = layout_change || src_stage != 0;
+  else
+    needed = state.write_stage != 0 && (state.visible_stages & want.stage) != want.stage;
+
+  if (needed)
+    {
+      if (!src_stage)
+        src_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+      VkImageMemoryBarrier barrier{};
+      barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      barrier.srcAccessMask = src_access;
+      barrier.dstAccessMask = want.access;
+      barrier.oldLayout = state.layout;
+      barrier.newLayout = want.layout;
+      barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.image = resource.image;
+      barrier.subresourceRange = {format_aspect(resource.info.format), 0, 1, 0, 1};
+      batch.image(barrier, src_stage, want.stage);
+    }
+
+  state.touched = true;
+  state.layout = want.layout;
+  if (access.write)
+    {
+      state.write_stage = want.stage;
+      state.write_access = want.write_access;
+      state.read_stages = 0;
+      state.visible_stages = want.stage;
+    }
+  else
+    {
+      state.read_stages |= want.stage;
+      if (needed)
+        state.visible_stages |= want.stage;
+    }
+}
+
+void SngoEngine::Core::Render::EngineRenderGraph::execute(VkCommandBuffer command_buffer)
+{
+  // transient contents are discarded, but the stages of the previous frame are kept so its
+  // work, earlier in submission order, finishes before the memory is reused
+  for (auto& resource : resources)
+    {
+      if (resource.imported)
+        {
+          resource.state = {};
+          resource.state.layout = resource.initial_layout;
+          resource.state.write_stage = resource.initial_stage;
+        }
+      else
+        {
+          resource.state.layout = VK_IMAGE_LAYOUT_UNDEFINED;
+          resource.state.touched = false;
+        }
+    }
+
+  Source::Buffer::EngineBarrierBatch batch{};
+  for (uint32_t p : order)
+    {
+      for (const auto& access : passes[p].accesses)
+        transition(batch, access);
+      batch.flush(command_buffer);
+      passes[p].execute(command_buffer);
+    }
+
+  for (auto& resource : resources)
+    {
+      if (!resource.imported || resource.final_layout == VK_IMAGE_LAYOUT_UNDEFINED
+          || resource.final_layout == resource.state.layout)
+        continue;
+
+      VkImageMemoryBarrier barrier{};
+      barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+      barrier.srcAccessMask = resource.state.write_access;
+      barrier.dstAccessMask = 0;
+      barrier.oldLayout = resource.state.layout;
+      barrier.newLayout = resource.final_layout;
+      barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+      barrier.image = resource.image;
+      barrier.subresourceRange = {format_aspect(resource.info.format), 0, 1, 0, 1};
+      VkPipelineStageFlags src_stage{resource.state.write_stage | resource.state.read_stages};
+      if (!src_stage)
+        src_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+      batch.image(barrier, src_stage, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT);
+    }
+  batch.flush(command_buffer);
+}
+
+VkImage SngoEngine::Core::Render::EngineRenderGraph::image(GraphResource resource) const
+{
+  return resources.at(resource).image;
+}
+
+VkImageView SngoEngine::Core::Render::EngineRenderGraph::view(GraphResource resource) const
+{
+  return resources.at(resource).view;
+}
+
+bool SngoEngine::Core::Render::EngineRenderGraph::is_culled(const std::string& pass) const
+{
+  for (const auto& entry : passes)
+    {
+      if (entry.name == pass)
+        return entry.culled;
+    }
+  return true;
+}
+
+VkAttachmentDescription SngoEngine::Core::Render::EngineRenderGraph::attachment_description(
+    GraphResource resource,
+    VkAttachmentLoadOp load_op) const
+{
+  const Resource& entry{resources.at(resource)};
+  const VkImageLayout layout{(format_aspect(entry.info.format) & VK_IMAGE_ASPECT_COLOR_BIT)
+                                 ? VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+                                 : VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL};
+  return RenderPass::Usage_Attachment(
+      entry.info.format, entry.info.samples, entry.info.usage, layout, load_op);
+}
+
+VkDeviceSize SngoEngine::Core::Render::EngineRenderGraph::committed() const
+{
+  VkDeviceSize bytes{};
+  for (const auto& block : blocks)
+    {
+      if (!block.lazy)
+        {
+          bytes += block.size;
+          continue;
+        }
+      VkDeviceSize block_committed{};
+      vkGetDeviceMemoryCommitment(device->logical_device, block.memory, &block_committed);
+      bytes += block_committed;
+    }
+  return bytes;
+}
@@ -0,0 +1,212 @@
+#ifndef __SNGO_RENDERGRAPH_H
+#define __SNGO_RENDERGRAPH_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "src/Core/Device/LogicalDevice.hpp"
+#include "src/Core/Source/Buffer/Barrier.hpp"
+
+namespace SngoEngine::Core::Render
+{
+
+//===========================================================================================================================
+// EngineRenderGraph
+//===========================================================================================================================
+
+using GraphResource = uint32_t;
+constexpr GraphResource GRAPH_NO_RESOURCE{UINT32_MAX};
+
+// how a pass touches an image, decides the layout, stages and access masks of its barriers
+enum class GraphUsage : uint8_t
+{
+  // also used for resolve targets
+  ColorAttachment,
+  DepthAttachment,
+  // read in the fragment shader
+  Sampled,
+  TransferSrc,
+  TransferDst,
+};
+
+struct GraphImage_Info
+{
+  VkFormat format{VK_FORMAT_UNDEFINED};
+  VkExtent2D extent{};
+  VkSampleCountFlagBits samples{VK_SAMPLE_COUNT_1_BIT};
+  // added to the usage implied by the declared accesses
+  VkImageUsageFlags usage{};
+};
+
+// A frame graph over images. Passes declare what they read and write, compile() culls passes
+// whose results are never consumed, orders the rest so writers run before readers, and backs
+// transient images with shared memory blocks when their lifetimes do not overlap. execute()
+// records the barriers each pass needs in front of it, the passes record everything else
+// (their render pass, framebuffer and draws) themselves.
+//
+// Transient images start every frame undefined, a pass writing one must clear or overwrite
+// it. Imported images (the swap chain) are handed in per frame with bind_import.
+//
+// Images declared with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT (multisampled targets that are
+// only resolved, depth that is only tested) may be used by a single pass as attachments. They
+// are never stored, and where the device has lazily allocated memory each gets a dedicated
+// block of it instead of joining the aliased ones, tile based GPUs then never back them at all.
+struct EngineRenderGraph
+{
+  using Execute = std::function<void(VkCommandBuffer)>;
+
+  struct PassBuilder
+  {
+    PassBuilder& read(GraphResource resource, GraphUsage usage);
+    PassBuilder& write(GraphResource resource, GraphUsage usage);
+    // keep the pass even if nothing reads what it writes
+    PassBuilder& side_effect();
+
+    EngineRenderGraph* graph{};
+    uint32_t pass{};
+  };
+
+  struct Report
+  {
+    // sum of the transient images' sizes, and what the aliased blocks actually take
+    VkDeviceSize requested{};
+    VkDeviceSize allocated{};
+    // bound to lazily allocated memory, of which only committed() is backed
+    VkDeviceSize lazy{};
+    uint32_t blocks{};
+    uint32_t culled{};
+  };
+
+  EngineRenderGraph() = default;
+  EngineRenderGraph(const EngineRenderGraph&) = delete;
+  EngineRenderGraph& operator=(const EngineRenderGraph&) = delete;
+  template <class... Args>
+  explicit EngineRenderGraph(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  template <class... Args>
+  void init(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  ~EngineRenderGraph()
+  {
+    destroyer();
+  }
+  void destroyer();
+
+  GraphResource create_image(const std::string& name, const GraphImage_Info& info);
+  // initial_stage is where the image becomes available, e.g. the stage the acquire semaphore
+  // is waited on; final_layout is the layout it is left in after the last pass
+  GraphResource import_image(const std::string& name,
+                             const GraphImage_Info& info,
+                             VkImageLayout initial_layout,
+                             VkImageLayout final_layout,
+                             VkPipelineStageFlags initial_stage
+                             = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT);
+  void bind_import(GraphResource resource, VkImage image, VkImageView view);
+  PassBuilder add_pass(const std::string& name, Execute execute);
+
+  // throws on cyclic dependencies, may be called again to rebuild the allocations
+  void compile();
+  void execute(VkCommandBuffer command_buffer);
+
+  [[nodiscard]] VkImage image(GraphResource resource) const;
+  [[nodiscard]] VkImageView view(GraphResource resource) const;
+  [[nodiscard]] bool is_culled(const std::string& pass) const;
+  // description of an attachment in the layout the graph hands it over in, load/store ops
+  // follow the declared usage
+  [[nodiscard]] VkAttachmentDescription attachment_description(
+      GraphResource resource,
+      VkAttachmentLoadOp load_op = VK_ATTACHMENT_LOAD_OP_CLEAR) const;
+  // bytes the device currently backs for the transient images, report.requested minus this
+  // is what aliasing and lazy allocation save
+  [[nodiscard]] VkDeviceSize committed() const;
+
+  Report report{};
+  const Device::LogicalDevice::EngineDevice* device{};
+
+ private:
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               const VkAllocationCallbacks* alloc = nullptr);
+
+  struct Access
+  {
+    GraphResource resource{};
+    GraphUsage usage{};
+    bool write{};
+  };
+
+  struct Pass
+  {
+    std::string name;
+    Execute execute;
+    std::vector<Access> accesses;
+    bool side_effect{};
+    bool culled{};
+  };
+
+  // synchronization state of an image while the frame is recorded
+  struct State
+  {
+    VkImageLayout layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    VkPipelineStageFlags write_stage{};
+    VkAccessFlags write_access{};
+    VkPipelineStageFlags read_stages{};
+    // stages the last write has been made visible to
+    VkPipelineStageFlags visible_stages{};
+    bool touched{};
+  };
+
+  struct Resource
+  {
+    std::string name;
+    GraphImage_Info info;
+    VkImageUsageFlags usage{};
+    bool imported{};
+    VkImageLayout initial_layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    VkImageLayout final_layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    VkPipelineStageFlags initial_stage{};
+
+    VkImage image{};
+    VkImageView view{};
+    // positions in the execution order
+    uint32_t first{UINT32_MAX};
+    uint32_t last{};
+    // the image using the same memory before this one, its work has to finish first
+    GraphResource alias_previous{GRAPH_NO_RESOURCE};
+    State state{};
+  };
+
+  struct Block
+  {
+    VkDeviceMemory memory{};
+    VkDeviceSize size{};
+    uint32_t type_bits{};
+    std::vector<GraphResource> occupants;
+    // lazily allocated, holds a single transient attachment
+    bool lazy{};
+  };
+
+  void add_access(uint32_t pass, GraphResource resource, GraphUsage usage, bool write);
+  void cull();
+  void sort();
+  void allocate();
+  void release();
+  void transition(Source::Buffer::EngineBarrierBatch& batch, const Access& access);
+
+  std::vector<Pass> passes;
+  std::vector<Resource> resources;
+  std::vector<uint32_t> order;
+  std::vector<Block> blocks;
+  const VkAllocationCallbacks* Alloc{};
+};
+
+}  // namespace SngoEngine::Core::Render
+
+#endif
@@ -97,6 +97,35 @@ SngoEngine::Core::Render::RenderPass::DEFAULT_ATTACHMENTDATA(VkFormat format,
           0};
 }
 
+SngoEngine::Core::Data::AttachmentDscription_Info
+SngoEngine::Core::Render::RenderPass::Usage_Attachment(VkFormat format,
+                                                       VkSampleCountFlagBits samples,
+                                                       VkImageUsageFlags usage,
+                                                       VkImageLayout layout,
+                                                       VkAttachmentLoadOp load_op)
+{
+  VkAttachmentStoreOp store_op{VK_ATTACHMENT_STORE_OP_STORE};
+  if (usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+    {
+      // the contents live and die inside the render pass, nothing to load or write back
+      store_op = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+      if (load_op == VK_ATTACHMENT_LOAD_OP_LOAD)
+        load_op = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    }
+
+  const bool has_stencil{format == VK_FORMAT_S8_UINT || format == VK_FORMAT_D16_UNORM_S8_UINT
+                         || format == VK_FORMAT_D24_UNORM_S8_UINT
+                         || format == VK_FORMAT_D32_SFLOAT_S8_UINT};
+  return {format,
+          samples,
+          load_op,
+          store_op,
+          has_stencil ? load_op : VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+          has_stencil ? store_op : VK_ATTACHMENT_STORE_OP_DONT_CARE,
+          layout,
+          layout};
+}
+
 VkViewport SngoEngine::Core::Render::RenderPass::Get_ViewPort(float width,
                                                               float height,
                                                               float minDepth,
@@ -17,6 +17,14 @@ std::vector<Data::SubpassDependency_Info> DEFAULT_SUBPASS_DEPENDENCY();
 SngoEngine::Core::Data::AttachmentData_Info DEFAULT_ATTACHMENTDATA(
     VkFormat format,
     VkPhysicalDevice physical_device);
+// load/store ops follow the declared image usage: a transient attachment is neither loaded
+// nor stored, stencil ops only apply to formats with a stencil aspect
+Data::AttachmentDscription_Info Usage_Attachment(
+    VkFormat format,
+    VkSampleCountFlagBits samples,
+    VkImageUsageFlags usage,
+    VkImageLayout layout,
+    VkAttachmentLoadOp load_op = VK_ATTACHMENT_LOAD_OP_CLEAR);
 
 VkViewport Get_ViewPort(float width, float height, float minDepth, float maxDepth);
 VkRect2D Get_Rect2D(uint32_t width, uint32_t height, int32_t offsetX, int32_t offsetY);
@@ -0,0 +1,100 @@
+#include "Timeline.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+//===========================================================================================================================
+// EngineFrameTimeline
+//===========================================================================================================================
+
+void SngoEngine::Core::Siganlis::EngineFrameTimeline::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    uint32_t _frames_in_flight,
+    const VkAllocationCallbacks* alloc)
+{
+  destroyer();
+  device = _device;
+  Alloc = alloc;
+  if (!device->timeline_semaphore)
+    {
+      throw std::runtime_error("failed to create frame timeline, timeline semaphores unsupported!");
+    }
+
+  VkSemaphoreTypeCreateInfo type_info{};
+  type_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+  type_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+  type_info.initialValue = 0;
+
+  VkSemaphoreCreateInfo semaphore_info{};
+  semaphore_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+  semaphore_info.pNext = &type_info;
+
+  if (vkCreateSemaphore(device->logical_device, &semaphore_info, Alloc, &semaphore) != VK_SUCCESS)
+    {
+      throw std::runtime_error("failed to create timeline semaphore!");
+    }
+  submitted = 0;
+  slot = 0;
+  set_frames_in_flight(_frames_in_flight);
+}
+
+void SngoEngine::Core::Siganlis::EngineFrameTimeline::destroyer()
+{
+  if (semaphore != VK_NULL_HANDLE)
+    vkDestroySemaphore(device->logical_device, semaphore, Alloc);
+  semaphore = VK_NULL_HANDLE;
+}
+
+uint32_t SngoEngine::Core::Siganlis::EngineFrameTimeline::begin_frame()
+{
+  const uint64_t value{signal_value()};
+  if (value > frames_in_flight)
+    wait(value - frames_in_flight);
+  slot = static_cast<uint32_t>(value % Macro::MAX_FRAMES_IN_FLIGHT);
+  return slot;
+}
+
+uint64_t SngoEngine::Core::Siganlis::EngineFrameTimeline::signal_value() const
+{
+  return submitted + 1;
+}
+
+void SngoEngine::Core::Siganlis::EngineFrameTimeline::end_frame()
+{
+  submitted++;
+}
+
+void SngoEngine::Core::Siganlis::EngineFrameTimeline::wait(uint64_t value, uint64_t timeout) const
+{
+  VkSemaphoreWaitInfo wait_info{};
+  wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+  wait_info.semaphoreCount = 1;
+  wait_info.pSemaphores = &semaphore;
+  wait_info.pValues = &value;
+  const VkResult result{vkWaitSemaphores(device->logical_device, &wait_info, timeout)};
+  if (result != VK_SUCCESS && result != VK_TIMEOUT)
+    {
+      throw std::runtime_error("failed to wait for frame timeline!");
+    }
+}
+
+void SngoEngine::Core::Siganlis::EngineFrameTimeline::wait_idle() const
+{
+  if (submitted > 0)
+    wait(submitted);
+}
+
+uint64_t SngoEngine::Core::Siganlis::EngineFrameTimeline::completed() const
+{
+  uint64_t value{};
+  vkGetSemaphoreCounterValue(device->logical_device, semaphore, &value);
+  return value;
+}
+
+void SngoEngine::Core::Siganlis::EngineFrameTimeline::set_frames_in_flight(
+    uint32_t _frames_in_flight)
+{
+  frames_in_flight = std::clamp<uint32_t>(_frames_in_flight, 1, Macro::MAX_FRAMES_IN_FLIGHT);
+}
@@ -0,0 +1,73 @@
+#ifndef __SNGO_TIMELINE_H
+#define __SNGO_TIMELINE_H
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+
+#include "src/Core/Device/LogicalDevice.hpp"
+#include "src/Core/Macro.h"
+
+namespace SngoEngine::Core::Siganlis
+{
+
+//===========================================================================================================================
+// EngineFrameTimeline
+//===========================================================================================================================
+
+// Paces the frames in flight with one timeline semaphore instead of a fence per frame. The n-th
+// submitted frame signals value n, so before frame n starts recording the CPU waits for value
+// n - frames_in_flight. Per-frame resources are rings of Macro::MAX_FRAMES_IN_FLIGHT slots
+// indexed by the frame's slot: a slot comes back after MAX_FRAMES_IN_FLIGHT frames, never sooner
+// than frames_in_flight, so frames_in_flight can change between any two frames.
+struct EngineFrameTimeline
+{
+  EngineFrameTimeline() = default;
+  EngineFrameTimeline(EngineFrameTimeline&&) noexcept = default;
+  EngineFrameTimeline& operator=(EngineFrameTimeline&&) noexcept = default;
+  template <typename... Args>
+  explicit EngineFrameTimeline(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  template <typename... Args>
+  void init(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  ~EngineFrameTimeline()
+  {
+    destroyer();
+  }
+  void destroyer();
+
+  // blocks until the frame that used the next slot has left the GPU, returns that slot
+  uint32_t begin_frame();
+  // the value the next submission has to signal, end_frame() once it is submitted; a frame that
+  // is dropped before submitting (out of date swap chain) simply never calls it
+  [[nodiscard]] uint64_t signal_value() const;
+  void end_frame();
+
+  void wait(uint64_t value, uint64_t timeout = UINT64_MAX) const;
+  // waits for every submitted frame, the low latency mode calls it right before sampling input
+  void wait_idle() const;
+  [[nodiscard]] uint64_t completed() const;
+  // clamped to [1, Macro::MAX_FRAMES_IN_FLIGHT]
+  void set_frames_in_flight(uint32_t _frames_in_flight);
+
+  VkSemaphore semaphore{};
+  uint32_t frames_in_flight{Macro::DEFAULT_FRAMES_IN_FLIGHT};
+  // frames submitted so far, also the last value signaled
+  uint64_t submitted{};
+  uint32_t slot{};
+  const Device::LogicalDevice::EngineDevice* device{};
+
+ private:
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               uint32_t _frames_in_flight = Macro::DEFAULT_FRAMES_IN_FLIGHT,
+               const VkAllocationCallbacks* alloc = nullptr);
+  const VkAllocationCallbacks* Alloc{};
+};
+
+}  // namespace SngoEngine::Core::Siganlis
+
+#endif
@@ -0,0 +1,199 @@
+#include "Barrier.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <stdexcept>
+
+void SngoEngine::Core::Source::Buffer::Get_LayoutAccessMasks(VkImageLayout old_layout,
+                                                             VkImageLayout new_layout,
+                                                             VkAccessFlags& src_access,
+                                                             VkAccessFlags& dst_access)
+{
+  src_access = 0;
+  dst_access = 0;
+
+  switch (old_layout)
+    {
+      case VK_IMAGE_LAYOUT_UNDEFINED:
+        // Image layout is undefined (or does not matter)
+        // Only valid as initial layout
+        // No flags required, listed only for completeness
+        src_access = 0;
+        break;
+
+      case VK_IMAGE_LAYOUT_PREINITIALIZED:
+        // Image is preinitialized
+        // Only valid as initial layout for linear images, preserves memory contents
+        // Make sure host writes have been finished
+        src_access = VK_ACCESS_HOST_WRITE_BIT;
+        break;
+
+      case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+        // Image is a color attachment
+        // Make sure any writes to the color buffer have been finished
+        src_access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        break;
+
+      case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+        // Image is a depth/stencil attachment
+        // Make sure any writes to the depth/stencil buffer have been finished
+        src_access = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        break;
+
+      case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+        // Image is a transfer source
+        // Make sure any reads from the image have been finished
+        src_access = VK_ACCESS_TRANSFER_READ_BIT;
+        break;
+
+      case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+        // Image is a transfer destination
+        // Make sure any writes to the image have been finished
+        src_access = VK_ACCESS_TRANSFER_WRITE_BIT;
+        break;
+
+      case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+        // Image is read by a shader
+        // Make sure any shader reads from the image have been finished
+        src_access = VK_ACCESS_SHADER_READ_BIT;
+        break;
+      default:
+        // Other source layouts aren't handled (yet)
+        throw std::invalid_argument("unsupported layout transition!");
+
+        break;
+    }
+
+  // Target layouts (new)
+  // Destination access mask controls the dependency for the new image layout
+  switch (new_layout)
+    {
+      case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+        // Image will be used as a transfer destination
+        // Make sure any writes to the image have been finished
+        dst_access = VK_ACCESS_TRANSFER_WRITE_BIT;
+        break;
+
+      case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+        // Image will be used as a transfer source
+        // Make sure any reads from the image have been finished
+        dst_access = VK_ACCESS_TRANSFER_READ_BIT;
+        break;
+
+      case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+        // Image will be used as a color attachment
+        // Make sure any writes to the color buffer have been finished
+        dst_access = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+        break;
+
+      case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+        // Image layout will be used as a depth/stencil attachment
+        // Make sure any writes to depth/stencil buffer have been finished
+        dst_access = dst_access | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        break;
+
+      case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+        // Image will be read in a shader (sampler, input attachment)
+        // Make sure any writes to the image have been finished
+        if (src_access == 0)
+          {
+            src_access = VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+          }
+        dst_access = VK_ACCESS_SHADER_READ_BIT;
+        break;
+      default:
+        // Other source layouts aren't handled (yet)
+        throw std::invalid_argument("unsupported layout transition!");
+
+        break;
+    }
+}
+
+//===========================================================================================================================
+// EngineBarrierBatch
+//===========================================================================================================================
+
+SngoEngine::Core::Source::Buffer::EngineBarrierBatch::Group&
+SngoEngine::Core::Source::Buffer::EngineBarrierBatch::group(VkPipelineStageFlags src_stage,
+                                                            VkPipelineStageFlags dst_stage)
+{
+  for (auto& entry : groups)
+    {
+      if (entry.src_stage == src_stage && entry.dst_stage == dst_stage)
+        return entry;
+    }
+  groups.push_back({src_stage, dst_stage, {}, {}});
+  return groups.back();
+}
+
+void SngoEngine::Core::Source::Buffer::EngineBarrierBatch::image(VkImage _image,
+                                                                 VkImageSubresourceRange _range,
+                                                                 VkImageLayout old_layout,
+                                                                 VkImageLayout new_layout,
+                                                                 VkPipelineStageFlags src_stage,
+                                                                 VkPipelineStageFlags dst_stage)
+{
+  VkImageMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+  barrier.oldLayout = old_layout;
+  barrier.newLayout = new_layout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = _image;
+  barrier.subresourceRange = _range;
+  Get_LayoutAccessMasks(old_layout, new_layout, barrier.srcAccessMask, barrier.dstAccessMask);
+
+  group(src_stage, dst_stage).images.push_back(barrier);
+}
+
+void SngoEngine::Core::Source::Buffer::EngineBarrierBatch::image(
+    const VkImageMemoryBarrier& _barrier,
+    VkPipelineStageFlags src_stage,
+    VkPipelineStageFlags dst_stage)
+{
+  group(src_stage, dst_stage).images.push_back(_barrier);
+}
+
+void SngoEngine::Core::Source::Buffer::EngineBarrierBatch::buffer(VkBuffer _buffer,
+                                                                  VkDeviceSize _offset,
+                                                                  VkDeviceSize _size,
+                                                                  VkAccessFlags src_access,
+                                                                  VkAccessFlags dst_access,
+                                                                  VkPipelineStageFlags src_stage,
+                                                                  VkPipelineStageFlags dst_stage)
+{
+  VkBufferMemoryBarrier barrier{};
+  barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+  barrier.srcAccessMask = src_access;
+  barrier.dstAccessMask = dst_access;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.buffer = _buffer;
+  barrier.offset = _offset;
+  barrier.size = _size;
+
+  group(src_stage, dst_stage).buffers.push_back(barrier);
+}
+
+void SngoEngine::Core::Source::Buffer::EngineBarrierBatch::flush(VkCommandBuffer command_buffer)
+{
+  for (const auto& entry : groups)
+    {
+      vkCmdPipelineBarrier(command_buffer,
+                           entry.src_stage,
+                           entry.dst_stage,
+                           0,
+                           0,
+                           nullptr,
+                           static_cast<uint32_t>(entry.buffers.size()),
+                           entry.buffers.data(),
+                           static_cast<uint32_t>(entry.images.size()),
+                           entry.images.data());
+    }
+  groups.clear();
+}
+
+bool SngoEngine::Core::Source::Buffer::EngineBarrierBatch::empty() const
+{
+  return groups.empty();
+}
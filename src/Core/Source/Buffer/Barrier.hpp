@@ -0,0 +1,62 @@
+#ifndef __SNGO_BARRIER_H
+#define __SNGO_BARRIER_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <vector>
+
+namespace SngoEngine::Core::Source::Buffer
+{
+
+// access masks of the layouts Transition_ImageLayout has always supported, throws on others
+void Get_LayoutAccessMasks(VkImageLayout old_layout,
+                           VkImageLayout new_layout,
+                           VkAccessFlags& src_access,
+                           VkAccessFlags& dst_access);
+
+//===========================================================================================================================
+// EngineBarrierBatch
+//===========================================================================================================================
+
+// Collects image and buffer barriers and records them with one vkCmdPipelineBarrier per
+// (source stage, destination stage) pair into a caller-supplied command buffer, instead of one
+// submitted and waited command buffer per transition. Barriers flushed together must not
+// depend on each other.
+struct EngineBarrierBatch
+{
+  // access masks derived from the layouts
+  void image(VkImage _image,
+             VkImageSubresourceRange _range,
+             VkImageLayout old_layout,
+             VkImageLayout new_layout,
+             VkPipelineStageFlags src_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+             VkPipelineStageFlags dst_stage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+  void image(const VkImageMemoryBarrier& _barrier,
+             VkPipelineStageFlags src_stage,
+             VkPipelineStageFlags dst_stage);
+  void buffer(VkBuffer _buffer,
+              VkDeviceSize _offset,
+              VkDeviceSize _size,
+              VkAccessFlags src_access,
+              VkAccessFlags dst_access,
+              VkPipelineStageFlags src_stage,
+              VkPipelineStageFlags dst_stage);
+  void flush(VkCommandBuffer command_buffer);
+  [[nodiscard]] bool empty() const;
+
+ private:
+  struct Group
+  {
+    VkPipelineStageFlags src_stage{};
+    VkPipelineStageFlags dst_stage{};
+    std::vector<VkImageMemoryBarrier> images;
+    std::vector<VkBufferMemoryBarrier> buffers;
+  };
+  Group& group(VkPipelineStageFlags src_stage, VkPipelineStageFlags dst_stage);
+
+  std::vector<Group> groups;
+};
+
+}  // namespace SngoEngine::Core::Source::Buffer
+
+#endif
@@ -2,6 +2,9 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <cstring>
+#include <stdexcept>
+
 #include "src/Core/Data.h"
 #include "src/Core/Device/LogicalDevice.hpp"
 #include "src/Core/Source/Buffer/CommandBuffer.hpp"
@@ -100,3 +103,36 @@ void SngoEngine::Core::Source::Buffer::EngineBuffer::destroyer()
       buffer_memory = VK_NULL_HANDLE;
     }
 }
+
+void SngoEngine::Core::Source::Buffer::Upload_DeviceLocal(
+    const Device::LogicalDevice::EngineDevice* device,
+    VkCommandPool pool,
+    VkQueue graphics_queue,
+    const void* data,
+    VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    EngineBuffer& dst,
+    const VkAllocationCallbacks* alloc)
+{
+  if (size == 0)
+    {
+      throw std::runtime_error("failed to upload empty buffer");
+    }
+
+  EngineBuffer staging_buffer(device,
+                              Data::BufferCreate_Info{size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT},
+                              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                                  | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                              alloc);
+
+  void* mapped;
+  vkMapMemory(device->logical_device, staging_buffer.buffer_memory, 0, size, 0, &mapped);
+  memcpy(mapped, data, static_cast<size_t>(size));
+  vkUnmapMemory(device->logical_device, staging_buffer.buffer_memory);
+
+  dst.init(device,
+           Data::BufferCreate_Info{size, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT},
+           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+           alloc);
+  copy_buffer(device, pool, graphics_queue, staging_buffer.buffer, dst.buffer, size);
+}
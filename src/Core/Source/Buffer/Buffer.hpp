@@ -59,5 +59,15 @@ struct EngineBuffer
   const VkAllocationCallbacks* Alloc{};
 };
 
+// (re)creates dst as a device-local buffer of the given usage and fills it through a staging copy
+void Upload_DeviceLocal(const Device::LogicalDevice::EngineDevice* device,
+                        VkCommandPool pool,
+                        VkQueue graphics_queue,
+                        const void* data,
+                        VkDeviceSize size,
+                        VkBufferUsageFlags usage,
+                        EngineBuffer& dst,
+                        const VkAllocationCallbacks* alloc = nullptr);
+
 }  // namespace SngoEngine::Core::Source::Buffer
 #endif
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
 #include <cassert>
 #include <cstdint>
 #include <iostream>
@@ -86,6 +87,69 @@ void SngoEngine::Core::Source::Descriptor::EngineDescriptorSetLayout::creator(
     {
       throw std::runtime_error("failed to create descriptor set layout!");
     }
+  count_poolSizes(_bingdings);
+  pool_flags = 0;
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorSetLayout::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    const std::vector<VkDescriptorSetLayoutBinding>& _bingdings,
+    const std::vector<VkDescriptorBindingFlags>& _binding_flags,
+    VkDescriptorSetLayoutCreateFlags _flags,
+    const VkAllocationCallbacks* alloc)
+{
+  if (layout != VK_NULL_HANDLE)
+    vkDestroyDescriptorSetLayout(device->logical_device, layout, Alloc);
+  device = _device;
+  Alloc = alloc;
+  binding_size = _bingdings.size();
+
+  if (_binding_flags.size() != _bingdings.size())
+    {
+      throw std::runtime_error("failed to create descriptor set layout, binding flags mismatch!");
+    }
+  VkDescriptorSetLayoutBindingFlagsCreateInfo flags_info{};
+  flags_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+  flags_info.bindingCount = _binding_flags.size();
+  flags_info.pBindingFlags = _binding_flags.data();
+
+  VkDescriptorSetLayoutCreateInfo layout_info{};
+  layout_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  layout_info.pNext = &flags_info;
+  layout_info.flags = _flags;
+  layout_info.bindingCount = _bingdings.size();
+  layout_info.pBindings = _bingdings.data();
+
+  if (vkCreateDescriptorSetLayout(device->logical_device, &layout_info, Alloc, &layout)
+      != VK_SUCCESS)
+    {
+      throw std::runtime_error("failed to create descriptor set layout!");
+    }
+  count_poolSizes(_bingdings);
+  pool_flags = (_flags & VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT)
+                   ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT
+                   : 0;
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorSetLayout::count_poolSizes(
+    const std::vector<VkDescriptorSetLayoutBinding>& _bingdings)
+{
+  pool_sizes.clear();
+  for (const auto& binding : _bingdings)
+    {
+      if (binding.descriptorCount == 0)
+        continue;
+      auto size{std::find_if(pool_sizes.begin(), pool_sizes.end(), [&](const auto& s) {
+        return s.type == binding.descriptorType;
+      })};
+      if (size == pool_sizes.end())
+        pool_sizes.push_back({binding.descriptorType, binding.descriptorCount});
+      else
+        size->descriptorCount += binding.descriptorCount;
+    }
+  std::sort(pool_sizes.begin(), pool_sizes.end(), [](const auto& a, const auto& b) {
+    return a.type < b.type;
+  });
 }
 
 void SngoEngine::Core::Source::Descriptor::EngineDescriptorSetLayout::destroyer()
@@ -122,6 +186,31 @@ void SngoEngine::Core::Source::Descriptor::EngineDescriptorPool::creator(
     }
 }
 
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorPool::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    uint32_t _maxSets,
+    const std::vector<VkDescriptorPoolSize>& pool_sizes,
+    VkDescriptorPoolCreateFlags _flags,
+    const VkAllocationCallbacks* alloc)
+{
+  destroyer();
+  Alloc = alloc;
+  device = _device;
+
+  VkDescriptorPoolCreateInfo pool_info{};
+  pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  pool_info.flags = _flags;
+  pool_info.poolSizeCount = pool_sizes.size();
+  pool_info.pPoolSizes = pool_sizes.data();
+  pool_info.maxSets = _maxSets;
+
+  if (vkCreateDescriptorPool(device->logical_device, &pool_info, Alloc, &descriptor_pool)
+      != VK_SUCCESS)
+    {
+      throw std::runtime_error("failed to create descriptor pool!");
+    }
+}
+
 void SngoEngine::Core::Source::Descriptor::EngineDescriptorPool::destroyer()
 {
   if (device)
@@ -152,6 +241,148 @@ void SngoEngine::Core::Source::Descriptor::EngineDescriptorPool::destroyer()
 //   creator(_device, _maxSets, pool_sizes, alloc);
 // }
 
+//===========================================================================================================================
+// EngineDescriptorAllocator
+//===========================================================================================================================
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorAllocator::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    uint32_t _first_sets_per_pool,
+    uint32_t _max_sets_per_pool,
+    const VkAllocationCallbacks* alloc)
+{
+  destroyer();
+  device = _device;
+  Alloc = alloc;
+  first_sets_per_pool = std::max(_first_sets_per_pool, 1u);
+  max_sets_per_pool = std::max(_max_sets_per_pool, first_sets_per_pool);
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorAllocator::destroyer()
+{
+  if (device)
+    {
+      for (auto& [key, chain] : chains)
+        for (VkDescriptorPool pool : chain.pools)
+          vkDestroyDescriptorPool(device->logical_device, pool, Alloc);
+    }
+  chains.clear();
+}
+
+VkDescriptorPool SngoEngine::Core::Source::Descriptor::EngineDescriptorAllocator::grow(
+    PoolChain& chain)
+{
+  std::vector<VkDescriptorPoolSize> pool_sizes{chain.set_sizes};
+  for (auto& size : pool_sizes)
+    size.descriptorCount *= chain.next_sets;
+
+  VkDescriptorPoolCreateInfo pool_info{};
+  pool_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  pool_info.flags = chain.flags;
+  pool_info.poolSizeCount = pool_sizes.size();
+  pool_info.pPoolSizes = pool_sizes.data();
+  pool_info.maxSets = chain.next_sets;
+
+  VkDescriptorPool pool{};
+  if (vkCreateDescriptorPool(device->logical_device, &pool_info, Alloc, &pool) != VK_SUCCESS)
+    {
+      throw std::runtime_error("failed to create descriptor pool!");
+    }
+  chain.pools.push_back(pool);
+  chain.next_sets = std::min(chain.next_sets * 2, max_sets_per_pool);
+  return pool;
+}
+
+VkDescriptorSet SngoEngine::Core::Source::Descriptor::EngineDescriptorAllocator::allocate(
+    const EngineDescriptorSetLayout& _layout)
+{
+  std::vector<uint32_t> key{_layout.pool_flags};
+  for (const auto& size : _layout.pool_sizes)
+    {
+      key.push_back(static_cast<uint32_t>(size.type));
+      key.push_back(size.descriptorCount);
+    }
+  auto [it, inserted] = chains.try_emplace(std::move(key));
+  PoolChain& chain{it->second};
+  if (inserted)
+    {
+      chain.set_sizes = _layout.pool_sizes;
+      chain.flags = _layout.pool_flags;
+      chain.next_sets = first_sets_per_pool;
+    }
+
+  VkDescriptorSetAllocateInfo alloc_info{};
+  alloc_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  alloc_info.descriptorSetCount = 1;
+  alloc_info.pSetLayouts = &_layout.layout;
+
+  VkDescriptorSet set{};
+  while (true)
+    {
+      const bool fresh{chain.current == chain.pools.size()};
+      alloc_info.descriptorPool = fresh ? grow(chain) : chain.pools[chain.current];
+      const VkResult result{vkAllocateDescriptorSets(device->logical_device, &alloc_info, &set)};
+      if (result == VK_SUCCESS)
+        return set;
+      // an empty pool that still fails can never fit this layout
+      if (fresh || (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL))
+        {
+          throw std::runtime_error("failed to allocate descriptor set!");
+        }
+      chain.current++;
+    }
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorAllocator::reset()
+{
+  for (auto& [key, chain] : chains)
+    {
+      for (VkDescriptorPool pool : chain.pools)
+        vkResetDescriptorPool(device->logical_device, pool, 0);
+      chain.current = 0;
+    }
+}
+
+size_t SngoEngine::Core::Source::Descriptor::EngineDescriptorAllocator::pool_count() const
+{
+  size_t count{0};
+  for (const auto& [key, chain] : chains)
+    count += chain.pools.size();
+  return count;
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineFrameDescriptorAllocator::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    uint32_t _first_sets_per_pool,
+    uint32_t _max_sets_per_pool,
+    const VkAllocationCallbacks* alloc)
+{
+  for (auto& frame : frames)
+    frame.init(_device, _first_sets_per_pool, _max_sets_per_pool, alloc);
+  current_frame = 0;
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineFrameDescriptorAllocator::destroyer()
+{
+  for (auto& frame : frames)
+    frame.destroyer();
+}
+
+SngoEngine::Core::Source::Descriptor::EngineDescriptorAllocator&
+SngoEngine::Core::Source::Descriptor::EngineFrameDescriptorAllocator::begin_frame(
+    uint32_t frame_index)
+{
+  current_frame = frame_index % Macro::MAX_FRAMES_IN_FLIGHT;
+  frames[current_frame].reset();
+  return frames[current_frame];
+}
+
+VkDescriptorSet SngoEngine::Core::Source::Descriptor::EngineFrameDescriptorAllocator::allocate(
+    const EngineDescriptorSetLayout& _layout)
+{
+  return frames[current_frame].allocate(_layout);
+}
+
 //===========================================================================================================================
 // EngineDescriptorSet
 //===========================================================================================================================
@@ -195,6 +426,15 @@ void SngoEngine::Core::Source::Descriptor::EngineDescriptorSet::creator(
     }
 }
 
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorSet::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    const EngineDescriptorSetLayout* _set_layout,
+    EngineDescriptorAllocator* _allocator)
+{
+  device = _device;
+  descriptor_set = _allocator->allocate(*_set_layout);
+}
+
 void SngoEngine::Core::Source::Descriptor::EngineDescriptorSet::creator(
     const Device::LogicalDevice::EngineDevice* _device,
     const EngineDescriptorSetLayout* _set_layout,
@@ -463,3 +703,113 @@ SngoEngine::Core::Source::Descriptor::EngineDescriptorSets::end()
 {
   return descriptor_sets.end();
 }
+
+//===========================================================================================================================
+// EngineDescriptorWriteBatch
+//===========================================================================================================================
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorWriteBatch::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    size_t _reserve)
+{
+  destroyer();
+  device = _device;
+  writes.reserve(_reserve);
+  info_offsets.reserve(_reserve);
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorWriteBatch::destroyer()
+{
+  writes.clear();
+  info_offsets.clear();
+  image_infos.clear();
+  buffer_infos.clear();
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorWriteBatch::write_image(
+    VkDescriptorSet _set,
+    uint32_t _binding,
+    VkDescriptorType _type,
+    const VkDescriptorImageInfo& _info,
+    uint32_t _array_element)
+{
+  VkWriteDescriptorSet write{};
+  write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  write.dstSet = _set;
+  write.dstBinding = _binding;
+  write.dstArrayElement = _array_element;
+  write.descriptorType = _type;
+  write.descriptorCount = 1;
+  writes.push_back(write);
+  info_offsets.push_back(image_infos.size());
+  image_infos.push_back(_info);
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorWriteBatch::write_images(
+    VkDescriptorSet _set,
+    uint32_t _binding,
+    VkDescriptorType _type,
+    const std::vector<VkDescriptorImageInfo>& _infos,
+    uint32_t _array_element)
+{
+  if (_infos.empty())
+    return;
+  VkWriteDescriptorSet write{};
+  write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  write.dstSet = _set;
+  write.dstBinding = _binding;
+  write.dstArrayElement = _array_element;
+  write.descriptorType = _type;
+  write.descriptorCount = static_cast<uint32_t>(_infos.size());
+  writes.push_back(write);
+  info_offsets.push_back(image_infos.size());
+  image_infos.insert(image_infos.end(), _infos.begin(), _infos.end());
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorWriteBatch::write_buffer(
+    VkDescriptorSet _set,
+    uint32_t _binding,
+    VkDescriptorType _type,
+    const VkDescriptorBufferInfo& _info,
+    uint32_t _array_element)
+{
+  VkWriteDescriptorSet write{};
+  write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+  write.dstSet = _set;
+  write.dstBinding = _binding;
+  write.dstArrayElement = _array_element;
+  write.descriptorType = _type;
+  write.descriptorCount = 1;
+  writes.push_back(write);
+  info_offsets.push_back(buffer_infos.size());
+  buffer_infos.push_back(_info);
+}
+
+void SngoEngine::Core::Source::Descriptor::EngineDescriptorWriteBatch::flush()
+{
+  if (writes.empty())
+    return;
+  // the info vectors may have reallocated while queueing, resolve the pointers now
+  for (size_t i = 0; i < writes.size(); i++)
+    {
+      switch (writes[i].descriptorType)
+        {
+          case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+          case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+          case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+          case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+            writes[i].pBufferInfo = &buffer_infos[info_offsets[i]];
+            break;
+          default:
+            writes[i].pImageInfo = &image_infos[info_offsets[i]];
+            break;
+        }
+    }
+  vkUpdateDescriptorSets(device->logical_device, writes.size(), writes.data(), 0, nullptr);
+  destroyer();
+}
+
+size_t SngoEngine::Core::Source::Descriptor::EngineDescriptorWriteBatch::size() const
+{
+  return writes.size();
+}
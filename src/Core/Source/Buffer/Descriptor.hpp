@@ -3,9 +3,12 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <array>
+#include <map>
 #include <vector>
 
 #include "src/Core/Device/LogicalDevice.hpp"
+#include "src/Core/Macro.h"
 #include "src/Core/Source/Buffer/UniformBuffer.hpp"
 #include "src/Core/Source/Image/ImageVIew.hpp"
 #include "src/Core/Source/Image/Sampler.hpp"
@@ -54,12 +57,23 @@ struct EngineDescriptorSetLayout
 
   VkDescriptorSetLayout layout{};
   size_t binding_size{};
+  // descriptors one set of this layout takes from a pool, per type; what
+  // EngineDescriptorAllocator groups its pools by
+  std::vector<VkDescriptorPoolSize> pool_sizes{};
+  VkDescriptorPoolCreateFlags pool_flags{};
   const Device::LogicalDevice::EngineDevice* device{};
 
  private:
   void creator(const Device::LogicalDevice::EngineDevice* _device,
                const std::vector<VkDescriptorSetLayoutBinding>& _bingdings,
                const VkAllocationCallbacks* alloc = nullptr);
+  // descriptor indexing: one VkDescriptorBindingFlags per binding, e.g. update-after-bind arrays
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               const std::vector<VkDescriptorSetLayoutBinding>& _bingdings,
+               const std::vector<VkDescriptorBindingFlags>& _binding_flags,
+               VkDescriptorSetLayoutCreateFlags _flags,
+               const VkAllocationCallbacks* alloc = nullptr);
+  void count_poolSizes(const std::vector<VkDescriptorSetLayoutBinding>& _bingdings);
   const VkAllocationCallbacks* Alloc{};
 };
 
@@ -96,10 +110,111 @@ struct EngineDescriptorPool
                uint32_t _maxSets,
                const std::vector<VkDescriptorPoolSize>& pool_sizes,
                const VkAllocationCallbacks* alloc = nullptr);
+  // _flags replace the default FREE_DESCRIPTOR_SET_BIT
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               uint32_t _maxSets,
+               const std::vector<VkDescriptorPoolSize>& pool_sizes,
+               VkDescriptorPoolCreateFlags _flags,
+               const VkAllocationCallbacks* alloc = nullptr);
 
   const VkAllocationCallbacks* Alloc{};
 };
 
+//===========================================================================================================================
+// EngineDescriptorAllocator
+//===========================================================================================================================
+
+// Hands out sets from pools grouped by layout signature (EngineDescriptorSetLayout::pool_sizes),
+// every pool holds a whole number of sets of its signature. A full pool
+// (VK_ERROR_OUT_OF_POOL_MEMORY) is retired for the next one, and new pools double in size up to
+// max_sets_per_pool. Sets are never freed one by one, reset() recycles all pools at once with
+// vkResetDescriptorPool, so sets allocated before it must no longer be in use.
+struct EngineDescriptorAllocator
+{
+  EngineDescriptorAllocator() = default;
+  EngineDescriptorAllocator(EngineDescriptorAllocator&&) noexcept = default;
+  EngineDescriptorAllocator& operator=(EngineDescriptorAllocator&&) noexcept = default;
+  template <class... Args>
+  explicit EngineDescriptorAllocator(const Device::LogicalDevice::EngineDevice* _device,
+                                     Args... args)
+  {
+    creator(_device, args...);
+  }
+  template <class... Args>
+  void init(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  ~EngineDescriptorAllocator()
+  {
+    destroyer();
+  }
+  void destroyer();
+
+  VkDescriptorSet allocate(const EngineDescriptorSetLayout& _layout);
+  void reset();
+  [[nodiscard]] size_t pool_count() const;
+
+  uint32_t first_sets_per_pool{};
+  uint32_t max_sets_per_pool{};
+  const Device::LogicalDevice::EngineDevice* device{};
+
+ private:
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               uint32_t _first_sets_per_pool = 16,
+               uint32_t _max_sets_per_pool = 1024,
+               const VkAllocationCallbacks* alloc = nullptr);
+
+  struct PoolChain
+  {
+    std::vector<VkDescriptorPoolSize> set_sizes;
+    VkDescriptorPoolCreateFlags flags{};
+    std::vector<VkDescriptorPool> pools;
+    // pools before current are full until the next reset
+    size_t current{};
+    uint32_t next_sets{};
+  };
+  VkDescriptorPool grow(PoolChain& chain);
+
+  // {pool_flags, type, count, type, count...} of a layout
+  std::map<std::vector<uint32_t>, PoolChain> chains;
+  const VkAllocationCallbacks* Alloc{};
+};
+
+// one EngineDescriptorAllocator per frame slot, begin_frame resets the frame's allocator once
+// the frame timeline has handed out its slot, so transient sets cost one pool reset per frame
+struct EngineFrameDescriptorAllocator
+{
+  EngineFrameDescriptorAllocator() = default;
+  EngineFrameDescriptorAllocator(EngineFrameDescriptorAllocator&&) noexcept = default;
+  EngineFrameDescriptorAllocator& operator=(EngineFrameDescriptorAllocator&&) noexcept = default;
+  template <class... Args>
+  explicit EngineFrameDescriptorAllocator(const Device::LogicalDevice::EngineDevice* _device,
+                                          Args... args)
+  {
+    creator(_device, args...);
+  }
+  template <class... Args>
+  void init(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  ~EngineFrameDescriptorAllocator() = default;
+  void destroyer();
+
+  EngineDescriptorAllocator& begin_frame(uint32_t frame_index);
+  VkDescriptorSet allocate(const EngineDescriptorSetLayout& _layout);
+
+  std::array<EngineDescriptorAllocator, Macro::MAX_FRAMES_IN_FLIGHT> frames{};
+  uint32_t current_frame{};
+
+ private:
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               uint32_t _first_sets_per_pool = 16,
+               uint32_t _max_sets_per_pool = 1024,
+               const VkAllocationCallbacks* alloc = nullptr);
+};
+
 //===========================================================================================================================
 // EngineDescriptorSet
 //===========================================================================================================================
@@ -146,6 +261,9 @@ struct EngineDescriptorSet
   void creator(const Device::LogicalDevice::EngineDevice* _device,
                VkDescriptorSetLayout _layout,
                VkDescriptorPool _pool);
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               const EngineDescriptorSetLayout* _set_layout,
+               EngineDescriptorAllocator* _allocator);
   void creator(const Device::LogicalDevice::EngineDevice* _device,
                const EngineDescriptorSetLayout* _set_layout,
                const EngineDescriptorPool* _pool,
@@ -245,6 +363,64 @@ struct EngineDescriptorSets
                VkCopyDescriptorSet* pDescriptorCopies = nullptr);
 };
 
+//===========================================================================================================================
+// EngineDescriptorWriteBatch
+//===========================================================================================================================
+
+// Collects descriptor writes of any number of sets and applies them with a single
+// vkUpdateDescriptorSets. Image and buffer infos are copied into the batch, so callers may pass
+// temporaries; their pointers are only resolved in flush.
+struct EngineDescriptorWriteBatch
+{
+  EngineDescriptorWriteBatch() = default;
+  EngineDescriptorWriteBatch(EngineDescriptorWriteBatch&&) noexcept = default;
+  EngineDescriptorWriteBatch& operator=(EngineDescriptorWriteBatch&&) noexcept = default;
+  template <class... Args>
+  explicit EngineDescriptorWriteBatch(const Device::LogicalDevice::EngineDevice* _device,
+                                      Args... args)
+  {
+    creator(_device, args...);
+  }
+  template <class... Args>
+  void init(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  ~EngineDescriptorWriteBatch() = default;
+  void destroyer();
+
+  void write_image(VkDescriptorSet _set,
+                   uint32_t _binding,
+                   VkDescriptorType _type,
+                   const VkDescriptorImageInfo& _info,
+                   uint32_t _array_element = 0);
+  // consecutive array elements starting at _array_element
+  void write_images(VkDescriptorSet _set,
+                    uint32_t _binding,
+                    VkDescriptorType _type,
+                    const std::vector<VkDescriptorImageInfo>& _infos,
+                    uint32_t _array_element = 0);
+  void write_buffer(VkDescriptorSet _set,
+                    uint32_t _binding,
+                    VkDescriptorType _type,
+                    const VkDescriptorBufferInfo& _info,
+                    uint32_t _array_element = 0);
+  // one vkUpdateDescriptorSets for everything queued, then empties the batch
+  void flush();
+  [[nodiscard]] size_t size() const;
+
+  const Device::LogicalDevice::EngineDevice* device{};
+
+ private:
+  void creator(const Device::LogicalDevice::EngineDevice* _device, size_t _reserve = 0);
+
+  std::vector<VkWriteDescriptorSet> writes;
+  // index of each write's first info in image_infos or buffer_infos
+  std::vector<size_t> info_offsets;
+  std::vector<VkDescriptorImageInfo> image_infos;
+  std::vector<VkDescriptorBufferInfo> buffer_infos;
+};
+
 }  // namespace SngoEngine::Core::Source::Descriptor
 
 #endif
\ No newline at end of file
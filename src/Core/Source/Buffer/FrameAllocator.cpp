@@ -0,0 +1,81 @@
+#include "FrameAllocator.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "src/Core/Data.h"
+
+void SngoEngine::Core::Source::Buffer::EngineFrameAllocator::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    VkDeviceSize _frame_size,
+    VkBufferUsageFlags _usage,
+    VkDeviceSize _tail,
+    const VkAllocationCallbacks* alloc)
+{
+  destroyer();
+  device = _device;
+  Alloc = alloc;
+
+  const VkPhysicalDeviceLimits& limits{device->pPD->properties.limits};
+  alignment = 1;
+  if (_usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+    alignment = std::max(alignment, limits.minUniformBufferOffsetAlignment);
+  if (_usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT)
+    alignment = std::max(alignment, limits.minStorageBufferOffsetAlignment);
+  // buffer to image copies start on a texel block, 16 bytes covers every format
+  if (_usage & VK_BUFFER_USAGE_TRANSFER_SRC_BIT)
+    alignment = std::max<VkDeviceSize>(alignment, 16);
+
+  tail = _tail;
+  frame_size = (std::max<VkDeviceSize>(_frame_size, 1) + tail + alignment - 1) / alignment
+               * alignment;
+  const VkDeviceSize total{frame_size * Macro::MAX_FRAMES_IN_FLIGHT};
+
+  buffer.init(device,
+              Data::BufferCreate_Info{total, _usage},
+              VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+              Alloc);
+  void* data{};
+  if (vkMapMemory(device->logical_device, buffer.buffer_memory, 0, total, 0, &data) != VK_SUCCESS)
+    {
+      throw std::runtime_error("failed to map frame allocator memory!");
+    }
+  mapped = static_cast<std::byte*>(data);
+  frame_begin = 0;
+  cursor = 0;
+  peak = 0;
+}
+
+void SngoEngine::Core::Source::Buffer::EngineFrameAllocator::destroyer()
+{
+  // freeing the memory unmaps it
+  buffer.destroyer();
+  mapped = nullptr;
+}
+
+void SngoEngine::Core::Source::Buffer::EngineFrameAllocator::begin_frame(uint32_t frame_index)
+{
+  frame_begin = frame_size * (frame_index % Macro::MAX_FRAMES_IN_FLIGHT);
+  cursor = frame_begin;
+}
+
+SngoEngine::Core::Source::Buffer::EngineFrameAllocator::Allocation
+SngoEngine::Core::Source::Buffer::EngineFrameAllocator::allocate(VkDeviceSize size)
+{
+  const VkDeviceSize offset{(cursor + alignment - 1) / alignment * alignment};
+  if (offset + size + tail > frame_begin + frame_size)
+    {
+      throw std::runtime_error("failed to allocate frame memory, the frame's slice is exhausted!");
+    }
+  cursor = offset + size;
+  peak = std::max(peak, cursor - frame_begin);
+  return {mapped + offset, static_cast<uint32_t>(offset)};
+}
+
+VkDescriptorBufferInfo SngoEngine::Core::Source::Buffer::EngineFrameAllocator::descriptor(
+    VkDeviceSize range) const
+{
+  return {buffer.buffer, 0, range};
+}
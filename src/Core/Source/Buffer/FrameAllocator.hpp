@@ -0,0 +1,91 @@
+#ifndef __SNGO_FRAME_ALLOCATOR_H
+#define __SNGO_FRAME_ALLOCATOR_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "src/Core/Device/LogicalDevice.hpp"
+#include "src/Core/Macro.h"
+#include "src/Core/Source/Buffer/Buffer.hpp"
+
+namespace SngoEngine::Core::Source::Buffer
+{
+
+//===========================================================================================================================
+// EngineFrameAllocator
+//===========================================================================================================================
+
+// One persistently mapped host-visible buffer split into MAX_FRAMES_IN_FLIGHT slices. Every
+// frame bumps a cursor through its own slice, allocations come back as dynamic offsets, so all
+// per-draw uniforms of a frame share one buffer and one dynamic descriptor. begin_frame resets
+// the slice; the caller guarantees the GPU is done with that frame (EngineFrameTimeline's
+// begin_frame handed out its slot).
+struct EngineFrameAllocator
+{
+  EngineFrameAllocator() = default;
+  EngineFrameAllocator(EngineFrameAllocator&&) noexcept = default;
+  EngineFrameAllocator& operator=(EngineFrameAllocator&&) noexcept = default;
+  template <class... Args>
+  explicit EngineFrameAllocator(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  template <class... Args>
+  void init(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  ~EngineFrameAllocator()
+  {
+    destroyer();
+  }
+  void destroyer();
+
+  struct Allocation
+  {
+    void* data{};
+    // dynamic offset from the start of the buffer
+    uint32_t offset{};
+  };
+
+  void begin_frame(uint32_t frame_index);
+  // throws when the frame's slice is exhausted
+  Allocation allocate(VkDeviceSize size);
+  template <typename T>
+  uint32_t push(const T& value, VkDeviceSize size = sizeof(T))
+  {
+    Allocation allocation{allocate(size)};
+    std::memcpy(allocation.data, &value, size);
+    return allocation.offset;
+  }
+  // binds the whole buffer with the given range, offsets are supplied at bind time
+  [[nodiscard]] VkDescriptorBufferInfo descriptor(VkDeviceSize range) const;
+
+  EngineBuffer buffer{};
+  std::byte* mapped{};
+  VkDeviceSize frame_size{};
+  VkDeviceSize alignment{};
+  // high-water mark of any frame, to size the ring
+  VkDeviceSize peak{};
+  const Device::LogicalDevice::EngineDevice* device{};
+
+ private:
+  // frame_size is rounded up to the alignment, tail is kept free after the last allocation so
+  // a descriptor range starting there still fits inside the slice
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               VkDeviceSize _frame_size,
+               VkBufferUsageFlags _usage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+               VkDeviceSize _tail = 0,
+               const VkAllocationCallbacks* alloc = nullptr);
+  VkDeviceSize frame_begin{};
+  VkDeviceSize cursor{};
+  VkDeviceSize tail{};
+  const VkAllocationCallbacks* Alloc{};
+};
+
+}  // namespace SngoEngine::Core::Source::Buffer
+
+#endif
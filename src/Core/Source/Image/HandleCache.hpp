@@ -0,0 +1,128 @@
+#ifndef __SNGO_HANDLE_CACHE_H
+#define __SNGO_HANDLE_CACHE_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <unordered_map>
+
+namespace SngoEngine::Core::Source::Image
+{
+
+//===========================================================================================================================
+// EngineHandleCache
+//===========================================================================================================================
+
+template <typename T>
+uint64_t Handle_Bits(T handle)
+{
+  if constexpr (std::is_pointer_v<T>)
+    return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(handle));
+  else
+    return static_cast<uint64_t>(handle);
+}
+
+inline uint64_t Float_Bits(float value)
+{
+  return std::bit_cast<uint32_t>(value);
+}
+
+// Immutable Vulkan objects shared by everything created from the same key (the full create info
+// plus device and allocator). The cache only keeps weak references, the object is destroyed with
+// its last Shared reference, so a cached handle never outlives its users nor its device.
+template <typename Handle, size_t KeyWords>
+struct EngineHandleCache
+{
+  using Key = std::array<uint64_t, KeyWords>;
+  using Destroy = void(VKAPI_PTR*)(VkDevice, Handle, const VkAllocationCallbacks*);
+
+  struct Shared
+  {
+    Shared(VkDevice _device, Handle _handle, const VkAllocationCallbacks* _alloc, Destroy _destroy)
+        : device(_device), handle(_handle), alloc(_alloc), destroy(_destroy)
+    {
+    }
+    Shared(const Shared&) = delete;
+    Shared& operator=(const Shared&) = delete;
+    ~Shared()
+    {
+      if (handle != VK_NULL_HANDLE)
+        destroy(device, handle, alloc);
+    }
+
+    VkDevice device{};
+    Handle handle{};
+    const VkAllocationCallbacks* alloc{};
+    Destroy destroy{};
+  };
+
+  // returns the live object for key or the one create() makes, create runs under the lock
+  template <typename Create>
+  std::shared_ptr<Shared> acquire(const Key& key,
+                                  VkDevice device,
+                                  const VkAllocationCallbacks* alloc,
+                                  Destroy destroy,
+                                  Create&& create)
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    auto& entry{entries[key]};
+    if (auto shared = entry.lock())
+      {
+        hits++;
+        return shared;
+      }
+    auto shared{std::make_shared<Shared>(device, create(), alloc, destroy)};
+    entry = shared;
+    created++;
+    // drop the keys of released objects once in a while
+    if (++misses_since_sweep >= 64)
+      {
+        misses_since_sweep = 0;
+        std::erase_if(entries, [](const auto& item) { return item.second.expired(); });
+      }
+    return shared;
+  }
+
+  [[nodiscard]] size_t live_count() const
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    size_t count{0};
+    for (const auto& [key, entry] : entries)
+      if (!entry.expired())
+        count++;
+    return count;
+  }
+
+  // requests served by an existing object / objects actually created
+  uint64_t hits{};
+  uint64_t created{};
+
+ private:
+  struct KeyHash
+  {
+    size_t operator()(const Key& key) const
+    {
+      uint64_t hash{0xcbf29ce484222325ull};
+      for (uint64_t word : key)
+        {
+          hash ^= word;
+          hash *= 0x100000001b3ull;
+        }
+      return static_cast<size_t>(hash);
+    }
+  };
+
+  mutable std::mutex lock;
+  std::unordered_map<Key, std::weak_ptr<Shared>, KeyHash> entries;
+  uint32_t misses_since_sweep{};
+};
+
+}  // namespace SngoEngine::Core::Source::Image
+
+#endif
@@ -15,6 +15,8 @@
 #include "fmt/core.h"
 #include "ktx.h"
 #include "ktxvulkan.h"
+#include "src/Core/Source/Buffer/Barrier.hpp"
+#include "src/Core/Source/Image/KtxTranscode.hpp"
 #include "src/Core/Source/Image/Sampler.hpp"
 #include "src/Core/Utils/Utils.hpp"
 
@@ -28,6 +30,19 @@
 uint32_t SngoEngine::Core::Source::Image::Find_MemoryType(const VkPhysicalDevice& physical_device,
                                                           uint32_t type_filter,
                                                           VkMemoryPropertyFlags properties)
+{
+  uint32_t type_index{};
+  if (!Find_MemoryType(physical_device, type_filter, properties, type_index))
+    {
+      throw std::runtime_error("failed to find suitable memory type!");
+    }
+  return type_index;
+}
+
+bool SngoEngine::Core::Source::Image::Find_MemoryType(const VkPhysicalDevice& physical_device,
+                                                      uint32_t type_filter,
+                                                      VkMemoryPropertyFlags properties,
+                                                      uint32_t& type_index)
 {
   VkPhysicalDeviceMemoryProperties mem_properties{};
   vkGetPhysicalDeviceMemoryProperties(physical_device, &mem_properties);
@@ -37,11 +52,11 @@ uint32_t SngoEngine::Core::Source::Image::Find_MemoryType(const VkPhysicalDevice
       if (type_filter & (1 << i)
           && (mem_properties.memoryTypes[i].propertyFlags & properties) == properties)
         {
-          return i;
+          type_index = i;
+          return true;
         }
     }
-
-  throw std::runtime_error("failed to find suitable memory type!");
+  return false;
 }
 
 VkFormat SngoEngine::Core::Source::Image::Find_Format(VkPhysicalDevice physical_device,
@@ -121,7 +136,15 @@ void SngoEngine::Core::Source::Image::Copy_Buffer2Image(
 {
   Core::Source::Buffer::EngineOnceCommandBuffer once_commandbuffer{
       device, _command_pool, device->graphics_queue};
+  Copy_Buffer2Image(once_commandbuffer.command_buffer, buffer, img, _extent);
+  once_commandbuffer.end_buffer();
+}
 
+void SngoEngine::Core::Source::Image::Copy_Buffer2Image(VkCommandBuffer command_buffer,
+                                                        VkBuffer buffer,
+                                                        VkImage img,
+                                                        VkExtent2D _extent)
+{
   VkBufferImageCopy region{};
   region.bufferOffset = 0;
   region.bufferRowLength = 0;
@@ -135,14 +158,8 @@ void SngoEngine::Core::Source::Image::Copy_Buffer2Image(
   region.imageOffset = {0, 0, 0};
   region.imageExtent = {_extent.width, _extent.height, 1};
 
-  vkCmdCopyBufferToImage(once_commandbuffer.command_buffer,
-                         buffer,
-                         img,
-                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                         1,
-                         &region);
-
-  once_commandbuffer.end_buffer();
+  vkCmdCopyBufferToImage(
+      command_buffer, buffer, img, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
 }
 
 void SngoEngine::Core::Source::Image::Copy_Buffer2Image(
@@ -155,15 +172,22 @@ void SngoEngine::Core::Source::Image::Copy_Buffer2Image(
 {
   Core::Source::Buffer::EngineOnceCommandBuffer once_commandbuffer{
       device, _command_pool, device->graphics_queue};
+  Copy_Buffer2Image(once_commandbuffer.command_buffer, buffer, img, regions);
+  once_commandbuffer.end_buffer();
+}
 
-  vkCmdCopyBufferToImage(once_commandbuffer.command_buffer,
+void SngoEngine::Core::Source::Image::Copy_Buffer2Image(
+    VkCommandBuffer command_buffer,
+    VkBuffer buffer,
+    VkImage img,
+    const std::vector<VkBufferImageCopy>& regions)
+{
+  vkCmdCopyBufferToImage(command_buffer,
                          buffer,
                          img,
                          VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
                          regions.size(),
                          regions.data());
-
-  once_commandbuffer.end_buffer();
 }
 
 void SngoEngine::Core::Source::Image::Transition_ImageLayout(
@@ -179,131 +203,31 @@ void SngoEngine::Core::Source::Image::Transition_ImageLayout(
   Core::Source::Buffer::EngineOnceCommandBuffer once_commandbuffer{
       device, _command_pool, device->graphics_queue};
 
-  VkImageMemoryBarrier barrier{};
-  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-  barrier.oldLayout = old_layout;
-  barrier.newLayout = new_layout;
-
-  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-
-  barrier.image = image;
-  barrier.subresourceRange = subresourceRange;
-
-  barrier.srcAccessMask = 0;
-  barrier.dstAccessMask = 0;
-
-  switch (old_layout)
-    {
-      case VK_IMAGE_LAYOUT_UNDEFINED:
-        // Image layout is undefined (or does not matter)
-        // Only valid as initial layout
-        // No flags required, listed only for completeness
-        barrier.srcAccessMask = 0;
-        break;
-
-      case VK_IMAGE_LAYOUT_PREINITIALIZED:
-        // Image is preinitialized
-        // Only valid as initial layout for linear images, preserves memory contents
-        // Make sure host writes have been finished
-        barrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
-        break;
-
-      case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
-        // Image is a color attachment
-        // Make sure any writes to the color buffer have been finished
-        barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-        break;
-
-      case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
-        // Image is a depth/stencil attachment
-        // Make sure any writes to the depth/stencil buffer have been finished
-        barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-        break;
-
-      case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
-        // Image is a transfer source
-        // Make sure any reads from the image have been finished
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-        break;
-
-      case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
-        // Image is a transfer destination
-        // Make sure any writes to the image have been finished
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        break;
-
-      case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
-        // Image is read by a shader
-        // Make sure any shader reads from the image have been finished
-        barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        break;
-      default:
-        // Other source layouts aren't handled (yet)
-        throw std::invalid_argument("unsupported layout transition!");
-
-        break;
-    }
-
-  // Target layouts (new)
-  // Destination access mask controls the dependency for the new image layout
-  switch (new_layout)
-    {
-      case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
-        // Image will be used as a transfer destination
-        // Make sure any writes to the image have been finished
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        break;
-
-      case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
-        // Image will be used as a transfer source
-        // Make sure any reads from the image have been finished
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-        break;
-
-      case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
-        // Image will be used as a color attachment
-        // Make sure any writes to the color buffer have been finished
-        barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-        break;
-
-      case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
-        // Image layout will be used as a depth/stencil attachment
-        // Make sure any writes to depth/stencil buffer have been finished
-        barrier.dstAccessMask =
-            barrier.dstAccessMask | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-        break;
-
-      case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
-        // Image will be read in a shader (sampler, input attachment)
-        // Make sure any writes to the image have been finished
-        if (barrier.srcAccessMask == 0)
-          {
-            barrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
-          }
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-        break;
-      default:
-        // Other source layouts aren't handled (yet)
-        throw std::invalid_argument("unsupported layout transition!");
-
-        break;
-    }
-
-  vkCmdPipelineBarrier(once_commandbuffer.command_buffer,
-                       sourceStage,
-                       destinationStage,
-                       0,
-                       0,
-                       nullptr,
-                       0,
-                       nullptr,
-                       1,
-                       &barrier);
+  Transition_ImageLayout(once_commandbuffer.command_buffer,
+                         image,
+                         subresourceRange,
+                         old_layout,
+                         new_layout,
+                         sourceStage,
+                         destinationStage);
 
   once_commandbuffer.end_buffer();
 }
 
+void SngoEngine::Core::Source::Image::Transition_ImageLayout(
+    VkCommandBuffer command_buffer,
+    VkImage image,
+    VkImageSubresourceRange subresourceRange,
+    VkImageLayout old_layout,
+    VkImageLayout new_layout,
+    VkPipelineStageFlags sourceStage,
+    VkPipelineStageFlags destinationStage)
+{
+  Buffer::EngineBarrierBatch barriers;
+  barriers.image(image, subresourceRange, old_layout, new_layout, sourceStage, destinationStage);
+  barriers.flush(command_buffer);
+}
+
 SngoEngine::Core::Data::BufferCreate_Info
 SngoEngine::Core::Source::Image::Generate_BufferMemoryAllocate_Info(
     const SngoEngine::Core::Device::LogicalDevice::EngineDevice* device,
@@ -348,8 +272,21 @@ void SngoEngine::Core::Source::Image::EngineImage::creator(
   VkMemoryAllocateInfo alloc_info{};
   alloc_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
   alloc_info.allocationSize = req.size;
-  alloc_info.memoryTypeIndex =
-      Find_MemoryType(_device->pPD->physical_device, req.memoryTypeBits, _properties);
+  // lazily allocated memory only exists on tile based GPUs, elsewhere the image falls back to
+  // the remaining properties
+  const auto& physical_device{_device->pPD->physical_device};
+  lazily_allocated =
+      (_properties & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)
+      && Find_MemoryType(
+          physical_device, req.memoryTypeBits, _properties, alloc_info.memoryTypeIndex);
+  if (!lazily_allocated)
+    {
+      alloc_info.memoryTypeIndex =
+          Find_MemoryType(physical_device,
+                          req.memoryTypeBits,
+                          _properties & ~VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT);
+    }
+  memory_size = req.size;
 
   if (vkAllocateMemory(device->logical_device, &alloc_info, Alloc, &image_memory) != VK_SUCCESS)
     {
@@ -359,6 +296,15 @@ void SngoEngine::Core::Source::Image::EngineImage::creator(
   vkBindImageMemory(device->logical_device, image, image_memory, 0);
 }
 
+VkDeviceSize SngoEngine::Core::Source::Image::EngineImage::committed() const
+{
+  if (!lazily_allocated)
+    return memory_size;
+  VkDeviceSize bytes{};
+  vkGetDeviceMemoryCommitment(device->logical_device, image_memory, &bytes);
+  return bytes;
+}
+
 void SngoEngine::Core::Source::Image::EngineImage::destroyer()
 {
   if (device)
@@ -373,8 +319,10 @@ void SngoEngine::Core::Source::Image::EngineImage::destroyer()
 // EngineTextureImage
 //===========================================================================================================================
 
-ktxResult SngoEngine::Core::Source::Image::loadKTXFile(const std::string& filename,
-                                                       ktxTexture** target)
+ktxResult SngoEngine::Core::Source::Image::loadKTXFile(
+    const std::string& filename,
+    ktxTexture** target,
+    const Device::LogicalDevice::EngineDevice* device)
 {
   ktxResult result = KTX_SUCCESS;
   if (!SngoEngine::Core::Utils::isFile_Exists(filename))
@@ -385,6 +333,15 @@ ktxResult SngoEngine::Core::Source::Image::loadKTXFile(const std::string& filena
     }
   result = ktxTexture_CreateFromNamedFile(
       filename.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, target);
+  if (result == KTX_SUCCESS && device)
+    {
+      result = Transcode_Ktx(*target, device);
+      if (result != KTX_SUCCESS)
+        {
+          ktxTexture_Destroy(*target);
+          *target = nullptr;
+        }
+    }
   return result;
 }
 
@@ -453,11 +410,14 @@ void SngoEngine::Core::Source::Image::EngineTextureImage::creator(
         }
       stbi_image_free(pixels);
     }
-  else if (ext_name == "ktx")
+  else if (ext_name == "ktx" || ext_name == "ktx2")
     {
       ktxTexture* ktxTexture;
-      ktxResult result = loadKTXFile(texture_file, &ktxTexture);
+      ktxResult result = loadKTXFile(texture_file, &ktxTexture, _device);
       assert(result == KTX_SUCCESS);
+      // KTX2 carries its format, transcoded ones only know theirs now
+      if (ktxTexture->classId == ktxTexture2_c)
+        _format = ktxTexture_GetVkFormat(ktxTexture);
 
       extent = {ktxTexture->baseWidth, ktxTexture->baseHeight};
       mip_levels = ktxTexture->numLevels;
@@ -556,6 +516,36 @@ void SngoEngine::Core::Source::Image::EngineTextureImage::creator(
   descriptor.imageLayout = dst_layout;
 }
 
+void SngoEngine::Core::Source::Image::EngineTextureImage::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    VkImage _image,
+    VkDeviceMemory _image_memory,
+    VkExtent2D _extent,
+    uint32_t _mip_levels,
+    VkFormat _format,
+    const VkAllocationCallbacks* alloc,
+    VkImageLayout dst_layout)
+{
+  destroyer();
+  Alloc = alloc;
+  device = _device;
+  extent = _extent;
+  mip_levels = _mip_levels;
+  image = _image;
+  image_memory = _image_memory;
+
+  Data::ImageViewCreate_Info _info{image, _format, Data::DEFAULT_COLOR_IMAGE_SUBRESOURCE_INFO};
+  _info.subresourceRange.levelCount = mip_levels;
+  view.init(device, _info, Alloc);
+
+  auto sampler_info{Get_Default_Sampler(device, static_cast<float>(mip_levels))};
+  sampler.init(device, sampler_info, Alloc);
+
+  descriptor.sampler = sampler.sampler;
+  descriptor.imageView = view.image_view;
+  descriptor.imageLayout = dst_layout;
+}
+
 // creator for jpg/png
 void SngoEngine::Core::Source::Image::EngineTextureImage::CreateWith_Staging(
     const Device::LogicalDevice::EngineDevice* _device,
@@ -593,23 +583,31 @@ void SngoEngine::Core::Source::Image::EngineTextureImage::CreateWith_Staging(
           mip_levels},
       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
 
-  Transition_ImageLayout(device,
-                         _pool,
-                         img.image,
-                         subresourceRange,
-                         VK_IMAGE_LAYOUT_UNDEFINED,
-                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-  if (regions.empty())
-    {
-      Copy_Buffer2Image(device, _pool, staging_buffer.buffer, img.image, extent);
-    }
-  else
-    {
-      Copy_Buffer2Image(device, _pool, staging_buffer.buffer, img.image, regions);
-    }
-
-  Transition_ImageLayout(
-      device, _pool, img.image, subresourceRange, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dst_layout);
+  // transitions and copy share one submission
+  {
+    Buffer::EngineOnceCommandBuffer once_commandbuffer{device, _pool, device->graphics_queue};
+    Transition_ImageLayout(once_commandbuffer.command_buffer,
+                           img.image,
+                           subresourceRange,
+                           VK_IMAGE_LAYOUT_UNDEFINED,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    if (regions.empty())
+      {
+        Copy_Buffer2Image(
+            once_commandbuffer.command_buffer, staging_buffer.buffer, img.image, extent);
+      }
+    else
+      {
+        Copy_Buffer2Image(
+            once_commandbuffer.command_buffer, staging_buffer.buffer, img.image, regions);
+      }
+    Transition_ImageLayout(once_commandbuffer.command_buffer,
+                           img.image,
+                           subresourceRange,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           dst_layout);
+    once_commandbuffer.end_buffer();
+  }
 
   image = img.image;
   image_memory = img.image_memory;
@@ -700,6 +698,8 @@ void SngoEngine::Core::Source::Image::EngineTextureImage::destroyer()
       vkDestroyImage(device->logical_device, image, Alloc);
       vkFreeMemory(device->logical_device, image_memory, Alloc);
     }
+  image = VK_NULL_HANDLE;
+  image_memory = VK_NULL_HANDLE;
 }
 
 void SngoEngine::Core::Source::Image::Get_EmptyTextureImg(
@@ -760,11 +760,14 @@ void SngoEngine::Core::Source::Image::EngineCubeTexture::creator(
 
       stbi_image_free(pixels);
     }
-  else if (ext_name == "ktx")
+  else if (ext_name == "ktx" || ext_name == "ktx2")
     {
       ktxTexture* ktxTexture;
-      ktxResult result = loadKTXFile(texture_file, &ktxTexture);
+      ktxResult result = loadKTXFile(texture_file, &ktxTexture, _device);
       assert(result == KTX_SUCCESS);
+      // KTX2 carries its format, transcoded ones only know theirs now
+      if (ktxTexture->classId == ktxTexture2_c)
+        _format = ktxTexture_GetVkFormat(ktxTexture);
 
       extent = {ktxTexture->baseWidth, ktxTexture->baseHeight};
       mip_levels = ktxTexture->numLevels;
@@ -861,24 +864,31 @@ void SngoEngine::Core::Source::Image::EngineCubeTexture::CreateCubeWith_Staging(
           VK_IMAGE_TYPE_2D},
       VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
 
-  Transition_ImageLayout(device,
-                         _pool,
-                         img.image,
-                         subresourceRange,
-                         VK_IMAGE_LAYOUT_UNDEFINED,
-                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-  if (regions.empty())
-    {
-      // Copy_Buffer2Image(device, _pool, staging_buffer.buffer, img.image, extent);
-      // TODO: add jpg-like support for cube texture
-    }
-  else
-    {
-      Copy_Buffer2Image(device, _pool, staging_buffer.buffer, img.image, regions);
-    }
-
-  Transition_ImageLayout(
-      device, _pool, img.image, subresourceRange, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, dst_layout);
+  // transitions and copy share one submission
+  {
+    Buffer::EngineOnceCommandBuffer once_commandbuffer{device, _pool, device->graphics_queue};
+    Transition_ImageLayout(once_commandbuffer.command_buffer,
+                           img.image,
+                           subresourceRange,
+                           VK_IMAGE_LAYOUT_UNDEFINED,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    if (regions.empty())
+      {
+        // Copy_Buffer2Image(device, _pool, staging_buffer.buffer, img.image, extent);
+        // TODO: add jpg-like support for cube texture
+      }
+    else
+      {
+        Copy_Buffer2Image(
+            once_commandbuffer.command_buffer, staging_buffer.buffer, img.image, regions);
+      }
+    Transition_ImageLayout(once_commandbuffer.command_buffer,
+                           img.image,
+                           subresourceRange,
+                           VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           dst_layout);
+    once_commandbuffer.end_buffer();
+  }
 
   image = img.image;
   image_memory = img.image_memory;
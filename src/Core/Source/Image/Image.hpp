@@ -20,6 +20,11 @@ namespace SngoEngine::Core::Source::Image
 uint32_t Find_MemoryType(const VkPhysicalDevice& physical_device,
                          uint32_t type_filter,
                          VkMemoryPropertyFlags properties);
+// false instead of throwing when no type matches, for optional properties like lazy allocation
+bool Find_MemoryType(const VkPhysicalDevice& physical_device,
+                     uint32_t type_filter,
+                     VkMemoryPropertyFlags properties,
+                     uint32_t& type_index);
 
 VkFormat Find_Format(VkPhysicalDevice physical_device,
                      const std::vector<VkFormat>& candidates,
@@ -46,7 +51,18 @@ void Copy_Buffer2Image(const Device::LogicalDevice::EngineDevice* device,
                        VkBuffer buffer,
                        VkImage img,
                        const std::vector<VkBufferImageCopy>& regions);
+// record into a command buffer the caller submits
+void Copy_Buffer2Image(VkCommandBuffer command_buffer,
+                       VkBuffer buffer,
+                       VkImage img,
+                       VkExtent2D _extent);
+void Copy_Buffer2Image(VkCommandBuffer command_buffer,
+                       VkBuffer buffer,
+                       VkImage img,
+                       const std::vector<VkBufferImageCopy>& regions);
 
+// submits and waits for its own command buffer, prefer the recording overload or
+// Buffer::EngineBarrierBatch when there is more than one transition
 void Transition_ImageLayout(
     const Device::LogicalDevice::EngineDevice* device,
     VkCommandPool _command_pool,
@@ -56,6 +72,14 @@ void Transition_ImageLayout(
     VkImageLayout new_layout,
     VkPipelineStageFlags sourceStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
     VkPipelineStageFlags destinationStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+void Transition_ImageLayout(
+    VkCommandBuffer command_buffer,
+    VkImage image,
+    VkImageSubresourceRange subresourceRange,
+    VkImageLayout old_layout,
+    VkImageLayout new_layout,
+    VkPipelineStageFlags sourceStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+    VkPipelineStageFlags destinationStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
 
 Data::BufferCreate_Info Generate_BufferMemoryAllocate_Info(
     const Device::LogicalDevice::EngineDevice* device,
@@ -108,10 +132,16 @@ struct EngineImage
     destroyer();
   }
   void destroyer();
+  // bytes the device actually backs, lazily allocated memory only grows when a tile spills
+  [[nodiscard]] VkDeviceSize committed() const;
 
   VkExtent3D extent{};
   VkImage image{};
   VkDeviceMemory image_memory{};
+  VkDeviceSize memory_size{};
+  // LAZILY_ALLOCATED was asked for and a matching memory type exists, without one the image
+  // falls back to the remaining properties
+  bool lazily_allocated{};
   const Device::LogicalDevice::EngineDevice* device{};
 
  private:
@@ -126,7 +156,11 @@ struct EngineImage
 // EngineTextureImage
 //===========================================================================================================================
 
-ktxResult loadKTXFile(const std::string& filename, ktxTexture** target);
+// KTX1 and KTX2 files; with a device, Basis supercompressed KTX2 is transcoded (Transcode_Ktx)
+// and ktxTexture_GetVkFormat names the format to create the image with
+ktxResult loadKTXFile(const std::string& filename,
+                      ktxTexture** target,
+                      const Device::LogicalDevice::EngineDevice* device = nullptr);
 
 struct EngineTextureImage
 {
@@ -148,6 +182,11 @@ struct EngineTextureImage
     destroyer();
   }
   void destroyer();
+  // false until an image is bound, streamed textures sample a placeholder until then
+  [[nodiscard]] bool is_resident() const
+  {
+    return image != VK_NULL_HANDLE;
+  }
 
   uint32_t mip_levels = 1;
   VkExtent2D extent{};
@@ -179,6 +218,16 @@ struct EngineTextureImage
                VkImageUsageFlags _usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT
                                           | VK_IMAGE_USAGE_SAMPLED_BIT,
                VkImageLayout dst_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+  // takes ownership of an image uploaded elsewhere (EngineTextureStreamer) that is already in
+  // dst_layout, only the view, sampler and descriptor are created here
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               VkImage _image,
+               VkDeviceMemory _image_memory,
+               VkExtent2D _extent,
+               uint32_t _mip_levels,
+               VkFormat _format = VK_FORMAT_R8G8B8A8_SRGB,
+               const VkAllocationCallbacks* alloc = nullptr,
+               VkImageLayout dst_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
   // branch creator
   void CreateWith_Staging(const Device::LogicalDevice::EngineDevice* _device,
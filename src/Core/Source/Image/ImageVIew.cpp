@@ -4,31 +4,71 @@
 #include <vulkan/vulkan_core.h>
 
 #include <cstddef>
+#include <memory>
 
 //===========================================================================================================================
 // EngineImageView
 //===========================================================================================================================
 
+SngoEngine::Core::Source::ImageView::ImageViewCache&
+SngoEngine::Core::Source::ImageView::ImageView_Cache()
+{
+  static ImageViewCache cache;
+  return cache;
+}
+
 void SngoEngine::Core::Source::ImageView::EngineImageView::creator(
     const Device::LogicalDevice::EngineDevice* _device,
     Data::ImageViewCreate_Info _info,
     const VkAllocationCallbacks* alloc)
 {
-  if (image_view != VK_NULL_HANDLE)
-    vkDestroyImageView(device->logical_device, image_view, Alloc);
+  destroyer();
   device = _device;
   Alloc = alloc;
 
-  if (vkCreateImageView(device->logical_device, &_info, Alloc, &image_view) != VK_SUCCESS)
+  auto create = [&]() {
+    VkImageView created{};
+    if (vkCreateImageView(device->logical_device, &_info, Alloc, &created) != VK_SUCCESS)
+      {
+        throw std::runtime_error("failed to create texture image view!");
+      }
+    return created;
+  };
+
+  // chained structs (e.g. usage or YCbCr conversion) are not part of the key
+  if (_info.pNext)
     {
-      throw std::runtime_error("failed to create texture image view!");
+      shared = std::make_shared<ImageViewCache::Shared>(
+          device->logical_device, create(), Alloc, vkDestroyImageView);
     }
+  else
+    {
+      const ImageViewCache::Key key{Image::Handle_Bits(device->logical_device),
+                                    Image::Handle_Bits(Alloc),
+                                    _info.flags,
+                                    Image::Handle_Bits(_info.image),
+                                    static_cast<uint64_t>(_info.viewType),
+                                    static_cast<uint64_t>(_info.format),
+                                    static_cast<uint64_t>(_info.components.r),
+                                    static_cast<uint64_t>(_info.components.g),
+                                    static_cast<uint64_t>(_info.components.b),
+                                    static_cast<uint64_t>(_info.components.a),
+                                    _info.subresourceRange.aspectMask,
+                                    _info.subresourceRange.baseMipLevel,
+                                    _info.subresourceRange.levelCount,
+                                    _info.subresourceRange.baseArrayLayer,
+                                    _info.subresourceRange.layerCount};
+      shared = ImageView_Cache().acquire(
+          key, device->logical_device, Alloc, vkDestroyImageView, create);
+    }
+  image_view = shared->handle;
 }
 
 void SngoEngine::Core::Source::ImageView::EngineImageView::destroyer()
 {
-  if (device)
-    vkDestroyImageView(device->logical_device, image_view, Alloc);
+  // the view itself goes with its last user
+  shared.reset();
+  image_view = VK_NULL_HANDLE;
 }
 
 //===========================================================================================================================
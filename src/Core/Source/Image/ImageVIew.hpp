@@ -4,12 +4,14 @@
 #include <vulkan/vulkan_core.h>
 
 #include <cstddef>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
 #include "fmt/core.h"
 #include "src/Core/Data.h"
 #include "src/Core/Device/LogicalDevice.hpp"
+#include "src/Core/Source/Image/HandleCache.hpp"
 
 namespace SngoEngine::Core::Source::ImageView
 {
@@ -18,6 +20,10 @@ namespace SngoEngine::Core::Source::ImageView
 // EngineImageView
 //===========================================================================================================================
 
+using ImageViewCache = Image::EngineHandleCache<VkImageView, 15>;
+// process wide, EngineImageView takes every view without a pNext chain from here
+ImageViewCache& ImageView_Cache();
+
 struct EngineImageView
 {
   EngineImageView() = default;
@@ -44,6 +50,8 @@ struct EngineImageView
   void destroyer();
 
   VkImageView image_view{};
+  // shared with every EngineImageView of an equal create info on the same image
+  std::shared_ptr<ImageViewCache::Shared> shared{};
   const Device::LogicalDevice::EngineDevice* device{};
 
  private:
@@ -0,0 +1,194 @@
+#include "KtxTranscode.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <initializer_list>
+
+#include "fmt/core.h"
+#include "ktxvulkan.h"
+#include "src/Core/Source/Image/TextureCompress.hpp"
+#include "src/Core/Utils/FileParse.hpp"
+#include "src/Core/Utils/JobSystem.hpp"
+
+namespace
+{
+std::atomic<uint32_t> transcoded_textures{};
+std::atomic<uint64_t> transcoded_texels{};
+std::atomic<uint64_t> transcoded_ns{};
+std::atomic<uint64_t> encoded_total{};
+std::atomic<uint64_t> transcoded_total{};
+
+struct TranscodeCandidate
+{
+  ktx_transcode_fmt_e transcode;
+  VkFormat format;
+};
+
+uint64_t Base_Texels(const ktxTexture* texture)
+{
+  return uint64_t{texture->baseWidth} * texture->baseHeight * std::max(texture->numLayers, 1u)
+         * texture->numFaces;
+}
+
+// what one transcode of the file produced, for Benchmark_KtxTranscode
+struct TranscodeProbe
+{
+  bool transcoded{};
+  uint64_t texels{};
+  uint64_t bytes{};
+  uint64_t rgba_bytes{};
+  uint32_t levels{};
+  VkFormat format{};
+};
+
+TranscodeProbe Transcode_File(const SngoEngine::Core::Device::LogicalDevice::EngineDevice* device,
+                              const SngoEngine::Core::Utils::MappedFile& file)
+{
+  TranscodeProbe probe;
+  ktxTexture* texture{};
+  if (ktxTexture_CreateFromMemory(reinterpret_cast<const ktx_uint8_t*>(file.data),
+                                  file.size,
+                                  KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
+                                  &texture)
+      != KTX_SUCCESS)
+    return probe;
+
+  probe.transcoded =
+      texture->classId == ktxTexture2_c
+      && ktxTexture2_NeedsTranscoding(reinterpret_cast<ktxTexture2*>(texture))
+      && SngoEngine::Core::Source::Image::Transcode_Ktx(texture, device) == KTX_SUCCESS;
+  probe.texels = Base_Texels(texture);
+  probe.bytes = ktxTexture_GetDataSize(texture);
+  probe.levels = texture->numLevels;
+  probe.format = ktxTexture_GetVkFormat(texture);
+  for (uint32_t level = 0; level < texture->numLevels; level++)
+    {
+      probe.rgba_bytes += uint64_t{std::max(1u, texture->baseWidth >> level)}
+                          * std::max(1u, texture->baseHeight >> level) * 4
+                          * std::max(texture->numLayers, 1u) * texture->numFaces;
+    }
+  ktxTexture_Destroy(texture);
+  return probe;
+}
+}  // namespace
+
+//===========================================================================================================================
+// KtxTranscode
+//===========================================================================================================================
+
+ktx_transcode_fmt_e SngoEngine::Core::Source::Image::Pick_TranscodeFormat(
+    const Device::LogicalDevice::EngineDevice* device,
+    uint32_t components,
+    TextureRole role)
+{
+  if (!device)
+    return KTX_TTF_RGBA32;
+
+  // no role samples two channels only, the model shaders read normals as xyz
+  const VkPhysicalDevice physical_device{device->pPD->physical_device};
+  const bool alpha{role == TextureRole::Color && (components == 2 || components == 4)};
+  for (const TranscodeCandidate& candidate :
+       {TranscodeCandidate{KTX_TTF_BC7_RGBA, VK_FORMAT_BC7_UNORM_BLOCK},
+        TranscodeCandidate{KTX_TTF_ASTC_4x4_RGBA, VK_FORMAT_ASTC_4x4_UNORM_BLOCK},
+        alpha ? TranscodeCandidate{KTX_TTF_ETC2_RGBA, VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK}
+              : TranscodeCandidate{KTX_TTF_ETC1_RGB, VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK},
+        alpha ? TranscodeCandidate{KTX_TTF_BC3_RGBA, VK_FORMAT_BC3_UNORM_BLOCK}
+              : TranscodeCandidate{KTX_TTF_BC1_RGB, VK_FORMAT_BC1_RGB_UNORM_BLOCK}})
+    {
+      if (Format_SampledLinear(physical_device, candidate.format))
+        return candidate.transcode;
+    }
+  return KTX_TTF_RGBA32;
+}
+
+ktxResult SngoEngine::Core::Source::Image::Transcode_Ktx(
+    ktxTexture* texture,
+    const Device::LogicalDevice::EngineDevice* device,
+    TextureRole role)
+{
+  if (texture->classId != ktxTexture2_c)
+    return KTX_SUCCESS;
+  auto* texture2{reinterpret_cast<ktxTexture2*>(texture)};
+  if (!ktxTexture2_NeedsTranscoding(texture2))
+    return KTX_SUCCESS;
+
+  const auto start{std::chrono::steady_clock::now()};
+  const ktx_size_t encoded{ktxTexture_GetDataSize(texture)};
+  const ktxResult result{ktxTexture2_TranscodeBasis(
+      texture2, Pick_TranscodeFormat(device, ktxTexture2_GetNumComponents(texture2), role), 0)};
+  if (result != KTX_SUCCESS)
+    return result;
+
+  transcoded_textures++;
+  transcoded_texels += Base_Texels(texture);
+  encoded_total += encoded;
+  transcoded_total += ktxTexture_GetDataSize(texture);
+  transcoded_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                             std::chrono::steady_clock::now() - start)
+                                             .count());
+  return KTX_SUCCESS;
+}
+
+SngoEngine::Core::Source::Image::KtxTranscodeStats
+SngoEngine::Core::Source::Image::Ktx_TranscodeStats()
+{
+  return {transcoded_textures.load(),
+          static_cast<double>(transcoded_texels.load()) * 1e-6,
+          static_cast<double>(transcoded_ns.load()) * 1e-6,
+          encoded_total.load(),
+          transcoded_total.load()};
+}
+
+void SngoEngine::Core::Source::Image::Benchmark_KtxTranscode(
+    const Device::LogicalDevice::EngineDevice* device,
+    const std::string& filename,
+    uint32_t iterations)
+{
+  using Clock = std::chrono::steady_clock;
+  iterations = std::max(iterations, 1u);
+
+  const Utils::MappedFile file{filename};
+  const TranscodeProbe probe{file.size ? Transcode_File(device, file) : TranscodeProbe{}};
+  if (!probe.transcoded)
+    {
+      fmt::println("Benchmark_KtxTranscode: {} is no Basis supercompressed KTX2 file", filename);
+      return;
+    }
+
+  std::atomic<uint32_t> failed{};
+  auto t0{Clock::now()};
+  for (uint32_t i = 0; i < iterations; i++)
+    failed += Transcode_File(device, file).transcoded ? 0 : 1;
+  auto t1{Clock::now()};
+  auto& jobs{Utils::Job_System()};
+  jobs.parallel_for(iterations, 1, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++)
+      failed += Transcode_File(device, file).transcoded ? 0 : 1;
+  });
+  auto t2{Clock::now()};
+
+  const double megatexels{static_cast<double>(probe.texels) * iterations * 1e-6};
+  const double mb{static_cast<double>(file.size) * iterations / (1024.0 * 1024.0)};
+  const double s_serial{std::chrono::duration<double>(t1 - t0).count()};
+  const double s_parallel{std::chrono::duration<double>(t2 - t1).count()};
+
+  fmt::println("Benchmark_KtxTranscode: {} ({} bytes, {} levels, {} iterations)",
+               filename,
+               file.size,
+               probe.levels,
+               iterations);
+  fmt::println("  VkFormat {}: {} bytes uploaded, RGBA8 would be {} bytes, the file is {:.1f}%",
+               static_cast<int>(probe.format),
+               probe.bytes,
+               probe.rgba_bytes,
+               100.0 * static_cast<double>(file.size) / static_cast<double>(probe.rgba_bytes));
+  fmt::println("  calling thread : {:8.2f} Mtexel/s, {:8.2f} MB/s of file",
+               megatexels / s_serial,
+               mb / s_serial);
+  fmt::println("  {:2} workers     : {:8.2f} Mtexel/s, {:8.2f} MB/s of file",
+               jobs.worker_count(),
+               megatexels / s_parallel,
+               mb / s_parallel);
+  fmt::println("  speedup {:.2f}x, {} transcodes failed", s_serial / s_parallel, failed.load());
+}
@@ -0,0 +1,55 @@
+#ifndef __SNGO_KTX_TRANSCODE_H
+#define __SNGO_KTX_TRANSCODE_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+
+#include "ktx.h"
+#include "src/Core/Device/LogicalDevice.hpp"
+#include "src/Core/Source/Image/TextureCompress.hpp"
+
+namespace SngoEngine::Core::Source::Image
+{
+
+//===========================================================================================================================
+// KtxTranscode
+//===========================================================================================================================
+
+// the first block format device samples with linear filtering: BC7, ASTC 4x4, ETC2, then BC3/BC1;
+// RGBA8 when none is. Every role keeps RGB (gray data is replicated), alpha only counts for
+// Color, like Compressed_Format
+ktx_transcode_fmt_e Pick_TranscodeFormat(const Device::LogicalDevice::EngineDevice* device,
+                                         uint32_t components,
+                                         TextureRole role);
+
+// transcodes KTX2 BasisLZ/UASTC textures in place to Pick_TranscodeFormat, ktxTexture_GetVkFormat
+// then names the format to upload; other textures are left as they are; runs on the calling
+// thread, any number of textures may transcode at once
+ktxResult Transcode_Ktx(ktxTexture* texture,
+                        const Device::LogicalDevice::EngineDevice* device,
+                        TextureRole role = TextureRole::Color);
+
+struct KtxTranscodeStats
+{
+  uint32_t textures{};
+  double megatexels{};
+  double ms{};
+  // supercompressed bytes read, block or RGBA8 bytes written
+  uint64_t encoded_bytes{};
+  uint64_t transcoded_bytes{};
+};
+
+// totals of every Transcode_Ktx call that transcoded, from any thread
+KtxTranscodeStats Ktx_TranscodeStats();
+
+// transcodes filename iterations times on the calling thread, then as many times spread over
+// Utils::Job_System(), and prints the throughput of both against the file and RGBA8 sizes
+void Benchmark_KtxTranscode(const Device::LogicalDevice::EngineDevice* device,
+                            const std::string& filename,
+                            uint32_t iterations = 16);
+
+}  // namespace SngoEngine::Core::Source::Image
+
+#endif
@@ -0,0 +1,265 @@
+#include "MipChain.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <numbers>
+#include <stdexcept>
+#include <utility>
+
+#include "src/Core/Utils/JobSystem.hpp"
+
+#define STB_IMAGE_RESIZE_IMPLEMENTATION
+#include "stb_image_resize2.h"
+
+namespace
+{
+constexpr uint32_t MIP_TEXEL{4};
+// output rows per resize split, smaller levels are not worth a job
+constexpr uint32_t MIP_SPLIT_ROWS{64};
+// NVTT's defaults: 3 texels either side, alpha 4
+constexpr float KAISER_WIDTH{3.0f};
+constexpr float KAISER_ALPHA{4.0f};
+
+std::atomic<uint32_t> built_chains{};
+std::atomic<uint64_t> built_texels{};
+std::atomic<uint64_t> built_ns{};
+
+// zeroth order modified Bessel function of the first kind, by its power series
+float Bessel_I0(float x)
+{
+  const float quarter_square{x * x * 0.25f};
+  float sum{1.0f};
+  float term{1.0f};
+  for (int k = 1; k < 32 && term > sum * 1e-7f; k++)
+    {
+      term *= quarter_square / static_cast<float>(k * k);
+      sum += term;
+    }
+  return sum;
+}
+
+// x in output texels, stb_image_resize2 stretches it over the input
+float Kaiser_Kernel(float x, float, void*)
+{
+  x = std::abs(x);
+  if (x >= KAISER_WIDTH)
+    return 0.0f;
+  const float pi_x{std::numbers::pi_v<float> * x};
+  const float sinc{x < 1e-5f ? 1.0f : std::sin(pi_x) / pi_x};
+  const float t{x / KAISER_WIDTH};
+  return sinc * Bessel_I0(KAISER_ALPHA * std::sqrt(1.0f - t * t)) / Bessel_I0(KAISER_ALPHA);
+}
+
+float Kaiser_Support(float, void*)
+{
+  return KAISER_WIDTH;
+}
+
+void Resize_Level(const unsigned char* source,
+                  uint32_t width,
+                  uint32_t height,
+                  unsigned char* target,
+                  uint32_t target_width,
+                  uint32_t target_height,
+                  const SngoEngine::Core::Source::Image::MipChainSettings& settings)
+{
+  using SngoEngine::Core::Source::Image::MipFilter;
+  using SngoEngine::Core::Source::Image::TextureRole;
+
+  // RGBA weights color by alpha, so cut out texels do not bleed into their neighbours
+  const bool color{settings.role == TextureRole::Color};
+  STBIR_RESIZE resize;
+  stbir_resize_init(&resize,
+                    source,
+                    static_cast<int>(width),
+                    static_cast<int>(height),
+                    0,
+                    target,
+                    static_cast<int>(target_width),
+                    static_cast<int>(target_height),
+                    0,
+                    color ? STBIR_RGBA : STBIR_4CHANNEL,
+                    color ? STBIR_TYPE_UINT8_SRGB : STBIR_TYPE_UINT8);
+  // the bundled v2.01 asserts building wrapping samplers, edges clamp
+  stbir_set_edgemodes(&resize, STBIR_EDGE_CLAMP, STBIR_EDGE_CLAMP);
+  if (settings.filter == MipFilter::Kaiser)
+    stbir_set_filter_callbacks(
+        &resize, Kaiser_Kernel, Kaiser_Support, Kaiser_Kernel, Kaiser_Support);
+  else
+    stbir_set_filters(&resize, STBIR_FILTER_MITCHELL, STBIR_FILTER_MITCHELL);
+
+  auto& jobs{SngoEngine::Core::Utils::Job_System()};
+  const int wanted{static_cast<int>(
+      std::clamp(target_height / MIP_SPLIT_ROWS, 1u, jobs.worker_count() + 1))};
+  const int splits{stbir_build_samplers_with_splits(&resize, wanted)};
+  if (splits == 0)
+    {
+      throw std::runtime_error("failed to build the mip samplers");
+    }
+
+  std::atomic<bool> resized{true};
+  jobs.parallel_for(static_cast<size_t>(splits), 1, [&](size_t begin, size_t end) {
+    if (!stbir_resize_extended_split(
+            &resize, static_cast<int>(begin), static_cast<int>(end - begin)))
+      resized = false;
+  });
+  stbir_free_samplers(&resize);
+  if (!resized)
+    {
+      throw std::runtime_error("failed to resize a mip level");
+    }
+}
+
+// filtering shortens averaged normals
+void Renormalize(unsigned char* pixels, size_t texels)
+{
+  for (size_t i = 0; i < texels; i++)
+    {
+      unsigned char* texel{pixels + i * MIP_TEXEL};
+      float n[3];
+      for (int c = 0; c < 3; c++)
+        n[c] = static_cast<float>(texel[c]) / 127.5f - 1.0f;
+      const float length{std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2])};
+      if (length < 1e-4f)
+        continue;
+      for (int c = 0; c < 3; c++)
+        texel[c] =
+            static_cast<unsigned char>(std::lround((n[c] / length * 0.5f + 0.5f) * 255.0f));
+    }
+}
+
+using AlphaHistogram = std::array<uint64_t, 256>;
+
+AlphaHistogram Alpha_Histogram(const unsigned char* pixels, size_t texels)
+{
+  AlphaHistogram histogram{};
+  for (size_t i = 0; i < texels; i++)
+    histogram[pixels[i * MIP_TEXEL + 3]]++;
+  return histogram;
+}
+
+uint8_t Scale_Alpha(uint32_t alpha, float scale)
+{
+  return static_cast<uint8_t>(std::min(255.0f, std::round(static_cast<float>(alpha) * scale)));
+}
+
+// share of texels whose alpha, scaled, passes the cutoff
+double Coverage(const AlphaHistogram& histogram, size_t texels, float cutoff, float scale)
+{
+  uint64_t passed{};
+  for (uint32_t alpha = 0; alpha < histogram.size(); alpha++)
+    {
+      if (static_cast<float>(Scale_Alpha(alpha, scale)) >= cutoff * 255.0f)
+        passed += histogram[alpha];
+    }
+  return static_cast<double>(passed) / static_cast<double>(texels);
+}
+
+// Castano's alpha test coverage: the scale matching the base level's coverage, coverage only
+// grows with the scale so a bisection finds it
+void Preserve_Coverage(unsigned char* pixels, size_t texels, float cutoff, double coverage)
+{
+  const AlphaHistogram histogram{Alpha_Histogram(pixels, texels)};
+  float low{0.0f};
+  float high{4.0f};
+  for (int i = 0; i < 16; i++)
+    {
+      const float middle{(low + high) * 0.5f};
+      if (Coverage(histogram, texels, cutoff, middle) < coverage)
+        low = middle;
+      else
+        high = middle;
+    }
+  const float scale{
+      std::abs(Coverage(histogram, texels, cutoff, low) - coverage)
+              < std::abs(Coverage(histogram, texels, cutoff, high) - coverage)
+          ? low
+          : high};
+
+  for (size_t i = 0; i < texels; i++)
+    pixels[i * MIP_TEXEL + 3] = Scale_Alpha(pixels[i * MIP_TEXEL + 3], scale);
+}
+}  // namespace
+
+//===========================================================================================================================
+// MipChain
+//===========================================================================================================================
+
+void SngoEngine::Core::Source::Image::Generate_MipChain(StreamedPixels& pixels,
+                                                        const MipChainSettings& settings)
+{
+  const auto start{std::chrono::steady_clock::now()};
+  const VkDeviceSize base_bytes{VkDeviceSize{pixels.width} * pixels.height * MIP_TEXEL};
+  if (pixels.width == 0 || pixels.height == 0 || pixels.data.size() < base_bytes)
+    {
+      throw std::runtime_error("decoded pixels are smaller than their extent");
+    }
+
+  // the whole chain is allocated up front, every level is resized from the one above in place
+  pixels.levels.assign(1, {0, base_bytes});
+  VkDeviceSize size{base_bytes};
+  for (uint32_t width = pixels.width, height = pixels.height; width > 1 || height > 1;)
+    {
+      width = std::max(1u, width / 2);
+      height = std::max(1u, height / 2);
+      pixels.levels.push_back({size, VkDeviceSize{width} * height * MIP_TEXEL});
+      size += pixels.levels.back().size;
+    }
+  pixels.data.resize(size);
+
+  auto extent = [&pixels](uint32_t level) {
+    return std::pair{std::max(1u, pixels.width >> level), std::max(1u, pixels.height >> level)};
+  };
+  const auto count{static_cast<uint32_t>(pixels.levels.size())};
+  for (uint32_t level = 1; level < count; level++)
+    {
+      const auto [width, height]{extent(level - 1)};
+      const auto [target_width, target_height]{extent(level)};
+      unsigned char* target{pixels.data.data() + pixels.levels[level].offset};
+      Resize_Level(pixels.data.data() + pixels.levels[level - 1].offset,
+                   width,
+                   height,
+                   target,
+                   target_width,
+                   target_height,
+                   settings);
+      if (settings.role == TextureRole::Normal)
+        Renormalize(target, size_t{target_width} * target_height);
+    }
+
+  // after the whole chain, so every level is filtered from the unscaled one above it
+  if (settings.alpha_cutoff > 0.0f && count > 1)
+    {
+      const size_t base_texels{size_t{pixels.width} * pixels.height};
+      const double coverage{Coverage(Alpha_Histogram(pixels.data.data(), base_texels),
+                                     base_texels,
+                                     settings.alpha_cutoff,
+                                     1.0f)};
+      Utils::Job_System().parallel_for(count - 1, 1, [&](size_t begin, size_t end) {
+        for (size_t level = begin + 1; level < end + 1; level++)
+          {
+            const auto [width, height]{extent(static_cast<uint32_t>(level))};
+            Preserve_Coverage(pixels.data.data() + pixels.levels[level].offset,
+                              size_t{width} * height,
+                              settings.alpha_cutoff,
+                              coverage);
+          }
+      });
+    }
+
+  built_chains++;
+  built_texels += VkDeviceSize{pixels.width} * pixels.height;
+  built_ns += static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                        std::chrono::steady_clock::now() - start)
+                                        .count());
+}
+
+SngoEngine::Core::Source::Image::MipChainStats SngoEngine::Core::Source::Image::Mip_ChainStats()
+{
+  return {built_chains.load(),
+          static_cast<double>(built_texels.load()) * 1e-6,
+          static_cast<double>(built_ns.load()) * 1e-6};
+}
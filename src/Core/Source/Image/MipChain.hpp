@@ -0,0 +1,51 @@
+#ifndef __SNGO_MIP_CHAIN_H
+#define __SNGO_MIP_CHAIN_H
+
+#include <cstdint>
+
+#include "src/Core/Source/Image/TextureCompress.hpp"
+#include "src/Core/Source/Image/TextureStreamer.hpp"
+
+namespace SngoEngine::Core::Source::Image
+{
+
+//===========================================================================================================================
+// MipChain
+//===========================================================================================================================
+
+enum class MipFilter : uint32_t
+{
+  // Kaiser windowed sinc over 3 texels, the sharpest without visible ringing
+  Kaiser,
+  // Mitchell-Netravali (B = C = 1/3), softer
+  Mitchell
+};
+
+struct MipChainSettings
+{
+  // Color is filtered in linear light with alpha weighting, Normal is renormalized every level
+  TextureRole role{TextureRole::Color};
+  MipFilter filter{MipFilter::Kaiser};
+  // masked materials: every level's alpha is scaled so the share of texels passing the cutoff
+  // matches the base level, 0 leaves alpha as filtered
+  float alpha_cutoff{};
+};
+
+// appends the mip chain of 8 bit RGBA pixels down to 1x1 with stb_image_resize2, edges clamp;
+// every level is split into row bands over Utils::Job_System()
+void Generate_MipChain(StreamedPixels& pixels, const MipChainSettings& settings = {});
+
+struct MipChainStats
+{
+  uint32_t chains{};
+  // base levels of the chains built
+  double megapixels{};
+  double ms{};
+};
+
+// totals of every Generate_MipChain call so far, from any thread
+MipChainStats Mip_ChainStats();
+
+}  // namespace SngoEngine::Core::Source::Image
+
+#endif
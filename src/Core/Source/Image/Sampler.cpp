@@ -2,6 +2,9 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <memory>
+#include <stdexcept>
+
 VkBool32 SngoEngine::Core::Source::Image::FormatIs_Filterable(VkPhysicalDevice physicalDevice,
                                                               VkFormat format,
                                                               VkImageTiling tiling)
@@ -39,9 +42,6 @@ VkSamplerCreateInfo SngoEngine::Core::Source::Image::Get_Default_Sampler(
                                    ? device->pPD->properties.limits.maxSamplerAnisotropy
                                    : 1.0f;
 
-  VkPhysicalDeviceProperties properties{};
-  vkGetPhysicalDeviceProperties(device->pPD->physical_device, &properties);
-
   sampler_info.borderColor = VK_BORDER_COLOR_INT_OPAQUE_WHITE;
   sampler_info.unnormalizedCoordinates = VK_FALSE;
   sampler_info.compareEnable = VK_FALSE;
@@ -92,25 +92,65 @@ VkSamplerCreateInfo SngoEngine::Core::Source::Image::Get_CubeTex_Sampler(
 // EngineSampler
 //===========================================================================================================================
 
+SngoEngine::Core::Source::Image::SamplerCache& SngoEngine::Core::Source::Image::Sampler_Cache()
+{
+  static SamplerCache cache;
+  return cache;
+}
+
 void SngoEngine::Core::Source::Image::EngineSampler::creator(
     const Device::LogicalDevice::EngineDevice* _device,
-    VkSamplerCreateInfo& _sampler_info,
+    const VkSamplerCreateInfo& _sampler_info,
     const VkAllocationCallbacks* alloc)
 {
   destroyer();
   Alloc = alloc;
   device = _device;
 
-  VkSamplerCreateInfo sampler_info{_sampler_info};
-
-  if (vkCreateSampler(device->logical_device, &sampler_info, Alloc, &sampler) != VK_SUCCESS)
+  auto create = [&]() {
+    VkSampler created{};
+    if (vkCreateSampler(device->logical_device, &_sampler_info, Alloc, &created) != VK_SUCCESS)
+      {
+        throw std::runtime_error("failed to create texture sampler!");
+      }
+    return created;
+  };
+
+  // chained structs (e.g. YCbCr conversion) are not part of the key
+  if (_sampler_info.pNext)
+    {
+      shared = std::make_shared<SamplerCache::Shared>(
+          device->logical_device, create(), Alloc, vkDestroySampler);
+    }
+  else
     {
-      throw std::runtime_error("failed to create texture sampler!");
+      const SamplerCache::Key key{Handle_Bits(device->logical_device),
+                                  Handle_Bits(Alloc),
+                                  _sampler_info.flags,
+                                  static_cast<uint64_t>(_sampler_info.magFilter),
+                                  static_cast<uint64_t>(_sampler_info.minFilter),
+                                  static_cast<uint64_t>(_sampler_info.mipmapMode),
+                                  static_cast<uint64_t>(_sampler_info.addressModeU),
+                                  static_cast<uint64_t>(_sampler_info.addressModeV),
+                                  static_cast<uint64_t>(_sampler_info.addressModeW),
+                                  Float_Bits(_sampler_info.mipLodBias),
+                                  _sampler_info.anisotropyEnable,
+                                  Float_Bits(_sampler_info.maxAnisotropy),
+                                  _sampler_info.compareEnable,
+                                  static_cast<uint64_t>(_sampler_info.compareOp),
+                                  Float_Bits(_sampler_info.minLod),
+                                  Float_Bits(_sampler_info.maxLod),
+                                  static_cast<uint64_t>(_sampler_info.borderColor),
+                                  _sampler_info.unnormalizedCoordinates};
+      shared = Sampler_Cache().acquire(
+          key, device->logical_device, Alloc, vkDestroySampler, create);
     }
+  sampler = shared->handle;
 }
 
 void SngoEngine::Core::Source::Image::EngineSampler::destroyer()
 {
-  if (device)
-    vkDestroySampler(device->logical_device, sampler, Alloc);
+  // the sampler itself goes with its last user
+  shared.reset();
+  sampler = VK_NULL_HANDLE;
 }
@@ -3,7 +3,10 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <memory>
+
 #include "src/Core/Device/LogicalDevice.hpp"
+#include "src/Core/Source/Image/HandleCache.hpp"
 
 namespace SngoEngine::Core::Source::Image
 {
@@ -24,6 +27,10 @@ VkSamplerCreateInfo Get_Default_Sampler(
 VkSamplerCreateInfo Get_CubeTex_Sampler(const Device::LogicalDevice::EngineDevice* device,
                                         float mip_level);
 
+using SamplerCache = EngineHandleCache<VkSampler, 18>;
+// process wide, EngineSampler takes every sampler without a pNext chain from here
+SamplerCache& Sampler_Cache();
+
 struct EngineSampler
 {
   EngineSampler() = default;
@@ -51,11 +58,13 @@ struct EngineSampler
   void destroyer();
 
   VkSampler sampler{};
+  // shared with every EngineSampler of an equal create info
+  std::shared_ptr<SamplerCache::Shared> shared{};
   const Device::LogicalDevice::EngineDevice* device{};
 
  private:
   void creator(const Device::LogicalDevice::EngineDevice* _device,
-               VkSamplerCreateInfo& _sampler_info,
+               const VkSamplerCreateInfo& _sampler_info,
                const VkAllocationCallbacks* alloc = nullptr);
   const VkAllocationCallbacks* Alloc{};
 };
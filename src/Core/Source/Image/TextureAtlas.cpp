@@ -0,0 +1,125 @@
+#include "TextureAtlas.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "stb_rect_pack.h"
+
+namespace
+{
+constexpr uint32_t ATLAS_TEXEL{4};
+// rects start on block boundaries, pages can be block-compressed and mipped like any image
+constexpr uint32_t ATLAS_ALIGN{4};
+
+uint32_t Align(uint32_t extent)
+{
+  return (extent + ATLAS_ALIGN - 1) / ATLAS_ALIGN * ATLAS_ALIGN;
+}
+}  // namespace
+
+//===========================================================================================================================
+// TextureAtlas
+//===========================================================================================================================
+
+SngoEngine::Core::Source::Image::AtlasLayout SngoEngine::Core::Source::Image::Pack_Atlas(
+    const std::vector<VkExtent2D>& extents,
+    uint32_t page_size,
+    uint32_t padding)
+{
+  AtlasLayout layout;
+  layout.rects.resize(extents.size());
+
+  std::vector<stbrp_rect> pending;
+  for (size_t i = 0; i < extents.size(); i++)
+    {
+      const uint32_t width{Align(extents[i].width + padding * 2)};
+      const uint32_t height{Align(extents[i].height + padding * 2)};
+      if (extents[i].width == 0 || extents[i].height == 0 || width > page_size
+          || height > page_size)
+        continue;
+      stbrp_rect rect{};
+      rect.id = static_cast<int>(i);
+      rect.w = static_cast<stbrp_coord>(width);
+      rect.h = static_cast<stbrp_coord>(height);
+      pending.push_back(rect);
+    }
+
+  // every page takes what still fits, the rest goes on to a fresh one
+  std::vector<stbrp_node> nodes(page_size);
+  while (!pending.empty())
+    {
+      stbrp_context context;
+      stbrp_init_target(&context,
+                        static_cast<int>(page_size),
+                        static_cast<int>(page_size),
+                        nodes.data(),
+                        static_cast<int>(nodes.size()));
+      stbrp_pack_rects(&context, pending.data(), static_cast<int>(pending.size()));
+
+      const auto page{static_cast<uint32_t>(layout.pages.size())};
+      VkExtent2D extent{};
+      std::vector<stbrp_rect> rest;
+      for (const stbrp_rect& rect : pending)
+        {
+          if (!rect.was_packed)
+            {
+              rest.push_back(rect);
+              continue;
+            }
+          const VkExtent2D& source{extents[rect.id]};
+          layout.rects[rect.id] = {page,
+                                   static_cast<uint32_t>(rect.x) + padding,
+                                   static_cast<uint32_t>(rect.y) + padding,
+                                   source.width,
+                                   source.height};
+          extent.width = std::max(extent.width, static_cast<uint32_t>(rect.x + rect.w));
+          extent.height = std::max(extent.height, static_cast<uint32_t>(rect.y + rect.h));
+        }
+      if (rest.size() == pending.size())
+        {
+          throw std::runtime_error("failed to pack texture atlas, a rect fits no empty page");
+        }
+      layout.pages.push_back(extent);
+      pending = std::move(rest);
+    }
+  return layout;
+}
+
+void SngoEngine::Core::Source::Image::Blit_AtlasRect(std::vector<unsigned char>& page,
+                                                     VkExtent2D page_extent,
+                                                     const AtlasRect& rect,
+                                                     const unsigned char* pixels,
+                                                     uint32_t channels,
+                                                     uint32_t padding)
+{
+  if (channels != 3 && channels != 4)
+    {
+      throw std::runtime_error("failed to blit atlas rect, only RGB and RGBA are supported");
+    }
+  if (rect.x < padding || rect.y < padding || rect.x + rect.width + padding > page_extent.width
+      || rect.y + rect.height + padding > page_extent.height
+      || page.size() < size_t{page_extent.width} * page_extent.height * ATLAS_TEXEL)
+    {
+      throw std::runtime_error("failed to blit atlas rect, it is outside its page");
+    }
+
+  // padding rows and columns clamp to the nearest source texel
+  for (uint32_t y = 0; y < rect.height + padding * 2; y++)
+    {
+      const uint32_t sy{std::min(std::max(y, padding) - padding, rect.height - 1)};
+      unsigned char* target{page.data()
+                            + (size_t{rect.y - padding + y} * page_extent.width + rect.x - padding)
+                                  * ATLAS_TEXEL};
+      for (uint32_t x = 0; x < rect.width + padding * 2; x++, target += ATLAS_TEXEL)
+        {
+          const uint32_t sx{std::min(std::max(x, padding) - padding, rect.width - 1)};
+          const unsigned char* source{pixels + (size_t{sy} * rect.width + sx) * channels};
+          std::memcpy(target, source, channels);
+          if (channels == 3)
+            target[3] = 255;
+        }
+    }
+}
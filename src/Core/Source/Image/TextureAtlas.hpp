@@ -0,0 +1,57 @@
+#ifndef __SNGO_TEXTURE_ATLAS_H
+#define __SNGO_TEXTURE_ATLAS_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace SngoEngine::Core::Source::Image
+{
+
+//===========================================================================================================================
+// TextureAtlas
+//===========================================================================================================================
+
+// texels of an image inside its atlas page, the padding around it is not included
+struct AtlasRect
+{
+  uint32_t page{UINT32_MAX};
+  uint32_t x{};
+  uint32_t y{};
+  uint32_t width{};
+  uint32_t height{};
+
+  [[nodiscard]] bool is_packed() const
+  {
+    return page != UINT32_MAX;
+  }
+};
+
+struct AtlasLayout
+{
+  // one per image, in the order of the extents packed
+  std::vector<AtlasRect> rects;
+  // every page is cropped to the rects it holds, at most page_size on either side
+  std::vector<VkExtent2D> pages;
+};
+
+// packs the extents with stb_rect_pack into as few page_size pages as it finds room in, every
+// rect keeps padding texels free on each side and the padded rects start on 4 texel boundaries;
+// extents that do not fit an empty page stay unpacked
+AtlasLayout Pack_Atlas(const std::vector<VkExtent2D>& extents,
+                       uint32_t page_size,
+                       uint32_t padding);
+
+// copies 8 bit pixels of channels (3 or 4) components into rect of the RGBA page, the padding
+// repeats the edge texels so filtering and the first mips do not bleed in the neighbours
+void Blit_AtlasRect(std::vector<unsigned char>& page,
+                    VkExtent2D page_extent,
+                    const AtlasRect& rect,
+                    const unsigned char* pixels,
+                    uint32_t channels,
+                    uint32_t padding);
+
+}  // namespace SngoEngine::Core::Source::Image
+
+#endif
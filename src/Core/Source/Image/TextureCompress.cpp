@@ -0,0 +1,276 @@
+#include "TextureCompress.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <stdexcept>
+#include <system_error>
+#include <thread>
+
+#include "fmt/core.h"
+#include "src/Core/Utils/JobSystem.hpp"
+
+#define STB_DXT_IMPLEMENTATION
+#include "stb_dxt.h"
+
+namespace
+{
+constexpr uint32_t TEXTURE_CACHE_MAGIC{0x54474E53};  // "SNGT"
+constexpr uint32_t TEXTURE_CACHE_VERSION{3};
+// blocks compressed by one job
+constexpr size_t COMPRESS_GRAIN_BLOCKS{1024};
+
+struct TextureCacheHeader
+{
+  uint32_t magic{TEXTURE_CACHE_MAGIC};
+  uint32_t version{TEXTURE_CACHE_VERSION};
+  uint32_t format{};
+  uint32_t width{};
+  uint32_t height{};
+  uint32_t level_count{};
+  uint64_t data_bytes{};
+};
+
+template <typename T>
+void write_pod(std::ofstream& out, const T* data, size_t count)
+{
+  out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+}
+
+template <typename T>
+bool read_pod(std::ifstream& in, T* data, size_t count)
+{
+  in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+  return static_cast<bool>(in);
+}
+
+uint32_t Level_Extent(uint32_t extent, uint32_t level)
+{
+  return std::max(1u, extent >> level);
+}
+
+uint32_t Block_Count(uint32_t extent)
+{
+  return (extent + 3) / 4;
+}
+}  // namespace
+
+//===========================================================================================================================
+// TextureCompress
+//===========================================================================================================================
+
+VkFormat SngoEngine::Core::Source::Image::Compressed_Format(TextureRole role, bool opaque)
+{
+  switch (role)
+    {
+    case TextureRole::Color:
+      return opaque ? VK_FORMAT_BC1_RGB_SRGB_BLOCK : VK_FORMAT_BC3_SRGB_BLOCK;
+    case TextureRole::Linear:
+    case TextureRole::Normal:
+      return opaque ? VK_FORMAT_BC1_RGB_UNORM_BLOCK : VK_FORMAT_BC3_UNORM_BLOCK;
+    }
+  throw std::runtime_error("failed to pick a block format, unknown texture role");
+}
+
+bool SngoEngine::Core::Source::Image::Format_SampledLinear(VkPhysicalDevice physical_device,
+                                                           VkFormat format)
+{
+  constexpr VkFormatFeatureFlags features{VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT
+                                          | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT};
+  VkFormatProperties properties{};
+  vkGetPhysicalDeviceFormatProperties(physical_device, format, &properties);
+  return (properties.optimalTilingFeatures & features) == features;
+}
+
+bool SngoEngine::Core::Source::Image::Compression_Supported(
+    const Device::LogicalDevice::EngineDevice* device,
+    TextureRole role)
+{
+  const VkPhysicalDevice physical_device{device->pPD->physical_device};
+  return Format_SampledLinear(physical_device, Compressed_Format(role, true))
+         && Format_SampledLinear(physical_device, Compressed_Format(role, false));
+}
+
+void SngoEngine::Core::Source::Image::Compress_Pixels(StreamedPixels& pixels, TextureRole role)
+{
+  constexpr uint32_t texel{4};
+  if (pixels.format != VK_FORMAT_UNDEFINED && pixels.format != VK_FORMAT_R8G8B8A8_UNORM
+      && pixels.format != VK_FORMAT_R8G8B8A8_SRGB)
+    {
+      throw std::runtime_error("failed to compress texture, it is not 8 bit RGBA");
+    }
+  if (pixels.levels.empty())
+    pixels.levels.push_back({0, pixels.data.size()});
+  for (uint32_t i = 0; i < pixels.levels.size(); i++)
+    {
+      const StreamedLevel& level{pixels.levels[i]};
+      const VkDeviceSize bytes{VkDeviceSize{Level_Extent(pixels.width, i)}
+                               * Level_Extent(pixels.height, i) * texel};
+      if (level.size < bytes || level.offset + bytes > pixels.data.size())
+        {
+          throw std::runtime_error("decoded pixels are smaller than their extent");
+        }
+    }
+
+  // the mips average the base level, it decides alone
+  bool opaque{true};
+  const unsigned char* base{pixels.data.data() + pixels.levels[0].offset};
+  const VkDeviceSize base_bytes{VkDeviceSize{pixels.width} * pixels.height * texel};
+  for (VkDeviceSize i = 3; i < base_bytes && opaque; i += texel)
+    opaque = base[i] == 255;
+  const VkFormat format{Compressed_Format(role, opaque)};
+  const VkDeviceSize block_bytes{format == VK_FORMAT_BC1_RGB_SRGB_BLOCK
+                                         || format == VK_FORMAT_BC1_RGB_UNORM_BLOCK
+                                     ? 8u
+                                     : 16u};
+
+  // one entry per block row of every level
+  struct BlockRow
+  {
+    uint32_t level{};
+    uint32_t row{};
+  };
+  std::vector<StreamedLevel> levels;
+  std::vector<BlockRow> rows;
+  VkDeviceSize size{};
+  for (uint32_t i = 0; i < pixels.levels.size(); i++)
+    {
+      const uint32_t blocks_x{Block_Count(Level_Extent(pixels.width, i))};
+      const uint32_t blocks_y{Block_Count(Level_Extent(pixels.height, i))};
+      levels.push_back({size, VkDeviceSize{blocks_x} * blocks_y * block_bytes});
+      size += levels.back().size;
+      for (uint32_t row = 0; row < blocks_y; row++)
+        rows.push_back({i, row});
+    }
+
+  std::vector<unsigned char> data(size);
+  const size_t grain{std::max<size_t>(COMPRESS_GRAIN_BLOCKS / Block_Count(pixels.width), 1)};
+  Utils::Job_System().parallel_for(rows.size(), grain, [&](size_t begin, size_t end) {
+    unsigned char block[4 * 4 * texel];
+    for (size_t k = begin; k < end; k++)
+      {
+        const BlockRow& row{rows[k]};
+        const uint32_t width{Level_Extent(pixels.width, row.level)};
+        const uint32_t height{Level_Extent(pixels.height, row.level)};
+        const uint32_t blocks_x{Block_Count(width)};
+        const unsigned char* source{pixels.data.data() + pixels.levels[row.level].offset};
+        unsigned char* target{data.data() + levels[row.level].offset
+                              + VkDeviceSize{row.row} * blocks_x * block_bytes};
+
+        for (uint32_t bx = 0; bx < blocks_x; bx++, target += block_bytes)
+          {
+            for (uint32_t y = 0; y < 4; y++)
+              {
+                const uint32_t sy{std::min(row.row * 4 + y, height - 1)};
+                for (uint32_t x = 0; x < 4; x++)
+                  {
+                    const uint32_t sx{std::min(bx * 4 + x, width - 1)};
+                    std::memcpy(block + (y * 4 + x) * texel,
+                                source + (VkDeviceSize{sy} * width + sx) * texel,
+                                texel);
+                  }
+              }
+            stb_compress_dxt_block(target, block, opaque ? 0 : 1, STB_DXT_HIGHQUAL);
+          }
+      }
+  });
+
+  pixels.data = std::move(data);
+  pixels.levels = std::move(levels);
+  pixels.format = format;
+}
+
+uint64_t SngoEngine::Core::Source::Image::TextureCache_Key(
+    const std::vector<unsigned char>& encoded,
+    TextureRole role,
+    float alpha_cutoff)
+{
+  uint64_t key{0xcbf29ce484222325ull};
+  auto mix = [&key](uint64_t v) {
+    key ^= v;
+    key *= 0x100000001b3ull;
+  };
+
+  for (unsigned char byte : encoded)
+    mix(byte);
+  mix(static_cast<uint64_t>(role));
+  mix(std::bit_cast<uint32_t>(alpha_cutoff));
+  mix(encoded.size());
+  return key;
+}
+
+bool SngoEngine::Core::Source::Image::Read_TextureCache(const std::string& cache_file,
+                                                        StreamedPixels& pixels)
+{
+  std::ifstream in(cache_file, std::ios::binary);
+  if (!in.is_open())
+    return false;
+
+  TextureCacheHeader header{};
+  if (!read_pod(in, &header, 1) || header.magic != TEXTURE_CACHE_MAGIC
+      || header.version != TEXTURE_CACHE_VERSION || header.level_count == 0
+      || header.level_count > 32)
+    return false;
+
+  std::vector<StreamedLevel> levels(header.level_count);
+  for (StreamedLevel& level : levels)
+    {
+      uint64_t fields[2];
+      if (!read_pod(in, fields, 2) || fields[0] + fields[1] > header.data_bytes)
+        return false;
+      level = {fields[0], fields[1]};
+    }
+  std::vector<unsigned char> data(header.data_bytes);
+  if (!read_pod(in, data.data(), data.size()))
+    return false;
+
+  pixels.data = std::move(data);
+  pixels.width = header.width;
+  pixels.height = header.height;
+  pixels.levels = std::move(levels);
+  pixels.format = static_cast<VkFormat>(header.format);
+  return true;
+}
+
+void SngoEngine::Core::Source::Image::Write_TextureCache(const std::string& cache_file,
+                                                         const StreamedPixels& pixels)
+{
+  // decode jobs of identical images may write the same file at once
+  const std::string temp_file{fmt::format(
+      "{}.{}.tmp", cache_file, std::hash<std::thread::id>{}(std::this_thread::get_id()))};
+  {
+    std::ofstream out(temp_file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+      {
+        fmt::println("[warn] failed to write texture cache {}", cache_file);
+        return;
+      }
+
+    TextureCacheHeader header{};
+    header.format = static_cast<uint32_t>(pixels.format);
+    header.width = pixels.width;
+    header.height = pixels.height;
+    header.level_count = static_cast<uint32_t>(pixels.levels.size());
+    header.data_bytes = pixels.data.size();
+    write_pod(out, &header, 1);
+    for (const StreamedLevel& level : pixels.levels)
+      {
+        const uint64_t fields[2]{level.offset, level.size};
+        write_pod(out, fields, 2);
+      }
+    write_pod(out, pixels.data.data(), pixels.data.size());
+    if (!out)
+      {
+        fmt::println("[warn] failed to write texture cache {}", cache_file);
+        return;
+      }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temp_file, cache_file, ec);
+  if (ec)
+    fmt::println("[warn] failed to write texture cache {}: {}", cache_file, ec.message());
+}
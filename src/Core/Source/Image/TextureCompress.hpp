@@ -0,0 +1,58 @@
+#ifndef __SNGO_TEXTURE_COMPRESS_H
+#define __SNGO_TEXTURE_COMPRESS_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/Core/Source/Image/TextureStreamer.hpp"
+
+namespace SngoEngine::Core::Source::Image
+{
+
+//===========================================================================================================================
+// TextureCompress
+//===========================================================================================================================
+
+// what the material samples the texture as, decides its block format
+enum class TextureRole : uint32_t
+{
+  // base color and emissive, sRGB
+  Color,
+  // metallic roughness, occlusion
+  Linear,
+  // tangent space normals, kept as xyz so the model shaders sample them unchanged
+  Normal
+};
+
+// BC1 when every texel is opaque, BC3 otherwise
+VkFormat Compressed_Format(TextureRole role, bool opaque);
+
+// true when the physical device samples format from optimal tiling with linear filtering
+bool Format_SampledLinear(VkPhysicalDevice physical_device, VkFormat format);
+
+// true when device samples every format Compressed_Format may pick for role; without it the
+// pixels stay 8 bit RGBA
+bool Compression_Supported(const Device::LogicalDevice::EngineDevice* device, TextureRole role);
+
+// block-compresses the 8 bit RGBA chain of pixels (mips generated first, see Generate_MipChain)
+// with stb_dxt, block rows of all levels are spread over Utils::Job_System(); levels smaller than
+// a block repeat their edge texels
+void Compress_Pixels(StreamedPixels& pixels, TextureRole role);
+
+// FNV-1a of the encoded image, the role and the alpha cutoff its mips keep the coverage of, the
+// cache file name of its compressed chain
+uint64_t TextureCache_Key(const std::vector<unsigned char>& encoded,
+                          TextureRole role,
+                          float alpha_cutoff);
+
+// false if the file is missing, truncated or from another cache version
+bool Read_TextureCache(const std::string& cache_file, StreamedPixels& pixels);
+// written through a temporary file, failures only print a warning
+void Write_TextureCache(const std::string& cache_file, const StreamedPixels& pixels);
+
+}  // namespace SngoEngine::Core::Source::Image
+
+#endif
@@ -0,0 +1,676 @@
+#include "TextureStreamer.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include "fmt/core.h"
+#include "src/Core/Data.h"
+#include "src/Core/Macro.h"
+#include "src/Core/Source/Buffer/Barrier.hpp"
+
+namespace
+{
+constexpr VkDeviceSize STREAM_MIN_BUDGET{16384 * 4};
+// staging offsets of buffer to image copies are texel block aligned, see EngineFrameAllocator
+constexpr VkDeviceSize STREAM_ALIGNMENT{16};
+const VkImageSubresourceRange STREAM_ALL_LEVELS{
+    VK_IMAGE_ASPECT_COLOR_BIT, 0, VK_REMAINING_MIP_LEVELS, 0, 1};
+
+struct TexelBlock
+{
+  VkDeviceSize bytes{};
+  // width and height in texels
+  uint32_t extent{};
+};
+
+// formats whose rows are whole blocks of at least 4 bytes, so levels need no row padding
+bool Texel_Block(VkFormat format, TexelBlock& block)
+{
+  switch (format)
+    {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+    case VK_FORMAT_R8G8B8A8_SRGB:
+    case VK_FORMAT_B8G8R8A8_UNORM:
+    case VK_FORMAT_B8G8R8A8_SRGB:
+      block = {4, 1};
+      return true;
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+    case VK_FORMAT_BC4_UNORM_BLOCK:
+    case VK_FORMAT_BC4_SNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
+    case VK_FORMAT_EAC_R11_UNORM_BLOCK:
+      block = {8, 4};
+      return true;
+    case VK_FORMAT_BC2_UNORM_BLOCK:
+    case VK_FORMAT_BC2_SRGB_BLOCK:
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC3_SRGB_BLOCK:
+    case VK_FORMAT_BC5_UNORM_BLOCK:
+    case VK_FORMAT_BC5_SNORM_BLOCK:
+    case VK_FORMAT_BC6H_UFLOAT_BLOCK:
+    case VK_FORMAT_BC6H_SFLOAT_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+    case VK_FORMAT_BC7_SRGB_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
+    case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
+    case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_4x4_UNORM_BLOCK:
+    case VK_FORMAT_ASTC_4x4_SRGB_BLOCK:
+      block = {16, 4};
+      return true;
+    default:
+      return false;
+    }
+}
+
+uint32_t Level_Extent(uint32_t extent, uint32_t level)
+{
+  return std::max(1u, extent >> level);
+}
+
+uint32_t Block_Rows(const TexelBlock& block, uint32_t height)
+{
+  return (height + block.extent - 1) / block.extent;
+}
+
+VkDeviceSize Row_Bytes(const TexelBlock& block, uint32_t width)
+{
+  return VkDeviceSize{(width + block.extent - 1) / block.extent} * block.bytes;
+}
+
+VkDeviceSize Align_Staging(VkDeviceSize bytes)
+{
+  return (bytes + STREAM_ALIGNMENT - 1) / STREAM_ALIGNMENT * STREAM_ALIGNMENT;
+}
+
+// resolves the format, lists the single level of flat pixels and trims every level to its size
+void Check_Pixels(SngoEngine::Core::Source::Image::StreamedPixels& pixels, VkFormat fallback)
+{
+  if (pixels.format == VK_FORMAT_UNDEFINED)
+    pixels.format = fallback;
+  TexelBlock block;
+  if (!Texel_Block(pixels.format, block))
+    {
+      throw std::runtime_error("failed to stream texture, its format is not supported");
+    }
+  if (pixels.width == 0 || pixels.height == 0)
+    {
+      throw std::runtime_error("failed to stream texture, it is empty");
+    }
+  if (pixels.levels.empty())
+    pixels.levels.push_back({0, pixels.data.size()});
+  if (pixels.levels.size()
+      > static_cast<size_t>(std::bit_width(std::max(pixels.width, pixels.height))))
+    {
+      throw std::runtime_error("failed to stream texture, it has more levels than its extent");
+    }
+
+  for (uint32_t i = 0; i < pixels.levels.size(); i++)
+    {
+      const VkDeviceSize bytes{Row_Bytes(block, Level_Extent(pixels.width, i))
+                               * Block_Rows(block, Level_Extent(pixels.height, i))};
+      auto& level{pixels.levels[i]};
+      if (level.size < bytes || level.offset + bytes > pixels.data.size())
+        {
+          throw std::runtime_error("decoded pixels are smaller than their extent");
+        }
+      level.size = bytes;
+    }
+}
+}  // namespace
+
+//===========================================================================================================================
+// EngineTextureStreamer
+//===========================================================================================================================
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::creator(
+    const Device::LogicalDevice::EngineDevice* _device,
+    VkDeviceSize _budget,
+    VkDeviceSize _memory_budget,
+    const VkAllocationCallbacks* alloc)
+{
+  destroyer();
+  device = _device;
+  Alloc = alloc;
+  budget = std::max(_budget, STREAM_MIN_BUDGET);
+  memory_budget = _memory_budget;
+  staging.init(device, budget, VkBufferUsageFlags{VK_BUFFER_USAGE_TRANSFER_SRC_BIT}, 0, Alloc);
+
+  frame = 0;
+  requested = 0;
+  resident = 0;
+  failed = 0;
+  uploaded_bytes = 0;
+  decoded_bytes = 0;
+}
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::destroyer()
+{
+  try
+    {
+      Utils::Job_System().wait(jobs);
+    }
+  catch (const std::exception& e)
+    {
+      fmt::println("[warn] texture stream: {}", e.what());
+    }
+  jobs.clear();
+  decoded.clear();
+  uploads.clear();
+  release_retired(true);
+  textures.clear();
+  promotions = 0;
+  resident_bytes = 0;
+  requested_bytes = 0;
+  staging.destroyer();
+}
+
+uint32_t SngoEngine::Core::Source::Image::EngineTextureStreamer::request(
+    EngineTextureImage* target,
+    Decode decode,
+    Resident on_resident,
+    VkFormat format)
+{
+  auto texture{std::make_unique<Texture>()};
+  texture->target = target;
+  texture->format = format;
+  texture->decode = std::move(decode);
+  texture->on_resident = std::move(on_resident);
+  texture->building = true;
+  textures.push_back(std::move(texture));
+  requested++;
+
+  // the tail level is picked once the chain is known
+  auto build{std::make_shared<Build>()};
+  build->texture = static_cast<uint32_t>(textures.size() - 1);
+  start_decode(build->texture, build);
+  return build->texture;
+}
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::want(uint32_t texture,
+                                                                  float pixels_per_uv)
+{
+  Texture& wanted{*textures[texture]};
+  wanted.demand = std::max(wanted.demand, pixels_per_uv);
+}
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::start_decode(
+    uint32_t texture,
+    const std::shared_ptr<Build>& build)
+{
+  // only the render loop touches the texture, the job reads its decode and the format it was
+  // requested with, neither changes while a build is in flight
+  const Texture* source{textures[texture].get()};
+  jobs.push_back(Utils::Job_System().schedule([this, source, build]() {
+    try
+      {
+        build->pixels = source->decode();
+        Check_Pixels(build->pixels, source->format);
+        decoded_bytes += build->pixels.data.size();
+      }
+    catch (const std::exception& e)
+      {
+        fmt::println("[warn] texture stream: {}", e.what());
+        build->failed = true;
+      }
+
+    std::lock_guard<std::mutex> lock(decoded_mutex);
+    decoded.push_back(build);
+  }));
+}
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::receive(
+    const std::shared_ptr<Build>& build)
+{
+  Texture& texture{*textures[build->texture]};
+  const StreamedPixels& pixels{build->pixels};
+  const bool first{texture.level_bytes.empty()};
+  if (!build->failed && !first
+      && (pixels.width != texture.extent.width || pixels.height != texture.extent.height
+          || pixels.format != texture.format || pixels.levels.size() != texture.level_bytes.size()))
+    {
+      fmt::println("[warn] texture stream: a texture decoded differently than before");
+      build->failed = true;
+    }
+
+  if (build->failed)
+    {
+      // not retried, the texture keeps what it has
+      if (first)
+        failed++;
+      else
+        promotions--;
+      texture.failed = true;
+      texture.building = false;
+      texture.pending_level = texture.level;
+      return;
+    }
+
+  if (first)
+    {
+      texture.format = pixels.format;
+      texture.extent = {pixels.width, pixels.height};
+      for (const StreamedLevel& level : pixels.levels)
+        texture.level_bytes.push_back(level.size);
+      const auto count{static_cast<uint32_t>(texture.level_bytes.size())};
+      texture.level = count;
+      build->level = tail_level(texture);
+      build->upload_end = count;
+      texture.pending_level = build->level;
+      texture.wanted_level = build->level;
+    }
+  build->next_level = build->level;
+  build->next_row = 0;
+  uploads.push_back(build);
+}
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::update(VkCommandBuffer command_buffer,
+                                                                    uint32_t frame_index)
+{
+  frame++;
+  release_retired(false);
+  std::erase_if(jobs, [](const Utils::JobHandle& job) { return job->done.load(); });
+  std::vector<std::shared_ptr<Build>> arrived;
+  {
+    std::lock_guard<std::mutex> lock(decoded_mutex);
+    arrived.assign(decoded.begin(), decoded.end());
+    decoded.clear();
+  }
+  for (const auto& build : arrived)
+    receive(build);
+  plan();
+  if (uploads.empty())
+    return;
+
+  staging.begin_frame(frame_index);
+  Source::Buffer::EngineBarrierBatch to_transfer, to_shader;
+  std::vector<std::pair<VkImage, VkBufferImageCopy>> buffer_copies;
+  std::vector<std::tuple<VkImage, VkImage, VkImageCopy>> image_copies;
+  std::vector<std::shared_ptr<Build>> completed;
+
+  VkDeviceSize remaining{budget};
+  for (auto it = uploads.begin(); it != uploads.end();)
+    {
+      Build& build{**it};
+      const Texture& texture{*textures[build.texture]};
+      const auto count{static_cast<uint32_t>(texture.level_bytes.size())};
+      TexelBlock block;
+      Texel_Block(texture.format, block);
+
+      if (build.image.image == VK_NULL_HANDLE)
+        {
+          build.image.init(device,
+                           Data::ImageCreate_Info{texture.format,
+                                                  {Level_Extent(texture.extent.width, build.level),
+                                                   Level_Extent(texture.extent.height, build.level),
+                                                   1},
+                                                  VK_IMAGE_TILING_OPTIMAL,
+                                                  VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+                                                      | VK_IMAGE_USAGE_TRANSFER_DST_BIT
+                                                      | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                                  count - build.level},
+                           VkMemoryPropertyFlags{VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT},
+                           Alloc);
+          to_transfer.image(build.image.image,
+                            STREAM_ALL_LEVELS,
+                            VK_IMAGE_LAYOUT_UNDEFINED,
+                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                            VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT);
+        }
+
+      while (build.next_level < build.upload_end)
+        {
+          const uint32_t level{build.next_level};
+          const uint32_t width{Level_Extent(texture.extent.width, level)};
+          const uint32_t height{Level_Extent(texture.extent.height, level)};
+          const VkDeviceSize row_bytes{Row_Bytes(block, width)};
+          auto rows{static_cast<uint32_t>(std::min<VkDeviceSize>(
+              Block_Rows(block, height) - build.next_row, remaining / row_bytes))};
+          while (rows > 0 && Align_Staging(row_bytes * rows) > remaining)
+            rows--;
+          if (rows == 0)
+            break;
+
+          const VkDeviceSize bytes{row_bytes * rows};
+          const auto allocation{staging.allocate(bytes)};
+          std::memcpy(allocation.data,
+                      build.pixels.data.data() + build.pixels.levels[level].offset
+                          + row_bytes * build.next_row,
+                      bytes);
+
+          const uint32_t first_row{build.next_row * block.extent};
+          VkBufferImageCopy region{};
+          region.bufferOffset = allocation.offset;
+          region.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - build.level, 0, 1};
+          region.imageOffset = {0, static_cast<int32_t>(first_row), 0};
+          region.imageExtent = {width, std::min(rows * block.extent, height - first_row), 1};
+          buffer_copies.emplace_back(build.image.image, region);
+
+          build.next_row += rows;
+          remaining -= Align_Staging(bytes);
+          uploaded_bytes += bytes;
+          if (build.next_row == Block_Rows(block, height))
+            {
+              build.next_level++;
+              build.next_row = 0;
+            }
+        }
+      if (build.next_level < build.upload_end)
+        {
+          ++it;
+          continue;
+        }
+
+      // the levels both images hold are copied on the GPU, adopt retires the old image
+      if (texture.level < count)
+        {
+          to_transfer.image(texture.target->image,
+                            STREAM_ALL_LEVELS,
+                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                            VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                            VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                            VK_PIPELINE_STAGE_TRANSFER_BIT);
+          for (uint32_t level = build.upload_end; level < count; level++)
+            {
+              VkImageCopy region{};
+              region.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - texture.level, 0, 1};
+              region.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - build.level, 0, 1};
+              region.extent = {Level_Extent(texture.extent.width, level),
+                               Level_Extent(texture.extent.height, level),
+                               1};
+              image_copies.emplace_back(texture.target->image, build.image.image, region);
+            }
+        }
+      // levels uploaded by earlier submissions are covered as well
+      to_shader.image(build.image.image,
+                      STREAM_ALL_LEVELS,
+                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                      VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                      VK_PIPELINE_STAGE_TRANSFER_BIT,
+                      VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+      completed.push_back(std::move(*it));
+      it = uploads.erase(it);
+    }
+
+  to_transfer.flush(command_buffer);
+  for (const auto& [image, region] : buffer_copies)
+    {
+      vkCmdCopyBufferToImage(command_buffer,
+                             staging.buffer.buffer,
+                             image,
+                             VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                             1,
+                             &region);
+    }
+  for (const auto& [source, target, region] : image_copies)
+    {
+      vkCmdCopyImage(command_buffer,
+                     source,
+                     VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                     target,
+                     VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                     1,
+                     &region);
+    }
+  to_shader.flush(command_buffer);
+
+  for (auto& build : completed)
+    adopt(*build);
+}
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::plan()
+{
+  requested_bytes = 0;
+  VkDeviceSize committed{};
+  std::vector<uint32_t> candidates;
+  for (uint32_t i = 0; i < textures.size(); i++)
+    {
+      Texture& texture{*textures[i]};
+      if (texture.level_bytes.empty())
+        continue;
+
+      const uint32_t tail{tail_level(texture)};
+      if (texture.demand > 0.0f)
+        {
+          // texels one UV unit spans over the pixels it covers, each halving drops a level
+          const float ratio{
+              static_cast<float>(std::max(texture.extent.width, texture.extent.height))
+              / texture.demand};
+          const auto level{ratio > 1.0f ? static_cast<uint32_t>(std::log2(ratio)) : 0u};
+          texture.wanted_level = std::min(level, tail);
+          texture.last_used = frame;
+          texture.demand = 0.0f;
+        }
+      else
+        {
+          texture.wanted_level = tail;
+        }
+
+      requested_bytes += chain_bytes(texture, texture.wanted_level);
+      committed += chain_bytes(texture, texture.pending_level);
+      if (!texture.building && !texture.failed && texture.wanted_level < texture.level)
+        candidates.push_back(i);
+    }
+
+  // a lowered budget trims right away, down to the tails if it has to
+  if (committed > memory_budget)
+    evict(committed - memory_budget, committed, true);
+
+  // the largest shortfall in detail first
+  std::sort(candidates.begin(), candidates.end(), [this](uint32_t l, uint32_t r) {
+    return textures[l]->level - textures[l]->wanted_level
+           > textures[r]->level - textures[r]->wanted_level;
+  });
+  for (uint32_t index : candidates)
+    {
+      if (promotions >= max_promotions)
+        break;
+      Texture& texture{*textures[index]};
+      // the evictions above may have queued a demotion of it since it was listed
+      if (texture.building)
+        continue;
+
+      // settles for a coarser level when nothing else can be trimmed
+      uint32_t level{texture.wanted_level};
+      while (level < texture.level)
+        {
+          const VkDeviceSize grow{chain_bytes(texture, level)
+                                  - chain_bytes(texture, texture.level)};
+          if (committed + grow <= memory_budget)
+            break;
+          if (evict(committed + grow - memory_budget, committed, false) == 0)
+            level++;
+        }
+      if (level >= texture.level)
+        continue;
+
+      committed += chain_bytes(texture, level) - chain_bytes(texture, texture.level);
+      auto build{std::make_shared<Build>()};
+      build->texture = index;
+      build->level = level;
+      build->upload_end = texture.level;
+      texture.building = true;
+      texture.pending_level = level;
+      promotions++;
+      start_decode(index, build);
+    }
+}
+
+VkDeviceSize SngoEngine::Core::Source::Image::EngineTextureStreamer::evict(
+    VkDeviceSize bytes,
+    VkDeviceSize& committed,
+    bool drawn)
+{
+  // chains holding more than their last want asked for first, textures not drawn want their tail;
+  // then drawn chains give up their finest levels
+  VkDeviceSize freed{};
+  for (const bool trim_drawn : {false, true})
+    {
+      if (trim_drawn && !drawn)
+        break;
+      std::vector<uint32_t> victims;
+      for (uint32_t i = 0; i < textures.size(); i++)
+        {
+          const Texture& texture{*textures[i]};
+          if (!texture.level_bytes.empty() && !texture.building
+              && texture.level < (trim_drawn ? tail_level(texture) : texture.wanted_level))
+            victims.push_back(i);
+        }
+      std::sort(victims.begin(), victims.end(), [this](uint32_t l, uint32_t r) {
+        return textures[l]->last_used < textures[r]->last_used;
+      });
+
+      for (uint32_t index : victims)
+        {
+          if (freed >= bytes)
+            break;
+          const Texture& texture{*textures[index]};
+          const VkDeviceSize chain{chain_bytes(texture, texture.level)};
+          uint32_t level{trim_drawn ? texture.level : texture.wanted_level};
+          while (trim_drawn && level < tail_level(texture)
+                 && freed + chain - chain_bytes(texture, level) < bytes)
+            level++;
+          const VkDeviceSize saved{chain - chain_bytes(texture, level)};
+          demote(index, level);
+          freed += saved;
+          committed -= saved;
+        }
+    }
+  return freed;
+}
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::demote(uint32_t texture,
+                                                                    uint32_t level)
+{
+  // every level is copied from the resident image, no staging needed
+  Texture& demoted{*textures[texture]};
+  demoted.building = true;
+  demoted.pending_level = level;
+
+  auto build{std::make_shared<Build>()};
+  build->texture = texture;
+  build->level = level;
+  build->upload_end = level;
+  build->next_level = level;
+  uploads.push_back(build);
+}
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::adopt(Build& build)
+{
+  Texture& texture{*textures[build.texture]};
+  const auto count{static_cast<uint32_t>(texture.level_bytes.size())};
+  EngineTextureImage& target{*texture.target};
+
+  if (texture.level < count)
+    {
+      // frames in flight may still sample the old image
+      Retired old;
+      old.image = target.image;
+      old.image_memory = target.image_memory;
+      old.view = std::move(target.view);
+      old.sampler = std::move(target.sampler);
+      old.frame = frame;
+      retired.push_back(std::move(old));
+      target.image = VK_NULL_HANDLE;
+      target.image_memory = VK_NULL_HANDLE;
+      resident_bytes -= texture.memory_size;
+      if (build.level < texture.level)
+        promotions--;
+    }
+  else
+    {
+      resident++;
+    }
+
+  target.init(device,
+              build.image.image,
+              build.image.image_memory,
+              VkExtent2D{Level_Extent(texture.extent.width, build.level),
+                         Level_Extent(texture.extent.height, build.level)},
+              count - build.level,
+              texture.format,
+              Alloc);
+  texture.memory_size = build.image.memory_size;
+  resident_bytes += texture.memory_size;
+  build.image.image = VK_NULL_HANDLE;
+  build.image.image_memory = VK_NULL_HANDLE;
+  build.pixels = {};
+
+  texture.level = build.level;
+  texture.pending_level = build.level;
+  texture.building = false;
+  if (texture.on_resident)
+    texture.on_resident();
+}
+
+void SngoEngine::Core::Source::Image::EngineTextureStreamer::release_retired(bool all)
+{
+  while (!retired.empty()
+         && (all || retired.front().frame + Macro::MAX_FRAMES_IN_FLIGHT <= frame))
+    {
+      Retired& old{retired.front()};
+      old.view.destroyer();
+      old.sampler.destroyer();
+      vkDestroyImage(device->logical_device, old.image, Alloc);
+      vkFreeMemory(device->logical_device, old.image_memory, Alloc);
+      retired.pop_front();
+    }
+}
+
+VkDeviceSize SngoEngine::Core::Source::Image::EngineTextureStreamer::chain_bytes(
+    const Texture& texture,
+    uint32_t level) const
+{
+  VkDeviceSize bytes{};
+  for (uint32_t i = level; i < texture.level_bytes.size(); i++)
+    bytes += texture.level_bytes[i];
+  return bytes;
+}
+
+uint32_t SngoEngine::Core::Source::Image::EngineTextureStreamer::tail_level(
+    const Texture& texture) const
+{
+  const auto count{static_cast<uint32_t>(texture.level_bytes.size())};
+  uint32_t level{0};
+  while (level + 1 < count
+         && std::max(Level_Extent(texture.extent.width, level),
+                     Level_Extent(texture.extent.height, level))
+                > min_resident_extent)
+    level++;
+  return level;
+}
+
+SngoEngine::Core::Source::Image::EngineTextureStreamer::Progress
+SngoEngine::Core::Source::Image::EngineTextureStreamer::progress() const
+{
+  return {requested.load(),
+          resident.load(),
+          failed.load(),
+          uploaded_bytes.load(),
+          decoded_bytes.load(),
+          resident_bytes,
+          requested_bytes};
+}
+
+bool SngoEngine::Core::Source::Image::EngineTextureStreamer::idle() const
+{
+  return resident.load() + failed.load() == requested.load();
+}
+
+uint64_t SngoEngine::Core::Source::Image::EngineTextureStreamer::frame_count() const
+{
+  return frame;
+}
@@ -0,0 +1,229 @@
+#ifndef __SNGO_TEXTURE_STREAMER_H
+#define __SNGO_TEXTURE_STREAMER_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "src/Core/Device/LogicalDevice.hpp"
+#include "src/Core/Source/Buffer/FrameAllocator.hpp"
+#include "src/Core/Source/Image/Image.hpp"
+#include "src/Core/Source/Image/ImageVIew.hpp"
+#include "src/Core/Source/Image/Sampler.hpp"
+#include "src/Core/Utils/JobSystem.hpp"
+
+namespace SngoEngine::Core::Source::Image
+{
+
+//===========================================================================================================================
+// EngineTextureStreamer
+//===========================================================================================================================
+
+// one mip level inside StreamedPixels::data
+struct StreamedLevel
+{
+  VkDeviceSize offset{};
+  VkDeviceSize size{};
+};
+
+// level i is max(1, width >> i) x max(1, height >> i) texels, rows tightly packed in whole texel
+// blocks; without levels data is a single level
+struct StreamedPixels
+{
+  std::vector<unsigned char> data;
+  uint32_t width{};
+  uint32_t height{};
+  std::vector<StreamedLevel> levels;
+  // VK_FORMAT_UNDEFINED keeps the format the texture was requested with
+  VkFormat format{VK_FORMAT_UNDEFINED};
+};
+
+// Decodes textures as jobs of Utils::Job_System() and uploads them from the render loop, at most
+// budget bytes per frame. A level larger than the budget is copied a band of rows per frame and
+// the new image only replaces the old one once all of its levels are in, so frame time does not
+// depend on texture sizes. Until the first image lands the target EngineTextureImage holds no
+// image and its users sample a placeholder (Get_EmptyTextureImg); on_resident is their cue to
+// patch their descriptors, it is called again every time the target gets a new image.
+//
+// A texture starts out with the tail of its mip chain below min_resident_extent. want() reports
+// how finely it is drawn, finer levels are decoded again and uploaded on demand while the
+// resident ones are copied over on the GPU. Chains are kept within memory_budget by trimming the
+// least recently wanted textures back to what they need (their tail when not drawn at all), and
+// drawn ones below it when that is not enough.
+// Replaced images are destroyed MAX_FRAMES_IN_FLIGHT updates later.
+struct EngineTextureStreamer
+{
+  using Decode = std::function<StreamedPixels()>;
+  using Resident = std::function<void()>;
+
+  struct Progress
+  {
+    uint32_t requested{};
+    // textures with at least their tail resident
+    uint32_t resident{};
+    // failed to decode, their targets keep the placeholder
+    uint32_t failed{};
+    VkDeviceSize uploaded_bytes{};
+    // decoded bytes, uploaded or waiting for upload
+    VkDeviceSize decoded_bytes{};
+    // device memory of the resident chains
+    VkDeviceSize resident_bytes{};
+    // the chains at the levels the last update's want() calls asked for, tails for the rest
+    VkDeviceSize requested_bytes{};
+  };
+
+  EngineTextureStreamer() = default;
+  EngineTextureStreamer(const EngineTextureStreamer&) = delete;
+  EngineTextureStreamer& operator=(const EngineTextureStreamer&) = delete;
+  template <class... Args>
+  explicit EngineTextureStreamer(const Device::LogicalDevice::EngineDevice* _device,
+                                 Args... args)
+  {
+    creator(_device, args...);
+  }
+  template <class... Args>
+  void init(const Device::LogicalDevice::EngineDevice* _device, Args... args)
+  {
+    creator(_device, args...);
+  }
+  ~EngineTextureStreamer()
+  {
+    destroyer();
+  }
+  // waits for the decode jobs, the GPU has to be done with the uploads and replaced images;
+  // targets are left as they are
+  void destroyer();
+
+  // returns the id want() takes; target must stay in place and decode must stay callable (it
+  // runs again for every finer level) until destroyer
+  uint32_t request(EngineTextureImage* target,
+                   Decode decode,
+                   Resident on_resident,
+                   VkFormat format = VK_FORMAT_R8G8B8A8_SRGB);
+  // the culling pass saw texture drawn with one UV unit across pixels_per_uv pixels, the next
+  // update keeps the finest level any call asked for
+  void want(uint32_t texture, float pixels_per_uv);
+  // records this frame's copies into command_buffer ahead of the passes sampling the textures and
+  // calls on_resident of the textures completed by them; frame_index is the slot the frame
+  // timeline handed out
+  void update(VkCommandBuffer command_buffer, uint32_t frame_index);
+
+  [[nodiscard]] Progress progress() const;
+  // every request is resident or failed
+  [[nodiscard]] bool idle() const;
+  // updates so far; images replaced during update n are destroyed by update
+  // n + MAX_FRAMES_IN_FLIGHT, on_resident callers can retire their own objects on the same count
+  [[nodiscard]] uint64_t frame_count() const;
+
+  // at least one row of the widest texture (16384 texels)
+  VkDeviceSize budget{};
+  // device bytes of all chains, tails are always kept even above it
+  VkDeviceSize memory_budget{};
+  // levels up to this size (larger side) are resident from the start
+  uint32_t min_resident_extent{64};
+  // finer chains being decoded or uploaded at once, bounds the decoded pixels held in memory
+  uint32_t max_promotions{4};
+  // budget bytes per frame slot
+  Buffer::EngineFrameAllocator staging{};
+  const Device::LogicalDevice::EngineDevice* device{};
+
+ private:
+  void creator(const Device::LogicalDevice::EngineDevice* _device,
+               VkDeviceSize _budget = VkDeviceSize{8} << 20,
+               VkDeviceSize _memory_budget = VkDeviceSize{256} << 20,
+               const VkAllocationCallbacks* alloc = nullptr);
+
+  struct Texture
+  {
+    EngineTextureImage* target{};
+    VkFormat format{};
+    Decode decode;
+    Resident on_resident;
+
+    // bytes of every level, empty until the first decode
+    std::vector<VkDeviceSize> level_bytes;
+    VkExtent2D extent{};
+    // first level of the resident image, level_bytes.size() while there is none
+    uint32_t level{};
+    // level once the build in flight lands, level without one
+    uint32_t pending_level{};
+    bool building{};
+    bool failed{};
+    VkDeviceSize memory_size{};
+
+    float demand{};
+    uint32_t wanted_level{};
+    uint64_t last_used{};
+  };
+
+  // a new image for one texture, holding the levels [level, chain end)
+  struct Build
+  {
+    uint32_t texture{};
+    uint32_t level{};
+    // levels [level, upload_end) are uploaded from pixels, the rest is copied from the resident
+    // image once they are in
+    uint32_t upload_end{};
+    StreamedPixels pixels;
+    bool failed{};
+
+    EngineImage image{};
+    uint32_t next_level{};
+    // in texel block rows of next_level
+    uint32_t next_row{};
+  };
+
+  struct Retired
+  {
+    VkImage image{};
+    VkDeviceMemory image_memory{};
+    ImageView::EngineImageView view{};
+    EngineSampler sampler{};
+    uint64_t frame{};
+  };
+
+  void start_decode(uint32_t texture, const std::shared_ptr<Build>& build);
+  void receive(const std::shared_ptr<Build>& build);
+  // schedules promotions towards the wanted levels and the demotions making room for them
+  void plan();
+  // trims least recently wanted chains until bytes are freed, returns the bytes freed; chains
+  // still drawn at their level are only trimmed with drawn, promotions would take turns otherwise
+  VkDeviceSize evict(VkDeviceSize bytes, VkDeviceSize& committed, bool drawn);
+  void demote(uint32_t texture, uint32_t level);
+  void adopt(Build& build);
+  void release_retired(bool all);
+
+  [[nodiscard]] VkDeviceSize chain_bytes(const Texture& texture, uint32_t level) const;
+  // coarsest level min_resident_extent keeps
+  [[nodiscard]] uint32_t tail_level(const Texture& texture) const;
+
+  std::vector<std::unique_ptr<Texture>> textures;
+  std::vector<Utils::JobHandle> jobs;
+  // filled by the decode jobs
+  std::mutex decoded_mutex;
+  std::deque<std::shared_ptr<Build>> decoded;
+  // render loop only, builds may take several frames
+  std::deque<std::shared_ptr<Build>> uploads;
+  std::deque<Retired> retired;
+  uint64_t frame{};
+  uint32_t promotions{};
+
+  std::atomic<uint32_t> requested{};
+  std::atomic<uint32_t> resident{};
+  std::atomic<uint32_t> failed{};
+  std::atomic<VkDeviceSize> uploaded_bytes{};
+  std::atomic<VkDeviceSize> decoded_bytes{};
+  VkDeviceSize resident_bytes{};
+  VkDeviceSize requested_bytes{};
+  const VkAllocationCallbacks* Alloc{};
+};
+
+}  // namespace SngoEngine::Core::Source::Image
+
+#endif
@@ -0,0 +1,149 @@
+#include "MeshCache.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+
+#include "fmt/core.h"
+
+namespace
+{
+constexpr uint32_t MESH_CACHE_MAGIC{0x4D474E53};  // "SNGM"
+constexpr uint32_t MESH_CACHE_VERSION{2};
+
+struct MeshCacheHeader
+{
+  uint32_t magic{MESH_CACHE_MAGIC};
+  uint32_t version{MESH_CACHE_VERSION};
+  uint64_t stamp{};
+  uint32_t flags{};
+  uint32_t vertex_stride{};
+  uint64_t vertex_bytes{};
+  uint64_t index_count{};
+  uint64_t primitive_count{};
+  uint64_t meshlet_count{};
+};
+
+template <typename T>
+void write_pod(std::ofstream& out, const T* data, size_t count)
+{
+  out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+}
+
+template <typename T>
+bool read_pod(std::ifstream& in, T* data, size_t count)
+{
+  in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(sizeof(T) * count));
+  return static_cast<bool>(in);
+}
+}  // namespace
+
+uint64_t SngoEngine::Core::Source::Model::MeshCache_Stamp(const std::vector<std::string>& sources)
+{
+  uint64_t stamp{0xcbf29ce484222325ull};
+  auto mix = [&stamp](uint64_t v) {
+    stamp ^= v;
+    stamp *= 0x100000001b3ull;
+  };
+
+  for (const auto& source : sources)
+    {
+      std::error_code ec;
+      const auto size{std::filesystem::file_size(source, ec)};
+      if (ec)
+        return 0;
+      const auto time{std::filesystem::last_write_time(source, ec)};
+      if (ec)
+        return 0;
+      mix(size);
+      mix(static_cast<uint64_t>(time.time_since_epoch().count()));
+    }
+  return stamp;
+}
+
+bool SngoEngine::Core::Source::Model::Read_MeshCache(const std::string& cache_file,
+                                                     MeshCacheData& data)
+{
+  std::ifstream in(cache_file, std::ios::binary);
+  if (!in.is_open())
+    return false;
+
+  MeshCacheHeader header{};
+  if (!read_pod(in, &header, 1) || header.magic != MESH_CACHE_MAGIC
+      || header.version != MESH_CACHE_VERSION)
+    return false;
+
+  data.stamp = header.stamp;
+  data.flags = header.flags;
+  data.vertex_stride = header.vertex_stride;
+  data.vertices.resize(header.vertex_bytes);
+  data.indices.resize(header.index_count);
+  data.primitives.resize(header.primitive_count);
+  data.meshlets.resize(header.meshlet_count);
+  if (!read_pod(in, data.vertices.data(), data.vertices.size())
+      || !read_pod(in, data.indices.data(), data.indices.size())
+      || !read_pod(in, data.meshlets.data(), data.meshlets.size()))
+    return false;
+
+  for (auto& primitive : data.primitives)
+    {
+      uint32_t fields[5];
+      if (!read_pod(in, fields, 5))
+        return false;
+      primitive.firstIndex = fields[0];
+      primitive.indexCount = fields[1];
+      primitive.firstVertex = fields[2];
+      primitive.vertexCount = fields[3];
+      primitive.lods.resize(fields[4]);
+      if (!read_pod(in, primitive.lods.data(), primitive.lods.size()))
+        return false;
+    }
+  return true;
+}
+
+void SngoEngine::Core::Source::Model::Write_MeshCache(const std::string& cache_file,
+                                                      const MeshCacheData& data)
+{
+  const std::string temp_file{cache_file + ".tmp"};
+  {
+    std::ofstream out(temp_file, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+      {
+        fmt::println("[warn] failed to write mesh cache {}", cache_file);
+        return;
+      }
+
+    MeshCacheHeader header{};
+    header.stamp = data.stamp;
+    header.flags = data.flags;
+    header.vertex_stride = data.vertex_stride;
+    header.vertex_bytes = data.vertices.size();
+    header.index_count = data.indices.size();
+    header.primitive_count = data.primitives.size();
+    header.meshlet_count = data.meshlets.size();
+    write_pod(out, &header, 1);
+    write_pod(out, data.vertices.data(), data.vertices.size());
+    write_pod(out, data.indices.data(), data.indices.size());
+    write_pod(out, data.meshlets.data(), data.meshlets.size());
+    for (const auto& primitive : data.primitives)
+      {
+        const uint32_t fields[5]{primitive.firstIndex,
+                                 primitive.indexCount,
+                                 primitive.firstVertex,
+                                 primitive.vertexCount,
+                                 static_cast<uint32_t>(primitive.lods.size())};
+        write_pod(out, fields, 5);
+        write_pod(out, primitive.lods.data(), primitive.lods.size());
+      }
+    if (!out)
+      {
+        fmt::println("[warn] failed to write mesh cache {}", cache_file);
+        return;
+      }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(temp_file, cache_file, ec);
+  if (ec)
+    fmt::println("[warn] failed to write mesh cache {}: {}", cache_file, ec.message());
+}
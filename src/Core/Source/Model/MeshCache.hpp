@@ -0,0 +1,58 @@
+#ifndef __SNGO_MESHCACHE_H
+#define __SNGO_MESHCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "src/Core/Utils/Meshlet.hpp"
+
+namespace SngoEngine::Core::Source::Model
+{
+
+//===========================================================================================================================
+// MeshCache
+//===========================================================================================================================
+
+struct MeshCacheLod
+{
+  uint32_t firstIndex{};
+  uint32_t indexCount{};
+  float error{};
+  uint32_t firstMeshlet{};
+  uint32_t meshletCount{};
+};
+
+struct MeshCachePrimitive
+{
+  uint32_t firstIndex{};
+  uint32_t indexCount{};
+  uint32_t firstVertex{};
+  uint32_t vertexCount{};
+  std::vector<MeshCacheLod> lods{};
+};
+
+// processed geometry of one model file, valid while stamp and flags match the source
+struct MeshCacheData
+{
+  uint64_t stamp{};
+  uint32_t flags{};
+  uint32_t vertex_stride{};
+  std::vector<std::byte> vertices{};
+  std::vector<uint32_t> indices{};
+  std::vector<MeshCachePrimitive> primitives{};
+  std::vector<Utils::Meshlet> meshlets{};
+};
+
+// size and write time of every source file folded together, 0 if one of them is missing
+uint64_t MeshCache_Stamp(const std::vector<std::string>& sources);
+
+// false if the file is missing, truncated or from another cache version
+bool Read_MeshCache(const std::string& cache_file, MeshCacheData& data);
+// written next to the model through a temporary file, failures only print a warning
+void Write_MeshCache(const std::string& cache_file, const MeshCacheData& data);
+
+}  // namespace SngoEngine::Core::Source::Model
+
+#endif
@@ -2,10 +2,17 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <filesystem>
 #include <glm/ext/vector_float4.hpp>
 #include <stdexcept>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -18,8 +25,13 @@
 #include "src/Core/Source/Buffer/IndexBuffer.hpp"
 #include "src/Core/Source/Buffer/VertexBuffer.hpp"
 #include "src/Core/Source/Image/Image.hpp"
+#include "src/Core/Source/Image/KtxTranscode.hpp"
+#include "src/Core/Source/Image/MipChain.hpp"
 #include "src/Core/Source/Image/Sampler.hpp"
+#include "src/Core/Source/Image/TextureAtlas.hpp"
+#include "src/Core/Source/Image/TextureCompress.hpp"
 #include "src/Core/Utils/tiny_gltf.hpp"
+#include "ktxvulkan.h"
 
 #define GLM_FORCE_RADIANS
 #define GLM_FORCE_DEPTH_ZERO_TO_ONE
@@ -39,6 +51,9 @@ void SngoEngine::Core::Source::Model::gltf_LoadImage(
   for (size_t i = 0; i < input.images.size(); i++)
     {
       tinygltf::Image& glTFImage = input.images[i];
+      // atlased (AtlasTextures) and undecoded images keep no texture of their own
+      if (glTFImage.image.empty())
+        continue;
       // Get the image data from the glTF loader
       unsigned char* buffer = nullptr;
       VkDeviceSize bufferSize = 0;
@@ -248,36 +263,42 @@ void SngoEngine::Core::Source::Model::Get_NodeDimensions(GltfNode* node,
 // GltfMaterial
 //===========================================================================================================================
 
-void SngoEngine::Core::Source::Model::GltfMaterial::create_set(VkDescriptorPool _pool,
-                                                               VkDescriptorSetLayout _layout,
-                                                               uint32_t bingding_flags)
+void SngoEngine::Core::Source::Model::GltfMaterial::create_set(
+    VkDescriptorPool _pool,
+    VkDescriptorSetLayout _layout,
+    uint32_t bingding_flags,
+    Descriptor::EngineDescriptorWriteBatch& batch,
+    const VkDescriptorImageInfo& placeholder)
 {
   descriptor_set.init(device, _layout, _pool);
-  std::vector<VkWriteDescriptorSet> writes{};
-  VkWriteDescriptorSet writeDescriptorSet{};
+  write_set(bingding_flags, batch, placeholder);
+}
+
+void SngoEngine::Core::Source::Model::GltfMaterial::write_set(
+    uint32_t bingding_flags,
+    Descriptor::EngineDescriptorWriteBatch& batch,
+    const VkDescriptorImageInfo& placeholder)
+{
+  auto descriptor_of = [&](const GltfTexture& texture) -> const VkDescriptorImageInfo& {
+    return texture.texture->is_resident() ? texture.texture->descriptor : placeholder;
+  };
+  uint32_t binding{0};
 
   if (bingding_flags & DescriptorBindingFlags::ImageBaseColor)
     {
-      writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-      writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-      writeDescriptorSet.descriptorCount = 1;
-      writeDescriptorSet.dstSet = descriptor_set.descriptor_set;
-      writeDescriptorSet.dstBinding = static_cast<uint32_t>(writes.size());
-      writeDescriptorSet.pImageInfo = &base_color.texture->descriptor;
-      writes.push_back(writeDescriptorSet);
+      batch.write_image(descriptor_set.descriptor_set,
+                        binding++,
+                        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                        descriptor_of(base_color));
     }
-  if (normal.is_available() && bingding_flags & DescriptorBindingFlags::ImageNormalMap)
+  // recycled sets still hold another material's normal map otherwise
+  if (bingding_flags & DescriptorBindingFlags::ImageNormalMap)
     {
-      writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-      writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-      writeDescriptorSet.descriptorCount = 1;
-      writeDescriptorSet.dstSet = descriptor_set.descriptor_set;
-      writeDescriptorSet.dstBinding = static_cast<uint32_t>(writes.size());
-      writeDescriptorSet.pImageInfo = &normal.texture->descriptor;
-      writes.push_back(writeDescriptorSet);
+      batch.write_image(descriptor_set.descriptor_set,
+                        binding++,
+                        VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                        normal.is_available() ? descriptor_of(normal) : placeholder);
     }
-
-  descriptor_set.updateWrite(writes);
 }
 
 //===========================================================================================================================
@@ -287,19 +308,531 @@ void SngoEngine::Core::Source::Model::GltfMaterial::create_set(VkDescriptorPool
 void SngoEngine::Core::Source::Model::EngineGltfModel::bind_buffers(VkCommandBuffer command_buffer)
 {
   const VkDeviceSize offsets[1] = {0};
-  vkCmdBindVertexBuffers(command_buffer, 0, 1, &model.vertex_buffer.buffer, offsets);
-  vkCmdBindIndexBuffer(command_buffer, model.index_buffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+  // CompactVertices models keep no 96 byte vertex buffer
+  if (model.vertex_buffer.buffer != VK_NULL_HANDLE)
+    vkCmdBindVertexBuffers(command_buffer, 0, 1, &model.vertex_buffer.buffer, offsets);
+  // CompactIndices models bind their index regions per primitive in drawNode
+  if (model.index_buffer.buffer != VK_NULL_HANDLE)
+    vkCmdBindIndexBuffer(command_buffer, model.index_buffer.buffer, 0, VK_INDEX_TYPE_UINT32);
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::bind_compactBuffers(
+    VkCommandBuffer command_buffer,
+    uint32_t region)
+{
+  if (region >= compact.regions.size())
+    {
+      throw std::runtime_error("failed to bind compact vertex region, out of range");
+    }
+  const VkDeviceSize offsets[1] = {compact.regions[region].offset};
+  vkCmdBindVertexBuffers(command_buffer, 0, 1, &compact.vertex_buffer.buffer, offsets);
+  if (model.index_buffer.buffer != VK_NULL_HANDLE)
+    vkCmdBindIndexBuffer(command_buffer, model.index_buffer.buffer, 0, VK_INDEX_TYPE_UINT32);
 }
 
 void SngoEngine::Core::Source::Model::EngineGltfModel::load_imgs(tinygltf::Model& input,
                                                                  VkCommandPool _pool)
 {
   imgs.resize(input.images.size() + 1);
+  if (loading_flags & FileLoadingFlags::AtlasTextures)
+    load_atlas(input, _pool);
 
   gltf_LoadImage(device, _pool, input, imgs, Alloc);
   Image::Get_EmptyTextureImg(device, imgs.back(), _pool, Alloc);
 }
 
+void SngoEngine::Core::Source::Model::EngineGltfModel::load_atlas(tinygltf::Model& input,
+                                                                  VkCommandPool _pool)
+{
+  // materials sampling the same images in the same slots share one group, and one UV rewrite
+  // moves every texture of a group, so its images have to land at the same rect of one page
+  // per slot and be sampled by no other group
+  constexpr size_t SLOTS{5};
+  using Slots = std::array<int, SLOTS>;
+  struct Group
+  {
+    Slots images{};
+    std::vector<size_t> materials{};
+    bool eligible{true};
+  };
+  std::vector<Group> groups;
+  std::vector<size_t> material_groups(input.materials.size(), SIZE_MAX);
+  for (size_t i = 0; i < input.materials.size(); i++)
+    {
+      const tinygltf::Material& material{input.materials[i]};
+      const Slots images{material.pbrMetallicRoughness.baseColorTexture.index,
+                         material.pbrMetallicRoughness.metallicRoughnessTexture.index,
+                         material.normalTexture.index,
+                         material.occlusionTexture.index,
+                         material.emissiveTexture.index};
+      if (std::all_of(images.begin(), images.end(), [](int image) { return image < 0; }))
+        continue;
+      auto group{std::find_if(
+          groups.begin(), groups.end(), [&](const Group& g) { return g.images == images; })};
+      if (group == groups.end())
+        group = groups.insert(groups.end(), Group{images});
+      group->materials.push_back(i);
+      material_groups[i] = static_cast<size_t>(group - groups.begin());
+
+      // only TEXCOORD_0 is loaded, see load_node
+      const int tex_coords[SLOTS]{material.pbrMetallicRoughness.baseColorTexture.texCoord,
+                                  material.pbrMetallicRoughness.metallicRoughnessTexture.texCoord,
+                                  material.normalTexture.texCoord,
+                                  material.occlusionTexture.texCoord,
+                                  material.emissiveTexture.texCoord};
+      for (size_t slot = 0; slot < SLOTS; slot++)
+        {
+          if (images[slot] >= 0 && tex_coords[slot] != 0)
+            group->eligible = false;
+        }
+    }
+
+  // small decoded 8 bit images of one extent, sampled by one group only; an image in several
+  // slots of its group (packed occlusion, roughness, metallic) is stored once
+  auto first_slot = [](const Group& group, size_t slot) {
+    return group.images[slot] >= 0
+           && std::find(group.images.begin(), group.images.begin() + slot, group.images[slot])
+                  == group.images.begin() + slot;
+  };
+  std::vector<size_t> owners(input.images.size(), SIZE_MAX);
+  for (size_t g = 0; g < groups.size(); g++)
+    {
+      Group& group{groups[g]};
+      const tinygltf::Image* first{};
+      for (size_t slot = 0; slot < SLOTS; slot++)
+        {
+          if (!first_slot(group, slot))
+            continue;
+          const int index{group.images[slot]};
+          if (static_cast<size_t>(index) >= input.images.size())
+            {
+              group.eligible = false;
+              continue;
+            }
+          const tinygltf::Image& image{input.images[index]};
+          if (image.image.empty() || image.bits != 8
+              || (image.component != 3 && image.component != 4)
+              || static_cast<uint32_t>(image.width) > atlas.max_extent
+              || static_cast<uint32_t>(image.height) > atlas.max_extent
+              || (first && (image.width != first->width || image.height != first->height)))
+            group.eligible = false;
+          first = &image;
+
+          if (owners[index] == SIZE_MAX)
+            owners[index] = g;
+          else if (owners[index] != g)
+            {
+              group.eligible = false;
+              groups[owners[index]].eligible = false;
+            }
+        }
+    }
+
+  // a rect only holds UVs inside [0, 1], repeating primitives keep their textures
+  constexpr float UV_SLACK{1e-3f};
+  for (const tinygltf::Mesh& mesh : input.meshes)
+    {
+      for (const tinygltf::Primitive& primitive : mesh.primitives)
+        {
+          if (primitive.material < 0
+              || static_cast<size_t>(primitive.material) >= material_groups.size()
+              || material_groups[primitive.material] == SIZE_MAX)
+            continue;
+          Group& group{groups[material_groups[primitive.material]]};
+          if (!group.eligible)
+            continue;
+
+          const auto attribute{primitive.attributes.find("TEXCOORD_0")};
+          if (attribute == primitive.attributes.end())
+            {
+              group.eligible = false;
+              continue;
+            }
+          const tinygltf::Accessor& accessor{input.accessors[attribute->second]};
+          if (accessor.bufferView < 0 || accessor.componentType != TINYGLTF_COMPONENT_TYPE_FLOAT)
+            {
+              group.eligible = false;
+              continue;
+            }
+          const tinygltf::BufferView& view{input.bufferViews[accessor.bufferView]};
+          const size_t stride{view.byteStride ? static_cast<size_t>(view.byteStride)
+                                              : sizeof(float) * 2};
+          const unsigned char* data{
+              &input.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset]};
+          for (size_t v = 0; v < accessor.count && group.eligible; v++)
+            {
+              float uv[2];
+              std::memcpy(uv, data + v * stride, sizeof(uv));
+              group.eligible = uv[0] >= -UV_SLACK && uv[0] <= 1.0f + UV_SLACK
+                               && uv[1] >= -UV_SLACK && uv[1] <= 1.0f + UV_SLACK;
+            }
+        }
+    }
+
+  std::vector<size_t> packed_groups;
+  std::vector<VkExtent2D> extents;
+  for (size_t g = 0; g < groups.size(); g++)
+    {
+      if (!groups[g].eligible)
+        continue;
+      const int index{
+          *std::find_if(groups[g].images.begin(), groups[g].images.end(), [](int image) {
+            return image >= 0;
+          })};
+      packed_groups.push_back(g);
+      extents.push_back({static_cast<uint32_t>(input.images[index].width),
+                         static_cast<uint32_t>(input.images[index].height)});
+    }
+  const Image::AtlasLayout layout{Image::Pack_Atlas(extents, atlas.page_size, atlas.padding)};
+
+  // one page image per page and slot in use, appended behind the glTF images
+  std::vector<std::array<uint32_t, SLOTS>> page_imgs(layout.pages.size());
+  for (auto& slots : page_imgs)
+    slots.fill(UINT32_MAX);
+  std::vector<uint32_t> img_pages;
+  for (size_t k = 0; k < packed_groups.size(); k++)
+    {
+      const uint32_t page{layout.rects[k].page};
+      if (!layout.rects[k].is_packed())
+        continue;
+      for (size_t slot = 0; slot < SLOTS; slot++)
+        {
+          uint32_t& img{page_imgs[page][slot]};
+          if (first_slot(groups[packed_groups[k]], slot) && img == UINT32_MAX)
+            {
+              img = static_cast<uint32_t>(input.images.size() + img_pages.size());
+              img_pages.push_back(page);
+            }
+        }
+    }
+  if (img_pages.empty())
+    return;
+  imgs.resize(input.images.size() + img_pages.size() + 1);
+
+  std::vector<std::vector<unsigned char>> pages(img_pages.size());
+  for (size_t i = 0; i < pages.size(); i++)
+    pages[i].resize(size_t{layout.pages[img_pages[i]].width} * layout.pages[img_pages[i]].height
+                    * 4);
+
+  atlas.redirects.assign(input.images.size(), UINT32_MAX);
+  atlas.uv_transforms.assign(input.materials.size(), glm::vec4(1.0f, 1.0f, 0.0f, 0.0f));
+  uint32_t packed_images{};
+  for (size_t k = 0; k < packed_groups.size(); k++)
+    {
+      const Image::AtlasRect& rect{layout.rects[k]};
+      if (!rect.is_packed())
+        continue;
+      const Group& group{groups[packed_groups[k]]};
+      const VkExtent2D page_extent{layout.pages[rect.page]};
+      for (size_t slot = 0; slot < SLOTS; slot++)
+        {
+          if (!first_slot(group, slot))
+            continue;
+          tinygltf::Image& image{input.images[group.images[slot]]};
+          const uint32_t img{page_imgs[rect.page][slot]};
+          Image::Blit_AtlasRect(pages[img - input.images.size()],
+                                page_extent,
+                                rect,
+                                image.image.data(),
+                                static_cast<uint32_t>(image.component),
+                                atlas.padding);
+          std::vector<unsigned char>().swap(image.image);
+          atlas.redirects[group.images[slot]] = img;
+          packed_images++;
+        }
+      const glm::vec4 transform{
+          static_cast<float>(rect.width) / static_cast<float>(page_extent.width),
+          static_cast<float>(rect.height) / static_cast<float>(page_extent.height),
+          static_cast<float>(rect.x) / static_cast<float>(page_extent.width),
+          static_cast<float>(rect.y) / static_cast<float>(page_extent.height)};
+      for (size_t material : group.materials)
+        atlas.uv_transforms[material] = transform;
+    }
+
+  for (size_t i = 0; i < pages.size(); i++)
+    {
+      const VkExtent2D& extent{layout.pages[img_pages[i]]};
+      imgs[input.images.size() + i].init(
+          device,
+          _pool,
+          Image::EnginePixelData{pages[i].data(), extent.width, extent.height, pages[i].size()},
+          Alloc);
+    }
+  atlas.page_count = static_cast<uint32_t>(pages.size());
+
+  fmt::println("texture atlas: {} of {} images in {} page textures",
+               packed_images,
+               input.images.size(),
+               atlas.page_count);
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::stream_imgs(
+    tinygltf::Model& input,
+    VkCommandPool _pool,
+    Image::EngineTextureStreamer* streamer,
+    const std::string& texture_cache)
+{
+  imgs.resize(input.images.size() + 1);
+  Image::Get_EmptyTextureImg(device, imgs.back(), _pool, Alloc);
+  patched_sets.init(device);
+  texture_streamer = streamer;
+  stream_ids.assign(imgs.size(), UINT32_MAX);
+
+  // materials sample imgs[texture index] (see gltf_LoadMaterial); color wins over normal over
+  // linear use, unreferenced images count as color
+  std::vector<Image::TextureRole> roles(input.images.size(), Image::TextureRole::Color);
+  auto assign = [&roles](int index, Image::TextureRole role) {
+    if (index >= 0 && static_cast<size_t>(index) < roles.size())
+      roles[index] = role;
+  };
+  for (const tinygltf::Material& material : input.materials)
+    {
+      assign(material.pbrMetallicRoughness.metallicRoughnessTexture.index,
+             Image::TextureRole::Linear);
+      assign(material.occlusionTexture.index, Image::TextureRole::Linear);
+    }
+  for (const tinygltf::Material& material : input.materials)
+    assign(material.normalTexture.index, Image::TextureRole::Normal);
+  // masked base colors keep their alpha test coverage in every mip
+  std::vector<float> alpha_cutoffs(input.images.size());
+  for (const tinygltf::Material& material : input.materials)
+    {
+      const int base_color{material.pbrMetallicRoughness.baseColorTexture.index};
+      assign(base_color, Image::TextureRole::Color);
+      assign(material.emissiveTexture.index, Image::TextureRole::Color);
+      if (material.alphaMode == "MASK" && base_color >= 0
+          && static_cast<size_t>(base_color) < alpha_cutoffs.size())
+        alpha_cutoffs[base_color] = static_cast<float>(material.alphaCutoff);
+    }
+
+  // roles whose block formats the device cannot sample stay 8 bit RGBA and uncached
+  std::array<bool, 3> compress{};
+  if (!texture_cache.empty())
+    {
+      std::error_code ec;
+      std::filesystem::create_directories(texture_cache, ec);
+      for (const Image::TextureRole role :
+           {Image::TextureRole::Color, Image::TextureRole::Linear, Image::TextureRole::Normal})
+        {
+          compress[static_cast<size_t>(role)] = Image::Compression_Supported(device, role);
+          if (!compress[static_cast<size_t>(role)])
+            {
+              fmt::println("[warn] device samples no BC1/BC3 for texture role {}, kept as RGBA8",
+                           static_cast<uint32_t>(role));
+            }
+        }
+    }
+
+  for (size_t i = 0; i < input.images.size(); i++)
+    {
+      tinygltf::Image& glTFImage = input.images[i];
+      if (glTFImage.image.empty())
+        continue;
+
+      // both keep the encoded bytes, the streamer decodes again for every finer level
+      Image::EngineTextureStreamer::Decode decode;
+      const std::string extension{glTFImage.uri.substr(glTFImage.uri.find_last_of('.') + 1)};
+      if (extension == "ktx" || extension == "ktx2" || glTFImage.mimeType == "image/ktx2")
+        {
+          // Basis supercompressed KTX2 is transcoded here, on the decoding worker
+          decode = [device = device,
+                    role = roles[i],
+                    name = glTFImage.uri,
+                    bytes = std::move(glTFImage.image)]() {
+            ktxTexture* texture{};
+            if (ktxTexture_CreateFromMemory(bytes.data(),
+                                            bytes.size(),
+                                            KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT,
+                                            &texture)
+                != KTX_SUCCESS)
+              {
+                throw std::runtime_error("failed to decode ktx image " + name);
+              }
+            if (Image::Transcode_Ktx(texture, device, role) != KTX_SUCCESS)
+              {
+                ktxTexture_Destroy(texture);
+                throw std::runtime_error("failed to transcode ktx image " + name);
+              }
+            Image::StreamedPixels pixels;
+            pixels.width = texture->baseWidth;
+            pixels.height = texture->baseHeight;
+            pixels.format = ktxTexture_GetVkFormat(texture);
+            const ktx_uint8_t* data{ktxTexture_GetData(texture)};
+            pixels.data.assign(data, data + ktxTexture_GetSize(texture));
+            bool complete{true};
+            for (uint32_t level = 0; level < texture->numLevels; level++)
+              {
+                ktx_size_t offset{};
+                complete = complete
+                           && ktxTexture_GetImageOffset(texture, level, 0, 0, &offset)
+                                  == KTX_SUCCESS;
+                pixels.levels.push_back({offset, ktxTexture_GetImageSize(texture, level)});
+              }
+            ktxTexture_Destroy(texture);
+            if (!complete)
+              {
+                throw std::runtime_error("failed to read the levels of ktx image " + name);
+              }
+            return pixels;
+          };
+        }
+      else
+        {
+          // a cached chain skips the decode as well
+          decode = [index = static_cast<int>(i),
+                    name = glTFImage.name,
+                    settings = Image::MipChainSettings{roles[i],
+                                                       Image::MipFilter::Kaiser,
+                                                       alpha_cutoffs[i]},
+                    texture_cache = compress[static_cast<size_t>(roles[i])] ? texture_cache
+                                                                            : std::string{},
+                    bytes = std::move(glTFImage.image)]() {
+            std::string cache_file;
+            Image::StreamedPixels pixels;
+            if (!texture_cache.empty())
+              {
+                cache_file = fmt::format(
+                    "{}/{:016x}.bc",
+                    texture_cache,
+                    Image::TextureCache_Key(bytes, settings.role, settings.alpha_cutoff));
+                if (Image::Read_TextureCache(cache_file, pixels))
+                  return pixels;
+              }
+
+            tinygltf::Image decoded;
+            decoded.name = name;
+            std::string error, warning;
+            if (!tinygltf::LoadImageData(&decoded,
+                                         index,
+                                         &error,
+                                         &warning,
+                                         0,
+                                         0,
+                                         bytes.data(),
+                                         static_cast<int>(bytes.size()),
+                                         nullptr))
+              {
+                throw std::runtime_error("failed to decode gltf image " + name + ": " + error);
+              }
+            if (decoded.bits != 8 || decoded.component != 4)
+              {
+                throw std::runtime_error("failed to stream gltf image " + name
+                                         + ", only 8 bit RGBA is supported");
+              }
+            pixels = {std::move(decoded.image),
+                      static_cast<uint32_t>(decoded.width),
+                      static_cast<uint32_t>(decoded.height)};
+            Image::Generate_MipChain(pixels, settings);
+            if (!cache_file.empty())
+              {
+                Image::Compress_Pixels(pixels, settings.role);
+                Image::Write_TextureCache(cache_file, pixels);
+              }
+            return pixels;
+          };
+        }
+      stream_ids[i] = streamer->request(
+          &imgs[i],
+          std::move(decode),
+          [this, i]() { patch_texture(static_cast<uint32_t>(i)); },
+          roles[i] == Image::TextureRole::Color ? VK_FORMAT_R8G8B8A8_SRGB
+                                                : VK_FORMAT_R8G8B8A8_UNORM);
+    }
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::patch_texture(uint32_t img_index)
+{
+  const Image::EngineTextureImage* texture{&imgs[img_index]};
+  Descriptor::EngineDescriptorWriteBatch batch(device, materials.size());
+  if (bindless.enabled)
+    {
+      // frames in flight may still sample the entry, each table takes it once its slot is free
+      for (auto& pending : bindless.pending)
+        pending.push_back(img_index);
+    }
+  else
+    {
+      const uint64_t frame{texture_streamer->frame_count()};
+      while (!retired_sets.empty()
+             && retired_sets.front().frame + Macro::MAX_FRAMES_IN_FLIGHT <= frame)
+        {
+          spare_sets.push_back(retired_sets.front().set);
+          retired_sets.pop_front();
+        }
+      for (auto& material : materials)
+        {
+          if (material.descriptor_set.descriptor_set == VK_NULL_HANDLE
+              || (material.base_color.texture != texture && material.normal.texture != texture))
+            continue;
+          retired_sets.push_back({material.descriptor_set.descriptor_set, frame});
+          if (spare_sets.empty())
+            {
+              material.descriptor_set.init(device, &layouts.texture, &patched_sets);
+            }
+          else
+            {
+              material.descriptor_set.descriptor_set = spare_sets.back();
+              spare_sets.pop_back();
+            }
+          material.write_set(layouts.descript_bindingflags, batch, placeholder());
+        }
+    }
+  batch.flush();
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::request_mips(
+    const glm::mat4& view_model,
+    const glm::mat4& projection,
+    float viewport_height)
+{
+  if (!texture_streamer)
+    return;
+
+  // flipped projections negate [1][1]
+  const float pixels_per_unit{std::abs(projection[1][1]) * viewport_height * 0.5f};
+  for (GltfNode* node : linear_nodes)
+    {
+      if (!node->mesh)
+        continue;
+
+      const glm::mat4 node_matrix{(loading_flags & FileLoadingFlags::PreTransformVertices)
+                                      ? glm::mat4(1.0f)
+                                      : node->getMatrix()};
+      const glm::mat4 m{view_model * node_matrix};
+      float planes[6][4];
+      Utils::Extract_FrustumPlanes(glm::value_ptr(projection * m), planes);
+      const float scale{std::max({glm::length(glm::vec3(m[0])),
+                                  glm::length(glm::vec3(m[1])),
+                                  glm::length(glm::vec3(m[2]))})};
+
+      for (const Primitive& primitive : node->mesh->primitives)
+        {
+          if (!primitive.material || primitive.uv_density <= 0.0f
+              || !Utils::Sphere_InFrustum(glm::value_ptr(primitive.dimensions.center),
+                                          primitive.dimensions.radius,
+                                          planes))
+            continue;
+
+          // at the nearest point of the bounds, a primitive around the camera wants full detail
+          const glm::vec3 center{m * glm::vec4(primitive.dimensions.center, 1.0f)};
+          const float distance{
+              std::max(glm::length(center) - primitive.dimensions.radius * scale, 1e-3f)};
+          const float pixels_per_uv{pixels_per_unit * scale / distance / primitive.uv_density};
+
+          // by the image actually sampled, the placeholder is not streamed
+          for (const GltfTexture* texture : {&primitive.material->base_color,
+                                             &primitive.material->normal})
+            {
+              if (!texture->is_available())
+                continue;
+              const auto img{static_cast<size_t>(texture->texture - imgs.data())};
+              if (img < stream_ids.size() && stream_ids[img] != UINT32_MAX)
+                texture_streamer->want(stream_ids[img], pixels_per_uv);
+            }
+        }
+    }
+}
+
 void SngoEngine::Core::Source::Model::EngineGltfModel::load_node(
     const tinygltf::Node& _node,
     const tinygltf::Model& _input,
@@ -354,7 +887,7 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::load_node(
   if (_node.mesh > -1)
     {
       const tinygltf::Mesh gltf_mesh = _input.meshes[_node.mesh];
-      Mesh* mesh = new Mesh(device, new_node->matrix);
+      Mesh* mesh = new Mesh(new_node->matrix);
       mesh->name = gltf_mesh.name;
 
       // Iterate through all primitives of this node's mesh
@@ -473,7 +1006,6 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::load_node(
                       {
                         vert.color = glm::make_vec4(&colors_buffer[v * 4]);
                       }
-                    _vertexbuffer.push_back(vert);
                   }
                 vert.tangent = tangents_buffer ? glm::vec4(glm::make_vec4(&tangents_buffer[v * 4]))
                                                : glm::vec4(0.0f);
@@ -533,6 +1065,15 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::load_node(
             primitive.firstVertex = vertexStart;
             primitive.vertexCount = vertexCount;
             primitive.materialIndex = glTF_primitive.material;
+            primitive.components =
+                GLTF_EngineModelVertexData::POS
+                | (normals_buffer ? GLTF_EngineModelVertexData::NORMAL : 0)
+                | (texCoords_buffer ? GLTF_EngineModelVertexData::UV : 0)
+                | (colors_buffer ? GLTF_EngineModelVertexData::COLOR : 0)
+                | (hasSkin
+                       ? GLTF_EngineModelVertexData::JOINT0 | GLTF_EngineModelVertexData::WEIGHT0
+                       : 0)
+                | (tangents_buffer ? GLTF_EngineModelVertexData::TANGENT : 0);
             mesh->primitives.push_back(primitive);
           }
           new_node->mesh = mesh;
@@ -554,6 +1095,7 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::load_nodes(
     const Device::LogicalDevice::EngineDevice* _device,
     VkCommandPool _pool,
     const tinygltf::Model& _input,
+    const std::string& _gltf_file,
     uint32_t flags)
 {
   std::vector<uint32_t> index_data;
@@ -574,11 +1116,6 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::load_nodes(
         {
           node->skin = skins[node->skinIndex];
         }
-      // Initial pose
-      if (node->mesh)
-        {
-          node->update();
-        }
     }
 
   // Pre-Calculations for requested features
@@ -621,8 +1158,599 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::load_nodes(
         }
     }
 
-  model.vertex_buffer.init(_device, _pool, _device->graphics_queue, vertex_data, Alloc);
-  model.index_buffer.init(_device, _pool, _device->graphics_queue, index_data, Alloc);
+  for (Primitive* primitive : all_primitives())
+    primitive->lods.push_back({primitive->firstIndex, primitive->indexCount, 0, 0.0f});
+
+  // optimized and simplified geometry and its meshlets are cached next to the model, keyed by
+  // its source files; the pre-calculations above run first since meshlet bounds depend on them
+  const uint32_t processing{flags
+                            & (FileLoadingFlags::OptimizeMeshes | FileLoadingFlags::GenerateLods
+                               | FileLoadingFlags::BuildMeshlets)};
+  if (processing)
+    {
+      const uint32_t cache_flags{
+          flags
+          & (processing | FileLoadingFlags::PreTransformVertices
+             | FileLoadingFlags::PreMultiplyVertexColors | FileLoadingFlags::FlipY)};
+      const std::filesystem::path directory{std::filesystem::path(_gltf_file).parent_path()};
+      std::vector<std::string> sources{_gltf_file};
+      for (const auto& buffer : _input.buffers)
+        {
+          if (!buffer.uri.empty() && buffer.uri.rfind("data:", 0) != 0)
+            sources.push_back((directory / buffer.uri).string());
+        }
+      const uint64_t stamp{MeshCache_Stamp(sources)};
+      const std::string cache_file{_gltf_file + ".meshcache"};
+
+      if (!stamp || !load_meshCache(cache_file, stamp, cache_flags, index_data, vertex_data))
+        {
+          if (flags & FileLoadingFlags::OptimizeMeshes)
+            {
+              optimize_meshes(index_data, vertex_data);
+            }
+          if (flags & FileLoadingFlags::GenerateLods)
+            {
+              generate_lods(index_data, vertex_data);
+            }
+          if (flags & FileLoadingFlags::BuildMeshlets)
+            {
+              build_meshlets(index_data, vertex_data);
+            }
+          if (stamp)
+            {
+              save_meshCache(cache_file, stamp, cache_flags, index_data, vertex_data);
+            }
+        }
+    }
+
+  // AtlasTextures: primitives of atlased materials sample their rect of the page
+  for (Primitive* primitive : all_primitives())
+    {
+      if (primitive->materialIndex < 0
+          || static_cast<size_t>(primitive->materialIndex) >= atlas.uv_transforms.size()
+          || !(primitive->components & GLTF_EngineModelVertexData::UV))
+        continue;
+      const glm::vec4 transform{atlas.uv_transforms[primitive->materialIndex]};
+      for (uint32_t i = 0; i < primitive->vertexCount; i++)
+        {
+          glm::vec2& uv{vertex_data[primitive->firstVertex + i].uv};
+          uv = uv * glm::vec2(transform) + glm::vec2(transform.z, transform.w);
+        }
+    }
+
+  // bounds of the geometry as drawn, LOD selection projects their radius
+  for (Primitive* primitive : all_primitives())
+    {
+      glm::vec3 min{FLT_MAX}, max{-FLT_MAX};
+      for (uint32_t i = 0; i < primitive->vertexCount; i++)
+        {
+          min = glm::min(min, vertex_data[primitive->firstVertex + i].pos);
+          max = glm::max(max, vertex_data[primitive->firstVertex + i].pos);
+        }
+      if (primitive->vertexCount)
+        Set_Dimensions(primitive->dimensions, min, max);
+    }
+
+  // texel density for texture streaming, the doubled areas cancel out
+  for (Primitive* primitive : all_primitives())
+    {
+      if (!(primitive->components & GLTF_EngineModelVertexData::UV))
+        continue;
+      double surface{}, uv_area{};
+      for (uint32_t i = 0; i + 2 < primitive->indexCount; i += 3)
+        {
+          const GLTF_EngineModelVertexData& a{vertex_data[index_data[primitive->firstIndex + i]]};
+          const GLTF_EngineModelVertexData& b{
+              vertex_data[index_data[primitive->firstIndex + i + 1]]};
+          const GLTF_EngineModelVertexData& c{
+              vertex_data[index_data[primitive->firstIndex + i + 2]]};
+          surface += glm::length(glm::cross(b.pos - a.pos, c.pos - a.pos));
+          const glm::vec2 u{b.uv - a.uv};
+          const glm::vec2 v{c.uv - a.uv};
+          uv_area += std::abs(u.x * v.y - u.y * v.x);
+        }
+      if (surface > 0.0)
+        primitive->uv_density = static_cast<float>(std::sqrt(uv_area / surface));
+    }
+
+  if (flags & FileLoadingFlags::CompactVertices)
+    {
+      load_compactVertices(_device, _pool, vertex_data);
+    }
+  else
+    {
+      model.vertex_buffer.init(_device, _pool, _device->graphics_queue, vertex_data, Alloc);
+    }
+  if (flags & FileLoadingFlags::CompactIndices)
+    {
+      load_packedIndices(_device, _pool, index_data);
+    }
+  else
+    {
+      model.index_buffer.init(_device, _pool, _device->graphics_queue, index_data, Alloc);
+    }
+}
+
+std::vector<SngoEngine::Core::Source::Model::Primitive*>
+SngoEngine::Core::Source::Model::EngineGltfModel::all_primitives()
+{
+  std::vector<Primitive*> primitives;
+  for (GltfNode* node : linear_nodes)
+    {
+      if (node->mesh)
+        {
+          for (Primitive& primitive : node->mesh->primitives)
+            primitives.push_back(&primitive);
+        }
+    }
+  return primitives;
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::optimize_meshes(
+    std::vector<uint32_t>& _indexbuffer,
+    std::vector<GLTF_EngineModelVertexData>& _vertexbuffer)
+{
+  const std::vector<Primitive*> primitives{all_primitives()};
+
+  // primitives own disjoint vertex and index ranges, so they are optimized independently
+  const auto start{std::chrono::steady_clock::now()};
+  std::vector<Utils::MeshOptimizeStats> stats(primitives.size());
+  Utils::Parallel_For(primitives.size(), [&](size_t begin, size_t end) {
+    std::vector<uint32_t> local;
+    for (size_t p = begin; p < end; p++)
+      {
+        const Primitive& primitive{*primitives[p]};
+        uint32_t* indices{&_indexbuffer[primitive.firstIndex]};
+        local.assign(indices, indices + primitive.indexCount);
+        for (uint32_t& index : local)
+          index -= primitive.firstVertex;
+
+        stats[p] = Utils::Optimize_Mesh(&_vertexbuffer[primitive.firstVertex],
+                                        primitive.vertexCount,
+                                        local.data(),
+                                        local.size() - local.size() % 3);
+        for (uint32_t i = 0; i < primitive.indexCount; i++)
+          indices[i] = local[i] + primitive.firstVertex;
+      }
+  });
+
+  Utils::MeshOptimizeStats total{};
+  for (const auto& stat : stats)
+    total.accumulate(stat);
+  total.ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                 .count();
+  total.print("gltf mesh optimize");
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::build_meshlets(
+    std::vector<uint32_t>& _indexbuffer,
+    const std::vector<GLTF_EngineModelVertexData>& _vertexbuffer)
+{
+  const std::vector<Primitive*> primitives{all_primitives()};
+
+  const auto start{std::chrono::steady_clock::now()};
+  // one list per level of every primitive, coarser levels get their own meshlets
+  std::vector<std::vector<std::vector<Utils::Meshlet>>> built(primitives.size());
+  Utils::Parallel_For(primitives.size(), [&](size_t begin, size_t end) {
+    std::vector<uint32_t> local;
+    std::vector<float> positions, normals;
+    for (size_t p = begin; p < end; p++)
+      {
+        const Primitive& primitive{*primitives[p]};
+        positions.resize(size_t{primitive.vertexCount} * 3);
+        normals.resize(size_t{primitive.vertexCount} * 3);
+        for (uint32_t v = 0; v < primitive.vertexCount; v++)
+          {
+            const GLTF_EngineModelVertexData& vertex{_vertexbuffer[primitive.firstVertex + v]};
+            for (int k = 0; k < 3; k++)
+              {
+                positions[3 * v + k] = vertex.pos[k];
+                normals[3 * v + k] = vertex.normal[k];
+              }
+          }
+
+        built[p].resize(primitive.lods.size());
+        for (size_t l = 0; l < primitive.lods.size(); l++)
+          {
+            const Primitive::Lod& lod{primitive.lods[l]};
+            uint32_t* indices{&_indexbuffer[lod.firstIndex]};
+            local.assign(indices, indices + lod.indexCount);
+            for (uint32_t& index : local)
+              index -= primitive.firstVertex;
+
+            // reorders the level's range in place, the other levels stay untouched
+            built[p][l] = Utils::Build_Meshlets(local.data(),
+                                                local.size(),
+                                                positions.data(),
+                                                normals.data(),
+                                                primitive.vertexCount);
+            for (size_t i = 0; i < local.size(); i++)
+              indices[i] = local[i] + primitive.firstVertex;
+          }
+      }
+  });
+
+  meshlets.clear();
+  size_t triangles{0};
+  for (size_t p = 0; p < primitives.size(); p++)
+    {
+      for (size_t l = 0; l < built[p].size(); l++)
+        {
+          Primitive::Lod& lod{primitives[p]->lods[l]};
+          lod.firstMeshlet = static_cast<uint32_t>(meshlets.size());
+          lod.meshletCount = static_cast<uint32_t>(built[p][l].size());
+          meshlets.insert(meshlets.end(), built[p][l].begin(), built[p][l].end());
+          triangles += lod.indexCount / 3;
+        }
+    }
+
+  fmt::println("gltf meshlets: {} meshlets over {} triangles ({:.1f} per meshlet), {:.2f} ms",
+               meshlets.size(),
+               triangles,
+               meshlets.empty() ? 0.0 : static_cast<double>(triangles) / meshlets.size(),
+               std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                   .count());
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::generate_lods(
+    std::vector<uint32_t>& _indexbuffer,
+    const std::vector<GLTF_EngineModelVertexData>& _vertexbuffer)
+{
+  const std::vector<Primitive*> primitives{all_primitives()};
+
+  const auto start{std::chrono::steady_clock::now()};
+  std::vector<std::vector<Utils::MeshLod>> chains(primitives.size());
+  Utils::Parallel_For(primitives.size(), [&](size_t begin, size_t end) {
+    std::vector<uint32_t> local;
+    std::vector<float> positions, attributes;
+    for (size_t p = begin; p < end; p++)
+      {
+        const Primitive& primitive{*primitives[p]};
+        const GLTF_EngineModelVertexData* vertices{&_vertexbuffer[primitive.firstVertex]};
+
+        local.assign(&_indexbuffer[primitive.firstIndex],
+                     &_indexbuffer[primitive.firstIndex] + primitive.indexCount);
+        for (uint32_t& index : local)
+          index -= primitive.firstVertex;
+
+        glm::vec3 min{FLT_MAX}, max{-FLT_MAX};
+        positions.resize(size_t{primitive.vertexCount} * 3);
+        for (uint32_t v = 0; v < primitive.vertexCount; v++)
+          {
+            min = glm::min(min, vertices[v].pos);
+            max = glm::max(max, vertices[v].pos);
+            positions[3 * v + 0] = vertices[v].pos.x;
+            positions[3 * v + 1] = vertices[v].pos.y;
+            positions[3 * v + 2] = vertices[v].pos.z;
+          }
+
+        // a normal flip or a full uv wrap costs as much as moving 2% of the primitive's extent
+        const float weight{0.02f * glm::distance(min, max)};
+        attributes.resize(size_t{primitive.vertexCount} * 5);
+        for (uint32_t v = 0; v < primitive.vertexCount; v++)
+          {
+            attributes[5 * v + 0] = vertices[v].normal.x * weight;
+            attributes[5 * v + 1] = vertices[v].normal.y * weight;
+            attributes[5 * v + 2] = vertices[v].normal.z * weight;
+            attributes[5 * v + 3] = vertices[v].uv.x * weight;
+            attributes[5 * v + 4] = vertices[v].uv.y * weight;
+          }
+
+        chains[p] = Utils::Build_LodChain(local.data(),
+                                          local.size(),
+                                          positions.data(),
+                                          attributes.data(),
+                                          5,
+                                          primitive.vertexCount);
+      }
+  });
+
+  size_t triangles{0}, lod_triangles{0}, levels{0};
+  for (size_t p = 0; p < primitives.size(); p++)
+    {
+      Primitive& primitive{*primitives[p]};
+      primitive.lods = {{primitive.firstIndex, primitive.indexCount, 0, 0.0f}};
+      triangles += primitive.indexCount / 3;
+      for (const Utils::MeshLod& lod : chains[p])
+        {
+          primitive.lods.push_back({static_cast<uint32_t>(_indexbuffer.size()),
+                                    static_cast<uint32_t>(lod.indices.size()),
+                                    0,
+                                    lod.error});
+          for (uint32_t index : lod.indices)
+            _indexbuffer.push_back(index + primitive.firstVertex);
+          lod_triangles += lod.indices.size() / 3;
+          levels++;
+        }
+    }
+
+  fmt::println("gltf lod chain: {} primitives, {} levels, {} + {} triangles, {:.2f} ms",
+               primitives.size(),
+               levels,
+               triangles,
+               lod_triangles,
+               std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+                   .count());
+}
+
+bool SngoEngine::Core::Source::Model::EngineGltfModel::load_meshCache(
+    const std::string& _cache_file,
+    uint64_t _stamp,
+    uint32_t _flags,
+    std::vector<uint32_t>& _indexbuffer,
+    std::vector<GLTF_EngineModelVertexData>& _vertexbuffer)
+{
+  MeshCacheData cache{};
+  if (!Read_MeshCache(_cache_file, cache) || cache.stamp != _stamp || cache.flags != _flags
+      || cache.vertex_stride != sizeof(GLTF_EngineModelVertexData)
+      || cache.vertices.size() != _vertexbuffer.size() * sizeof(GLTF_EngineModelVertexData))
+    return false;
+
+  // the node walk is deterministic, so primitives must line up one to one
+  const std::vector<Primitive*> primitives{all_primitives()};
+  if (cache.primitives.size() != primitives.size())
+    return false;
+  for (size_t p = 0; p < primitives.size(); p++)
+    {
+      const MeshCachePrimitive& cached{cache.primitives[p]};
+      const Primitive& primitive{*primitives[p]};
+      if (cached.firstIndex != primitive.firstIndex || cached.indexCount != primitive.indexCount
+          || cached.firstVertex != primitive.firstVertex
+          || cached.vertexCount != primitive.vertexCount)
+        return false;
+      for (const MeshCacheLod& lod : cached.lods)
+        {
+          if (size_t{lod.firstIndex} + lod.indexCount > cache.indices.size()
+              || size_t{lod.firstMeshlet} + lod.meshletCount > cache.meshlets.size())
+            return false;
+        }
+    }
+
+  std::memcpy(_vertexbuffer.data(), cache.vertices.data(), cache.vertices.size());
+  _indexbuffer = std::move(cache.indices);
+  meshlets = std::move(cache.meshlets);
+  for (size_t p = 0; p < primitives.size(); p++)
+    {
+      primitives[p]->lods.clear();
+      for (const MeshCacheLod& lod : cache.primitives[p].lods)
+        {
+          primitives[p]->lods.push_back(
+              {lod.firstIndex, lod.indexCount, 0, lod.error, lod.firstMeshlet, lod.meshletCount});
+        }
+    }
+  fmt::println("mesh cache: loaded {}", _cache_file);
+  return true;
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::save_meshCache(
+    const std::string& _cache_file,
+    uint64_t _stamp,
+    uint32_t _flags,
+    const std::vector<uint32_t>& _indexbuffer,
+    const std::vector<GLTF_EngineModelVertexData>& _vertexbuffer)
+{
+  MeshCacheData cache{};
+  cache.stamp = _stamp;
+  cache.flags = _flags;
+  cache.vertex_stride = sizeof(GLTF_EngineModelVertexData);
+  cache.vertices.resize(_vertexbuffer.size() * sizeof(GLTF_EngineModelVertexData));
+  std::memcpy(cache.vertices.data(), _vertexbuffer.data(), cache.vertices.size());
+  cache.indices = _indexbuffer;
+  for (const Primitive* primitive : all_primitives())
+    {
+      MeshCachePrimitive cached{primitive->firstIndex,
+                                primitive->indexCount,
+                                primitive->firstVertex,
+                                primitive->vertexCount,
+                                {}};
+      for (const Primitive::Lod& lod : primitive->lods)
+        {
+          cached.lods.push_back(
+              {lod.firstIndex, lod.indexCount, lod.error, lod.firstMeshlet, lod.meshletCount});
+        }
+      cache.primitives.push_back(std::move(cached));
+    }
+  cache.meshlets = meshlets;
+  Write_MeshCache(_cache_file, cache);
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::update_uniforms(uint32_t frame_index)
+{
+  frame_uniforms.begin_frame(frame_index);
+  for (auto node : nodes)
+    {
+      node->update(frame_uniforms);
+    }
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::set_lodView(const glm::mat4& view_model,
+                                                                   const glm::mat4& projection,
+                                                                   float viewport_height)
+{
+  lod_view.view_model = view_model;
+  // flipped projections negate [1][1]
+  lod_view.proj_scale = std::abs(projection[1][1]);
+  lod_view.viewport_height = viewport_height;
+  lod_view.enabled = true;
+}
+
+uint32_t SngoEngine::Core::Source::Model::EngineGltfModel::select_lod(
+    const Primitive& primitive,
+    const glm::mat4& node_matrix) const
+{
+  if (!lod_view.enabled || primitive.lods.size() <= 1)
+    return 0;
+
+  const glm::mat4 m{lod_view.view_model * node_matrix};
+  const glm::vec3 center{m * glm::vec4(primitive.dimensions.center, 1.0f)};
+  const float scale{std::max({glm::length(glm::vec3(m[0])),
+                              glm::length(glm::vec3(m[1])),
+                              glm::length(glm::vec3(m[2]))})};
+  const float radius{primitive.dimensions.radius * scale};
+  const float distance{glm::length(center)};
+  if (distance <= radius)
+    return 0;
+
+  const float pixels{radius / distance * lod_view.proj_scale * lod_view.viewport_height * 0.5f};
+  if (pixels >= lod_view.lod_pixels)
+    return 0;
+  const auto level{
+      static_cast<uint32_t>(std::log2(lod_view.lod_pixels / std::max(pixels, 1e-3f)))};
+  return std::min(level, static_cast<uint32_t>(primitive.lods.size() - 1));
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::load_compactVertices(
+    const Device::LogicalDevice::EngineDevice* _device,
+    VkCommandPool _pool,
+    const std::vector<GLTF_EngineModelVertexData>& _vertexbuffer)
+{
+  compact.regions.clear();
+  const std::vector<Primitive*> primitives{all_primitives()};
+
+  // one region per distinct layout, primitives are packed back to back inside their region
+  for (Primitive* primitive : primitives)
+    {
+      bool wide_joints{false};
+      if (primitive->components & GLTF_EngineModelVertexData::JOINT0)
+        {
+          for (uint32_t i = 0; i < primitive->vertexCount; i++)
+            {
+              const glm::vec4& joint{_vertexbuffer[primitive->firstVertex + i].joint0};
+              wide_joints |= glm::any(glm::greaterThan(joint, glm::vec4(255.0f)));
+            }
+        }
+      const auto layout{CompactVertexLayout::From_Components(
+          primitive->components | compact_components, wide_joints)};
+
+      auto region{std::find_if(compact.regions.begin(),
+                               compact.regions.end(),
+                               [&](const CompactRegion& r) { return r.layout == layout; })};
+      if (region == compact.regions.end())
+        {
+          compact.regions.push_back({layout, 0, 0});
+          region = compact.regions.end() - 1;
+        }
+      primitive->compact_region = static_cast<int32_t>(region - compact.regions.begin());
+      primitive->compact_vertexOffset =
+          static_cast<int32_t>(region->vertex_count) - static_cast<int32_t>(primitive->firstVertex);
+      region->vertex_count += primitive->vertexCount;
+    }
+
+  compact.bytes = 0;
+  for (CompactRegion& region : compact.regions)
+    {
+      // keep every region start aligned for the widest attribute format
+      region.offset = (compact.bytes + 15) & ~VkDeviceSize{15};
+      compact.bytes = region.offset + VkDeviceSize{region.layout.stride} * region.vertex_count;
+    }
+  compact.full_bytes = sizeof(GLTF_EngineModelVertexData) * _vertexbuffer.size();
+  if (compact.bytes == 0)
+    return;
+
+  std::vector<std::byte> packed(compact.bytes);
+  for (const Primitive* primitive : primitives)
+    {
+      const CompactRegion& region{compact.regions[primitive->compact_region]};
+      const auto first{static_cast<VkDeviceSize>(
+          static_cast<int64_t>(primitive->firstVertex) + primitive->compact_vertexOffset)};
+      Encode_CompactVertices(region.layout,
+                             &_vertexbuffer[primitive->firstVertex],
+                             primitive->vertexCount,
+                             &packed[region.offset + first * region.layout.stride]);
+    }
+
+  Buffer::Upload_DeviceLocal(_device,
+                             _pool,
+                             _device->graphics_queue,
+                             packed.data(),
+                             compact.bytes,
+                             VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+                             compact.vertex_buffer,
+                             Alloc);
+
+  fmt::println("compact vertices: {} regions, {} -> {} bytes ({:.2f}x smaller)",
+               compact.regions.size(),
+               compact.full_bytes,
+               compact.bytes,
+               static_cast<double>(compact.full_bytes) / static_cast<double>(compact.bytes));
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::load_packedIndices(
+    const Device::LogicalDevice::EngineDevice* _device,
+    VkCommandPool _pool,
+    const std::vector<uint32_t>& _indexbuffer)
+{
+  const std::vector<Primitive*> primitives{all_primitives()};
+
+  uint32_t count32{0}, count16{0};
+  for (Primitive* primitive : primitives)
+    {
+      // relative indices of a primitive with at most 65536 vertices fit 16 bits
+      const bool narrow{primitive->vertexCount <= 0x10000u};
+      uint32_t& count{narrow ? count16 : count32};
+      primitive->indexType = narrow ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+      primitive->packed_firstIndex = count;
+      count += primitive->indexCount;
+      // every level of detail gets its own region of the same width
+      for (Primitive::Lod& lod : primitive->lods)
+        {
+          if (lod.firstIndex == primitive->firstIndex)
+            {
+              lod.packed_firstIndex = primitive->packed_firstIndex;
+              continue;
+            }
+          lod.packed_firstIndex = count;
+          count += lod.indexCount;
+        }
+    }
+
+  packed_indices.uint16_offset = VkDeviceSize{count32} * sizeof(uint32_t);
+  packed_indices.bytes = packed_indices.uint16_offset + VkDeviceSize{count16} * sizeof(uint16_t);
+  packed_indices.full_bytes = _indexbuffer.size() * sizeof(uint32_t);
+  if (packed_indices.bytes == 0)
+    return;
+
+  std::vector<std::byte> packed(packed_indices.bytes);
+  auto* indices32{reinterpret_cast<uint32_t*>(packed.data())};
+  auto* indices16{reinterpret_cast<uint16_t*>(packed.data() + packed_indices.uint16_offset)};
+  auto pack = [&](const Primitive& primitive, uint32_t first, uint32_t count, uint32_t packed) {
+    const uint32_t* src{&_indexbuffer[first]};
+    for (uint32_t i = 0; i < count; i++)
+      {
+        const uint32_t relative{src[i] - primitive.firstVertex};
+        if (primitive.indexType == VK_INDEX_TYPE_UINT16)
+          indices16[packed + i] = static_cast<uint16_t>(relative);
+        else
+          indices32[packed + i] = relative;
+      }
+  };
+  for (const Primitive* primitive : primitives)
+    {
+      pack(*primitive,
+           primitive->firstIndex,
+           primitive->indexCount,
+           primitive->packed_firstIndex);
+      for (const Primitive::Lod& lod : primitive->lods)
+        {
+          if (lod.firstIndex != primitive->firstIndex)
+            pack(*primitive, lod.firstIndex, lod.indexCount, lod.packed_firstIndex);
+        }
+    }
+
+  Buffer::Upload_DeviceLocal(_device,
+                             _pool,
+                             _device->graphics_queue,
+                             packed.data(),
+                             packed_indices.bytes,
+                             VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+                             packed_indices.buffer,
+                             Alloc);
+
+  fmt::println("compact indices: {} uint16 + {} uint32, {} -> {} bytes",
+               count16,
+               count32,
+               packed_indices.full_bytes,
+               packed_indices.bytes);
 }
 
 void SngoEngine::Core::Source::Model::EngineGltfModel::load_skins(tinygltf::Model& input)
@@ -645,6 +1773,24 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::load_materials(tinygltf::
 
   gltf_LoadMaterial(input, imgs, materials);
   materials.emplace_back(device);
+
+  // atlased images are sampled from their page
+  for (auto& material : materials)
+    {
+      for (GltfTexture* texture : {&material.base_color,
+                                   &material.metallic_roughness,
+                                   &material.normal,
+                                   &material.occlusion,
+                                   &material.emissive})
+        {
+          if (texture->img_index < atlas.redirects.size()
+              && atlas.redirects[texture->img_index] != UINT32_MAX)
+            {
+              const uint32_t page{atlas.redirects[texture->img_index]};
+              *texture = {page, &imgs[page]};
+            }
+        }
+    }
 }
 
 void SngoEngine::Core::Source::Model::EngineGltfModel::get_sceneDimensions(
@@ -666,15 +1812,32 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::drawNode(VkCommandBuffer
                                                                 GltfNode* node,
                                                                 uint32_t bindImage_set,
                                                                 uint32_t renderFlags,
-                                                                uint32_t frame_index)
+                                                                uint32_t frame_index,
+                                                                int32_t compact_region,
+                                                                bool use_meshlets)
 {
   if (node->mesh)
     {
+      if (renderFlags & RenderFlags::BindMeshUniforms)
+        {
+          vkCmdBindDescriptorSets(commandBuffer,
+                                  VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                  pipelineLayout,
+                                  layouts.matrices_set,
+                                  1,
+                                  &uniform_set.descriptor_set,
+                                  1,
+                                  &node->mesh->dynamic_offset);
+        }
       // Pass the node's matrix via push constants
       // Traverse the node hierarchy to the top-most parent to get the final matrix of the current
       // node
       for (Primitive& primitive : node->mesh->primitives)
         {
+          if (compact_region >= 0 && primitive.compact_region != compact_region)
+            {
+              continue;
+            }
           bool skip = false;
           const GltfMaterial* material = primitive.material;
           if (renderFlags & RenderFlags::RenderOpaqueNodes)
@@ -692,7 +1855,8 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::drawNode(VkCommandBuffer
           // Get the texture index for this primitive
           if (!skip)
             {
-              if (renderFlags & RenderFlags::BindImages && material->base_color.is_available())
+              if (!bindless.enabled && renderFlags & RenderFlags::BindImages
+                  && material->base_color.is_available())
                 {
                   // fmt::println("draw img");
                   vkCmdBindDescriptorSets(commandBuffer,
@@ -704,13 +1868,73 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::drawNode(VkCommandBuffer
                                           0,
                                           nullptr);
                 }
-              vkCmdDrawIndexed(commandBuffer, primitive.indexCount, 1, primitive.firstIndex, 0, 0);
+              // pretransformed vertices are already in model space
+              const glm::mat4 node_matrix{(loading_flags & FileLoadingFlags::PreTransformVertices)
+                                              ? glm::mat4(1.0f)
+                                              : node->getMatrix()};
+              const uint32_t level{primitive.lods.empty() ? 0 : select_lod(primitive, node_matrix)};
+              const Primitive::Lod lod{
+                  primitive.lods.empty()
+                      ? Primitive::Lod{primitive.firstIndex, primitive.indexCount, 0, 0.0f}
+                      : primitive.lods[level]};
+
+              int32_t vertexOffset{compact_region >= 0 ? primitive.compact_vertexOffset : 0};
+              uint32_t firstIndex{lod.firstIndex};
+              if (packed_indices.buffer.buffer != VK_NULL_HANDLE)
+                {
+                  if (primitive.indexType != bound_indexType)
+                    {
+                      vkCmdBindIndexBuffer(commandBuffer,
+                                           packed_indices.buffer.buffer,
+                                           primitive.indexType == VK_INDEX_TYPE_UINT16
+                                               ? packed_indices.uint16_offset
+                                               : 0,
+                                           primitive.indexType);
+                      bound_indexType = primitive.indexType;
+                    }
+                  vertexOffset += static_cast<int32_t>(primitive.firstVertex);
+                  firstIndex = primitive.lods.empty() ? primitive.packed_firstIndex
+                                                      : lod.packed_firstIndex;
+                }
+              // bindless shaders fetch the material through gl_InstanceIndex
+              const uint32_t firstInstance{
+                  bindless.enabled ? static_cast<uint32_t>(std::max(primitive.materialIndex, 0))
+                                   : 0};
+              // commands of the level cull_meshlets picked, a level change since is drawn whole
+              if (use_meshlets && lod.meshletCount && level == primitive.drawLevel)
+                {
+                  // cull_meshlets resolved the packed offsets, only a compact region shift is left
+                  const int32_t shift{compact_region >= 0 ? primitive.compact_vertexOffset : 0};
+                  for (uint32_t d = 0; d < primitive.drawCount; d++)
+                    {
+                      const VkDrawIndexedIndirectCommand& command{
+                          meshlet_draws.commands[primitive.firstDraw + d]};
+                      vkCmdDrawIndexed(commandBuffer,
+                                       command.indexCount,
+                                       1,
+                                       command.firstIndex,
+                                       command.vertexOffset + shift,
+                                       firstInstance);
+                    }
+                }
+              else
+                {
+                  vkCmdDrawIndexed(
+                      commandBuffer, lod.indexCount, 1, firstIndex, vertexOffset, firstInstance);
+                }
             }
         }
     }
   for (auto& child : node->children)
     {
-      drawNode(commandBuffer, pipelineLayout, child, bindImage_set, renderFlags, frame_index);
+      drawNode(commandBuffer,
+               pipelineLayout,
+               child,
+               bindImage_set,
+               renderFlags,
+               frame_index,
+               compact_region,
+               use_meshlets);
     }
 }
 
@@ -722,12 +1946,482 @@ void SngoEngine::Core::Source::Model::EngineGltfModel::draw(VkCommandBuffer comm
 {
   // must bind all buffer in this struct first
   // Render all nodes at top-level
+  bound_indexType = VK_INDEX_TYPE_MAX_ENUM;
   for (auto& node : nodes)
     {
       drawNode(command_buffer, pipeline_layout, node, bindImage_set, renderFlags, frame_index);
     }
 }
 
+void SngoEngine::Core::Source::Model::EngineGltfModel::draw_compact(
+    VkCommandBuffer command_buffer,
+    VkPipelineLayout pipeline_layout,
+    uint32_t region,
+    uint32_t bindImage_set,
+    uint32_t renderFlags,
+    uint32_t frame_index)
+{
+  // bind_compactBuffers(command_buffer, region) first
+  bound_indexType = VK_INDEX_TYPE_MAX_ENUM;
+  for (auto& node : nodes)
+    {
+      drawNode(command_buffer,
+               pipeline_layout,
+               node,
+               bindImage_set,
+               renderFlags,
+               frame_index,
+               static_cast<int32_t>(region));
+    }
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::cull_meshlets(const glm::mat4& view_model,
+                                                                     const glm::mat4& projection)
+{
+  meshlet_draws.commands.clear();
+  meshlet_draws.visible = 0;
+  meshlet_draws.frustum_culled = 0;
+  meshlet_draws.backface_culled = 0;
+
+  const bool packed{packed_indices.buffer.buffer != VK_NULL_HANDLE};
+  for (GltfNode* node : linear_nodes)
+    {
+      if (!node->mesh)
+        continue;
+
+      // planes and camera are moved into the space the meshlet bounds live in
+      const glm::mat4 node_matrix{(loading_flags & FileLoadingFlags::PreTransformVertices)
+                                      ? glm::mat4(1.0f)
+                                      : node->getMatrix()};
+      const glm::mat4 view_node{view_model * node_matrix};
+      const glm::mat4 clip{projection * view_node};
+      float planes[6][4];
+      Utils::Extract_FrustumPlanes(glm::value_ptr(clip), planes);
+      const glm::vec3 camera{glm::inverse(view_node)[3]};
+
+      for (Primitive& primitive : node->mesh->primitives)
+        {
+          primitive.firstDraw = static_cast<uint32_t>(meshlet_draws.commands.size());
+          primitive.drawCount = 0;
+          primitive.drawLevel = select_lod(primitive, node_matrix);
+          if (primitive.lods.empty())
+            continue;
+
+          const Primitive::Lod& lod{primitive.lods[primitive.drawLevel]};
+          const uint32_t base_index{packed ? lod.packed_firstIndex : lod.firstIndex};
+          const int32_t vertexOffset{packed ? static_cast<int32_t>(primitive.firstVertex) : 0};
+          for (uint32_t m = 0; m < lod.meshletCount; m++)
+            {
+              const Utils::Meshlet& meshlet{meshlets[lod.firstMeshlet + m]};
+              if (!Utils::Meshlet_InFrustum(meshlet, planes))
+                {
+                  meshlet_draws.frustum_culled++;
+                  continue;
+                }
+              if (Utils::Meshlet_Backfacing(meshlet, glm::value_ptr(camera)))
+                {
+                  meshlet_draws.backface_culled++;
+                  continue;
+                }
+              meshlet_draws.visible++;
+
+              const uint32_t firstIndex{base_index + meshlet.triangle_offset * 3};
+              if (primitive.drawCount)
+                {
+                  auto& last{meshlet_draws.commands.back()};
+                  if (last.firstIndex + last.indexCount == firstIndex)
+                    {
+                      last.indexCount += meshlet.triangle_count * 3;
+                      continue;
+                    }
+                }
+              meshlet_draws.commands.push_back(
+                  {meshlet.triangle_count * 3, 1, firstIndex, vertexOffset, 0});
+              primitive.drawCount++;
+            }
+        }
+    }
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::draw_meshlets(
+    VkCommandBuffer command_buffer,
+    VkPipelineLayout pipeline_layout,
+    uint32_t bindImage_set,
+    uint32_t renderFlags,
+    uint32_t frame_index)
+{
+  // cull_meshlets first, primitives without meshlets are drawn whole
+  bound_indexType = VK_INDEX_TYPE_MAX_ENUM;
+  for (auto& node : nodes)
+    {
+      drawNode(command_buffer,
+               pipeline_layout,
+               node,
+               bindImage_set,
+               renderFlags,
+               frame_index,
+               -1,
+               true);
+    }
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::load_indirect()
+{
+  // one record per primitive, at most one command per meshlet of its largest level (neighbours
+  // merge into fewer)
+  indirect.draw_capacity = 0;
+  indirect.command_capacity = 0;
+  for (const Primitive* primitive : all_primitives())
+    {
+      uint32_t commands{1};
+      for (const Primitive::Lod& lod : primitive->lods)
+        commands = std::max(commands, lod.meshletCount);
+      indirect.draw_capacity++;
+      indirect.command_capacity += commands;
+    }
+  if (indirect.draw_capacity == 0)
+    return;
+
+  layouts.draws.init(device,
+                     std::vector<VkDescriptorSetLayoutBinding>{Descriptor::GetLayoutBinding(
+                         VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                         VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
+                         0)},
+                     Alloc);
+  indirect.sets.init(device, &layouts.draws, &descriptor_pool, Macro::MAX_FRAMES_IN_FLIGHT);
+
+  const VkDeviceSize command_bytes{VkDeviceSize{indirect.command_capacity}
+                                   * sizeof(VkDrawIndexedIndirectCommand)};
+  const VkDeviceSize draw_bytes{VkDeviceSize{indirect.draw_capacity} * sizeof(IndirectDrawData)};
+  std::vector<VkDescriptorBufferInfo> infos(Macro::MAX_FRAMES_IN_FLIGHT);
+  std::vector<VkWriteDescriptorSet> writes;
+  for (int i = 0; i < Macro::MAX_FRAMES_IN_FLIGHT; i++)
+    {
+      IndirectFrame& frame{indirect.frames[i]};
+      // host-coherent and mapped for the model's lifetime, rewritten every frame
+      const VkMemoryPropertyFlags host{VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+                                       | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+      frame.commands.init(
+          device,
+          Data::BufferCreate_Info{command_bytes, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT},
+          host,
+          Alloc);
+      frame.draws.init(device,
+                       Data::BufferCreate_Info{draw_bytes, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT},
+                       host,
+                       Alloc);
+      void* mapped{};
+      vkMapMemory(
+          device->logical_device, frame.commands.buffer_memory, 0, command_bytes, 0, &mapped);
+      frame.mapped_commands = static_cast<VkDrawIndexedIndirectCommand*>(mapped);
+      vkMapMemory(device->logical_device, frame.draws.buffer_memory, 0, draw_bytes, 0, &mapped);
+      frame.mapped_draws = static_cast<IndirectDrawData*>(mapped);
+
+      infos[i] = Descriptor::GetDescriptor_BufferInfo(frame.draws.buffer, draw_bytes);
+      writes.push_back(Descriptor::GetDescriptSet_Write(
+          indirect.sets[i], VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &infos[i])[0]);
+    }
+  indirect.sets.updateWrite(writes);
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::update_indirect(
+    uint32_t frame_index,
+    const glm::mat4& view_model,
+    const glm::mat4& projection)
+{
+  IndirectFrame& frame{indirect.frames[frame_index % Macro::MAX_FRAMES_IN_FLIGHT]};
+  frame.batches.clear();
+  frame.command_count = 0;
+  frame.draw_count = 0;
+  if (!frame.mapped_commands)
+    return;
+
+  if (!meshlets.empty())
+    cull_meshlets(view_model, projection);
+
+  struct Pending
+  {
+    IndirectBatch key;
+    VkDrawIndexedIndirectCommand command;
+  };
+  std::vector<Pending> pending;
+  pending.reserve(indirect.command_capacity);
+
+  const bool packed{packed_indices.buffer.buffer != VK_NULL_HANDLE};
+  for (GltfNode* node : linear_nodes)
+    {
+      if (!node->mesh)
+        continue;
+
+      const glm::mat4 node_matrix{(loading_flags & FileLoadingFlags::PreTransformVertices)
+                                      ? glm::mat4(1.0f)
+                                      : node->getMatrix()};
+      float planes[6][4];
+      Utils::Extract_FrustumPlanes(glm::value_ptr(projection * view_model * node_matrix), planes);
+
+      for (Primitive& primitive : node->mesh->primitives)
+        {
+          if (primitive.indexCount == 0
+              || !Utils::Sphere_InFrustum(glm::value_ptr(primitive.dimensions.center),
+                                          primitive.dimensions.radius,
+                                          planes))
+            continue;
+
+          const uint32_t draw{frame.draw_count++};
+          frame.mapped_draws[draw] = IndirectDrawData{
+              node_matrix, static_cast<uint32_t>(std::max(primitive.materialIndex, 0)), {}};
+
+          const IndirectBatch key{primitive.material ? primitive.material->alphaMode
+                                                     : GltfMaterial::ALPHAMODE_OPAQUE,
+                                  primitive.compact_region,
+                                  packed ? primitive.indexType : VK_INDEX_TYPE_UINT32,
+                                  0,
+                                  0};
+          const int32_t shift{primitive.compact_region >= 0 ? primitive.compact_vertexOffset : 0};
+          const uint32_t level{primitive.lods.empty() ? 0 : select_lod(primitive, node_matrix)};
+          const Primitive::Lod lod{
+              primitive.lods.empty()
+                  ? Primitive::Lod{primitive.firstIndex, primitive.indexCount, 0, 0.0f}
+                  : primitive.lods[level]};
+          if (lod.meshletCount && level == primitive.drawLevel)
+            {
+              for (uint32_t d = 0; d < primitive.drawCount; d++)
+                {
+                  VkDrawIndexedIndirectCommand command{
+                      meshlet_draws.commands[primitive.firstDraw + d]};
+                  command.vertexOffset += shift;
+                  command.firstInstance = draw;
+                  pending.push_back({key, command});
+                }
+              continue;
+            }
+
+          uint32_t firstIndex{lod.firstIndex};
+          if (packed)
+            {
+              firstIndex =
+                  primitive.lods.empty() ? primitive.packed_firstIndex : lod.packed_firstIndex;
+            }
+          const int32_t vertexOffset{(packed ? static_cast<int32_t>(primitive.firstVertex) : 0)
+                                     + shift};
+          pending.push_back({key, {lod.indexCount, 1, firstIndex, vertexOffset, draw}});
+        }
+    }
+
+  // one contiguous run per batch key, each becomes a single multi-draw
+  std::stable_sort(pending.begin(), pending.end(), [](const Pending& l, const Pending& r) {
+    return std::tie(l.key.alphaMode, l.key.compact_region, l.key.indexType)
+           < std::tie(r.key.alphaMode, r.key.compact_region, r.key.indexType);
+  });
+  for (const Pending& p : pending)
+    {
+      if (frame.batches.empty() || frame.batches.back().alphaMode != p.key.alphaMode
+          || frame.batches.back().compact_region != p.key.compact_region
+          || frame.batches.back().indexType != p.key.indexType)
+        {
+          IndirectBatch batch{p.key};
+          batch.firstCommand = frame.command_count;
+          frame.batches.push_back(batch);
+        }
+      frame.mapped_commands[frame.command_count++] = p.command;
+      frame.batches.back().commandCount++;
+    }
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::draw_indirect(
+    VkCommandBuffer command_buffer,
+    VkPipelineLayout pipeline_layout,
+    uint32_t frame_index,
+    uint32_t draw_set,
+    uint32_t renderFlags,
+    int32_t compact_region)
+{
+  IndirectFrame& frame{indirect.frames[frame_index % Macro::MAX_FRAMES_IN_FLIGHT]};
+  if (frame.batches.empty())
+    return;
+
+  vkCmdBindDescriptorSets(command_buffer,
+                          VK_PIPELINE_BIND_POINT_GRAPHICS,
+                          pipeline_layout,
+                          draw_set,
+                          1,
+                          &indirect.sets[frame_index % Macro::MAX_FRAMES_IN_FLIGHT],
+                          0,
+                          nullptr);
+
+  const VkPhysicalDeviceFeatures& features{device->pPD->enabled_features};
+  const uint32_t max_draws{features.multiDrawIndirect
+                               ? device->pPD->properties.limits.maxDrawIndirectCount
+                               : 1u};
+  const uint32_t alpha_filter{
+      renderFlags
+      & (RenderOpaqueNodes | RenderAlphaMaskedNodes | RenderAlphaBlendedNodes)};
+  const uint32_t stride{sizeof(VkDrawIndexedIndirectCommand)};
+
+  bound_indexType = VK_INDEX_TYPE_MAX_ENUM;
+  for (const IndirectBatch& batch : frame.batches)
+    {
+      const uint32_t mode_flag{batch.alphaMode == GltfMaterial::ALPHAMODE_OPAQUE
+                                   ? RenderOpaqueNodes
+                               : batch.alphaMode == GltfMaterial::ALPHAMODE_MASK
+                                   ? RenderAlphaMaskedNodes
+                                   : RenderAlphaBlendedNodes};
+      if (batch.compact_region != compact_region || (alpha_filter && !(alpha_filter & mode_flag)))
+        continue;
+
+      if (packed_indices.buffer.buffer != VK_NULL_HANDLE && batch.indexType != bound_indexType)
+        {
+          vkCmdBindIndexBuffer(
+              command_buffer,
+              packed_indices.buffer.buffer,
+              batch.indexType == VK_INDEX_TYPE_UINT16 ? packed_indices.uint16_offset : 0,
+              batch.indexType);
+          bound_indexType = batch.indexType;
+        }
+
+      if (!features.drawIndirectFirstInstance)
+        {
+          // firstInstance has to stay 0 in indirect commands here, record them directly instead
+          for (uint32_t c = 0; c < batch.commandCount; c++)
+            {
+              const VkDrawIndexedIndirectCommand& command{
+                  frame.mapped_commands[batch.firstCommand + c]};
+              vkCmdDrawIndexed(command_buffer,
+                               command.indexCount,
+                               1,
+                               command.firstIndex,
+                               command.vertexOffset,
+                               command.firstInstance);
+            }
+          continue;
+        }
+      for (uint32_t c = 0; c < batch.commandCount; c += max_draws)
+        {
+          vkCmdDrawIndexedIndirect(command_buffer,
+                                   frame.commands.buffer,
+                                   VkDeviceSize{batch.firstCommand + c} * stride,
+                                   std::min(max_draws, batch.commandCount - c),
+                                   stride);
+        }
+    }
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::load_bindless(VkCommandPool _pool)
+{
+  const auto texture_count{static_cast<uint32_t>(imgs.size())};
+  auto texture_index = [&](const GltfTexture& texture) {
+    return texture.is_available() ? static_cast<uint32_t>(texture.texture - imgs.data())
+                                  : texture_count - 1;
+  };
+
+  std::vector<BindlessMaterialData> data(std::max<size_t>(materials.size(), 1));
+  for (size_t i = 0; i < materials.size(); i++)
+    {
+      const GltfMaterial& material{materials[i]};
+      data[i].baseColor_factor = material.baseColor_factor;
+      data[i].metallicFactor = material.metallicFactor;
+      data[i].roughnessFactor = material.roughnessFactor;
+      data[i].alphaCutoff = material.alphaCutoff;
+      data[i].alphaMode = static_cast<uint32_t>(material.alphaMode);
+      data[i].base_color = texture_index(material.base_color);
+      data[i].metallic_roughness = texture_index(material.metallic_roughness);
+      data[i].normal = texture_index(material.normal);
+      data[i].occlusion = texture_index(material.occlusion);
+      data[i].emissive = texture_index(material.emissive);
+    }
+  const VkDeviceSize material_bytes{data.size() * sizeof(BindlessMaterialData)};
+  Buffer::Upload_DeviceLocal(device,
+                             _pool,
+                             device->graphics_queue,
+                             data.data(),
+                             material_bytes,
+                             VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                             bindless.materials,
+                             Alloc);
+
+  const VkShaderStageFlags stages{VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT};
+  std::vector<VkDescriptorSetLayoutBinding> bindings{
+      Descriptor::GetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, stages, 0),
+      Descriptor::GetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, stages, 1)};
+  bindings[0].descriptorCount = texture_count;
+  // patches queued after bind_bindless are written into the table the recorded frame has bound
+  const std::vector<VkDescriptorBindingFlags> binding_flags{
+      VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT,
+      0};
+  layouts.bindless.init(device,
+                        bindings,
+                        binding_flags,
+                        VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT,
+                        Alloc);
+
+  const std::vector<VkDescriptorPoolSize> pool_sizes{
+      Descriptor::Get_DescriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                                         texture_count * Macro::MAX_FRAMES_IN_FLIGHT),
+      Descriptor::Get_DescriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                         Macro::MAX_FRAMES_IN_FLIGHT)};
+  bindless.pool.init(device,
+                     Macro::MAX_FRAMES_IN_FLIGHT,
+                     pool_sizes,
+                     VkDescriptorPoolCreateFlags{VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT},
+                     Alloc);
+  bindless.sets.init(device, &layouts.bindless, &bindless.pool, Macro::MAX_FRAMES_IN_FLIGHT);
+
+  std::vector<VkDescriptorImageInfo> image_infos(texture_count);
+  for (uint32_t i = 0; i < texture_count; i++)
+    image_infos[i] = imgs[i].is_resident() ? imgs[i].descriptor : placeholder();
+  const VkDescriptorBufferInfo material_info{
+      Descriptor::GetDescriptor_BufferInfo(bindless.materials.buffer, material_bytes)};
+
+  Descriptor::EngineDescriptorWriteBatch batch(device, 2 * bindless.sets.size());
+  for (VkDescriptorSet set : bindless.sets)
+    {
+      batch.write_images(set, 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, image_infos);
+      batch.write_buffer(set, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, material_info);
+    }
+  batch.flush();
+
+  fmt::println("bindless materials: {} materials, {} textures in a set per frame slot",
+               materials.size(),
+               texture_count);
+}
+
+void SngoEngine::Core::Source::Model::EngineGltfModel::bind_bindless(
+    VkCommandBuffer command_buffer,
+    VkPipelineLayout pipeline_layout,
+    uint32_t frame_index,
+    uint32_t bindless_set)
+{
+  if (!bindless.enabled)
+    {
+      throw std::runtime_error("failed to bind bindless materials, model loaded without them");
+    }
+  const uint32_t slot{frame_index % Macro::MAX_FRAMES_IN_FLIGHT};
+  VkDescriptorSet set{bindless.sets[slot]};
+  std::vector<uint32_t>& pending{bindless.pending[slot]};
+  if (!pending.empty())
+    {
+      Descriptor::EngineDescriptorWriteBatch batch(device, pending.size());
+      for (uint32_t img_index : pending)
+        {
+          batch.write_image(set,
+                            0,
+                            VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
+                            imgs[img_index].descriptor,
+                            img_index);
+        }
+      batch.flush();
+      pending.clear();
+    }
+  vkCmdBindDescriptorSets(command_buffer,
+                          VK_PIPELINE_BIND_POINT_GRAPHICS,
+                          pipeline_layout,
+                          bindless_set,
+                          1,
+                          &set,
+                          0,
+                          nullptr);
+}
+
 void SngoEngine::Core::Source::Model::EngineGltfModel::destroyer()
 {
   for (auto& node : nodes)
@@ -753,7 +2447,7 @@ void SngoEngine::Core::Source::Model::EngineCubeMap::creator(
 }
 
 void SngoEngine::Core::Source::Model::EngineCubeMap::generate_descriptor(
-    const Descriptor::EngineDescriptorPool& _pool,
+    Descriptor::EngineDescriptorAllocator& _allocator,
     Descriptor::EngineDescriptorSetLayout& _layout,
     Descriptor::EngineDescriptorSet& _set,
     uint32_t binding)
@@ -763,7 +2457,7 @@ void SngoEngine::Core::Source::Model::EngineCubeMap::generate_descriptor(
       VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, binding));
 
   _layout.init(device, bindings, Alloc);
-  _set.init(device, _layout.layout, _pool.descriptor_pool);
+  _set.init(device, &_layout, &_allocator);
 
   std::vector<VkWriteDescriptorSet> writes{};
   VkWriteDescriptorSet writeDescriptorSet{};
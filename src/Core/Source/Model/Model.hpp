@@ -3,7 +3,12 @@
 
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
+#include <deque>
 #include <functional>
 #include <iostream>
 #include <stdexcept>
@@ -21,12 +26,20 @@
 #include "src/Core/Macro.h"
 #include "src/Core/Source/Buffer/CommandBuffer.hpp"
 #include "src/Core/Source/Buffer/Descriptor.hpp"
+#include "src/Core/Source/Buffer/FrameAllocator.hpp"
 #include "src/Core/Source/Buffer/IndexBuffer.hpp"
 #include "src/Core/Source/Buffer/UniformBuffer.hpp"
 #include "src/Core/Source/Buffer/VertexBuffer.hpp"
 #include "src/Core/Source/Image/Image.hpp"
 #include "src/Core/Source/Image/ImageVIew.hpp"
 #include "src/Core/Source/Image/Sampler.hpp"
+#include "src/Core/Source/Image/TextureStreamer.hpp"
+#include "src/Core/Source/Model/MeshCache.hpp"
+#include "src/Core/Source/Model/VertexQuantize.hpp"
+#include "src/Core/Utils/MeshOptimize.hpp"
+#include "src/Core/Utils/MeshSimplify.hpp"
+#include "src/Core/Utils/Meshlet.hpp"
+#include "src/Core/Utils/ObjImport.hpp"
 #include "src/Core/Utils/Utils.hpp"
 #include "src/Core/Utils/tiny_gltf.hpp"
 
@@ -46,16 +59,37 @@ static bool loadImageDataFunc(tinygltf::Image* image,
   // KTX files will be handled by our own code
   if (image->uri.find_last_of(".") != std::string::npos)
     {
-      if (image->uri.substr(image->uri.find_last_of(".") + 1) == "ktx")
+      const std::string extension{image->uri.substr(image->uri.find_last_of(".") + 1)};
+      if (extension == "ktx" || extension == "ktx2")
         {
           return true;
         }
     }
+  if (image->mimeType == "image/ktx2")
+    {
+      return true;
+    }
 
   return tinygltf::LoadImageData(
       image, imageIndex, error, warning, req_width, req_height, bytes, size, userData);
 }
 
+// keeps the encoded bytes (image->as_is) for EngineTextureStreamer to decode on a worker
+static bool loadImageDataFuncDeferred(tinygltf::Image* image,
+                                      const int imageIndex,
+                                      std::string* error,
+                                      std::string* warning,
+                                      int req_width,
+                                      int req_height,
+                                      const unsigned char* bytes,
+                                      int size,
+                                      void* userData)
+{
+  image->image.assign(bytes, bytes + size);
+  image->as_is = true;
+  return true;
+}
+
 static bool loadImageDataFuncEmpty(tinygltf::Image* image,
                                    const int imageIndex,
                                    std::string* error,
@@ -112,20 +146,28 @@ struct EngineObj
   Buffer::EngineIndexBuffer<I> index_buffer;
 
  private:
-  void creator(const std::string& obj_file, const VkAllocationCallbacks* alloc = nullptr)
+  // optimize is what FileLoadingFlags::OptimizeMeshes does for glTF: reorder for the vertex
+  // cache and print the stats of the pass
+  void creator(const std::string& obj_file,
+               const VkAllocationCallbacks* alloc = nullptr,
+               bool optimize = false)
   {
     Alloc = alloc;
 
-    Utils::Load_Vetex_Index<V, I>(obj_file, vertices, indices);
+    Utils::Load_Vetex_Index_Parallel<V, I>(obj_file, vertices, indices);
+    // the deduplicated order says nothing about locality
+    if (optimize)
+      Utils::Optimize_Mesh(vertices, indices).print(obj_file.c_str());
   }
 
   void creator(const std::string& obj_file,
                const Device::LogicalDevice::EngineDevice* _device,
                const Buffer::EngineCommandPool* _pool,
                VkQueue _graphic_queue,
-               const VkAllocationCallbacks* alloc = nullptr)
+               const VkAllocationCallbacks* alloc = nullptr,
+               bool optimize = false)
   {
-    creator(obj_file, alloc);
+    creator(obj_file, alloc, optimize);
     load_buffer(_device, _pool, _graphic_queue);
   }
 
@@ -133,9 +175,10 @@ struct EngineObj
                const Device::LogicalDevice::EngineDevice* _device,
                VkCommandPool _vk_pool,
                VkQueue _graphic_queue,
-               const VkAllocationCallbacks* alloc = nullptr)
+               const VkAllocationCallbacks* alloc = nullptr,
+               bool optimize = false)
   {
-    creator(obj_file, alloc);
+    creator(obj_file, alloc, optimize);
     load_buffer(_device, _vk_pool, _graphic_queue);
   }
 
@@ -226,13 +269,20 @@ struct EngineObjModel
 
     descriptor_sets.init(device, _set_layout, &descriptor_pool, Macro::MAX_FRAMES_IN_FLIGHT);
 
-    std::vector<VkWriteDescriptorSet> writes(Macro::MAX_FRAMES_IN_FLIGHT);
+    // uniform buffer at binding 0, one sampler per texture after it, for every frame at once
+    Descriptor::EngineDescriptorWriteBatch batch(device,
+                                                 Macro::MAX_FRAMES_IN_FLIGHT * (1 + _size));
     for (int i = 0; i < Macro::MAX_FRAMES_IN_FLIGHT; i++)
       {
-        writes[i] =
-            Descriptor::GetDescriptSet_Write(_buffer_infos[i], _img_infos, descriptor_sets[i])[0];
+        batch.write_buffer(
+            descriptor_sets[i], 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, _buffer_infos[i]);
+        for (uint32_t j = 0; j < _size; j++)
+          {
+            batch.write_image(
+                descriptor_sets[i], j + 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, _img_infos[j]);
+          }
       }
-    descriptor_sets.updateWrite(writes);
+    batch.flush();
 
     Model(Obj_file);
   }
@@ -275,7 +325,28 @@ enum FileLoadingFlags
   PreTransformVertices = 0x00000001,
   PreMultiplyVertexColors = 0x00000002,
   FlipY = 0x00000004,
-  DontLoadImages = 0x00000008
+  DontLoadImages = 0x00000008,
+  // upload quantized per-primitive layouts (CompactVertexLayout) instead of the 96 byte vertex
+  CompactVertices = 0x00000010,
+  // store indices relative to each primitive's firstVertex, as uint16 where they fit
+  CompactIndices = 0x00000020,
+  // reorder every primitive for the post-transform cache, overdraw and vertex fetch
+  OptimizeMeshes = 0x00000040,
+  // simplified index ranges per primitive, picked by screen size once set_lodView was called
+  GenerateLods = 0x00000080,
+  // split every primitive into meshlets that draw_meshlets culls against cone and frustum
+  BuildMeshlets = 0x00000100,
+  // persistently mapped indirect commands and per-draw records for update/draw_indirect
+  IndirectDraws = 0x00000200,
+  // one update-after-bind texture array and a material storage buffer instead of per-material
+  // sets; falls back to per-material sets without descriptor indexing
+  BindlessMaterials = 0x00000400,
+  // streamed PNG/JPG images are block-compressed by their material role (BC1/BC3, sRGB for
+  // color) and cached in <gltf file>.texcache
+  CompressTextures = 0x00000800,
+  // images up to atlas.max_extent whose materials sample them inside [0, 1] share atlas pages,
+  // the UVs of those materials' primitives are moved into their rects; streamed images are not
+  AtlasTextures = 0x00001000
 };
 
 enum DescriptorBindingFlags
@@ -289,12 +360,39 @@ enum RenderFlags
   BindImages = 0x00000001,
   RenderOpaqueNodes = 0x00000002,
   RenderAlphaMaskedNodes = 0x00000004,
-  RenderAlphaBlendedNodes = 0x00000008
+  RenderAlphaBlendedNodes = 0x00000008,
+  // binds the mesh's UniformBlock (layouts.matrices) at layouts.matrices_set per node
+  BindMeshUniforms = 0x00000010
 };
 
 struct EngineGltfModel;
 struct GltfNode;
 
+// std430 material record of the bindless table, textures index EngineGltfModel::imgs and fall
+// back to its trailing empty texture
+struct BindlessMaterialData
+{
+  glm::vec4 baseColor_factor{1.0f};
+  float metallicFactor{1.0f};
+  float roughnessFactor{1.0f};
+  float alphaCutoff{1.0f};
+  uint32_t alphaMode{};
+  uint32_t base_color{};
+  uint32_t metallic_roughness{};
+  uint32_t normal{};
+  uint32_t occlusion{};
+  uint32_t emissive{};
+  uint32_t padding[3]{};
+};
+
+// std430 record of one indirect draw, shaders index it with gl_InstanceIndex (firstInstance)
+struct IndirectDrawData
+{
+  glm::mat4 world{1.0f};
+  uint32_t material{};
+  uint32_t padding[3]{};
+};
+
 struct GLTF_EngineModelVertexData
 {
   glm::vec3 pos;
@@ -494,7 +592,16 @@ struct GltfMaterial
   // functions
   explicit GltfMaterial(const Device::LogicalDevice::EngineDevice* _device) : device(_device){};
   GltfMaterial() = default;
-  void create_set(VkDescriptorPool _pool, VkDescriptorSetLayout _layout, uint32_t bingding_flags);
+  // queues the texture writes into batch, the caller flushes once for all materials; textures
+  // that are not resident yet are written as placeholder
+  void create_set(VkDescriptorPool _pool,
+                  VkDescriptorSetLayout _layout,
+                  uint32_t bingding_flags,
+                  Descriptor::EngineDescriptorWriteBatch& batch,
+                  const VkDescriptorImageInfo& placeholder);
+  void write_set(uint32_t bingding_flags,
+                 Descriptor::EngineDescriptorWriteBatch& batch,
+                 const VkDescriptorImageInfo& placeholder);
 };
 
 struct Primitive
@@ -508,6 +615,39 @@ struct Primitive
   int32_t materialIndex{};
   GltfMaterial* material{};
 
+  // GLTF_EngineModelVertexData::component bits present in the source primitive
+  uint32_t components{};
+  // region of EngineGltfModel::compact holding this primitive, -1 without CompactVertices
+  int32_t compact_region{-1};
+  int32_t compact_vertexOffset{};
+  // index type and first index inside EngineGltfModel::packed_indices with CompactIndices
+  VkIndexType indexType{VK_INDEX_TYPE_UINT32};
+  uint32_t packed_firstIndex{};
+
+  // lods[0] is the full range, coarser levels index the same vertices
+  struct Lod
+  {
+    uint32_t firstIndex{};
+    uint32_t indexCount{};
+    uint32_t packed_firstIndex{};
+    // largest surface deviation from the full mesh, model units
+    float error{};
+    // meshlets [firstMeshlet, firstMeshlet + meshletCount) of EngineGltfModel::meshlets, their
+    // triangles are contiguous in this level's range
+    uint32_t firstMeshlet{};
+    uint32_t meshletCount{};
+  };
+  std::vector<Lod> lods;
+  // UV units per model unit, the square root of UV over surface area (0 without UVs); texture
+  // streaming turns it into the texel density on screen
+  float uv_density{};
+
+  // commands of EngineGltfModel::meshlet_draws written by the last cull_meshlets for the level
+  // it selected
+  uint32_t drawLevel{};
+  uint32_t firstDraw{};
+  uint32_t drawCount{};
+
   // functions
   struct Dimensions
   {
@@ -522,11 +662,20 @@ struct Primitive
       : firstIndex(firstIndex), indexCount(indexCount), material(material){};
 };
 
+// the std140 block the model vertex shaders read at layouts.matrices_set, keep the order
 struct UniformBlock
 {
   glm::mat4 matrix{};
   glm::mat4 jointMatrix[64]{};
   float jointcount{0};
+
+  // copies matrix, the first joints and jointcount to target, the unused joints are skipped
+  void write(void* target, size_t joints) const
+  {
+    auto* bytes{static_cast<std::byte*>(target)};
+    std::memcpy(bytes, this, offsetof(UniformBlock, jointMatrix) + joints * sizeof(glm::mat4));
+    std::memcpy(bytes + offsetof(UniformBlock, jointcount), &jointcount, sizeof(jointcount));
+  }
 };
 
 struct Mesh
@@ -534,19 +683,13 @@ struct Mesh
   std::vector<Primitive> primitives;
   std::string name;
 
-  Buffer::EngineUniformBuffer<UniformBlock> unibuffer;
-  Descriptor::EngineDescriptorSet set;
-  const Device::LogicalDevice::EngineDevice* device{};
-
   UniformBlock uniformBlock;
+  // this frame's UniformBlock in EngineGltfModel::frame_uniforms, set by GltfNode::update
+  uint32_t dynamic_offset{};
 
-  Mesh(const Device::LogicalDevice::EngineDevice* _device,
-       glm::mat4 matrix,
-       const VkAllocationCallbacks* alloc = nullptr)
+  explicit Mesh(glm::mat4 matrix)
   {
-    device = _device;
     uniformBlock.matrix = matrix;
-    unibuffer.init(device, device->graphics_queue, alloc);
   }
 };
 
@@ -592,35 +735,37 @@ struct GltfNode
       }
     return m;
   }
-  void update()
+  // writes the bytes the mesh needs into the current frame of uniforms
+  void update(Buffer::EngineFrameAllocator& uniforms)
   {
     if (mesh)
       {
         glm::mat4 m = getMatrix();
+        mesh->uniformBlock.matrix = m;
+        size_t joint_count{0};
         if (skin)
           {
-            mesh->uniformBlock.matrix = m;
             // Update join matrices
             glm::mat4 inverseTransform = glm::inverse(m);
-            for (size_t i = 0; i < skin->joints.size(); i++)
+            joint_count =
+                std::min<size_t>(skin->joints.size(), std::size(mesh->uniformBlock.jointMatrix));
+            for (size_t i = 0; i < joint_count; i++)
               {
                 GltfNode* jointNode = skin->joints[i];
                 glm::mat4 jointMat = jointNode->getMatrix() * skin->inverseBindMatrices[i];
                 jointMat = inverseTransform * jointMat;
                 mesh->uniformBlock.jointMatrix[i] = jointMat;
               }
-            mesh->uniformBlock.jointcount = (float)skin->joints.size();
-            memcpy(mesh->unibuffer.mapped, &mesh->uniformBlock, sizeof(mesh->uniformBlock));
-          }
-        else
-          {
-            memcpy(mesh->unibuffer.mapped, &m, sizeof(glm::mat4));
           }
+        mesh->uniformBlock.jointcount = (float)joint_count;
+        const auto allocation{uniforms.allocate(sizeof(UniformBlock))};
+        mesh->uniformBlock.write(allocation.data, joint_count);
+        mesh->dynamic_offset = allocation.offset;
       }
 
     for (auto& child : children)
       {
-        child->update();
+        child->update(uniforms);
       }
   }
 
@@ -681,6 +826,60 @@ struct EngineGltfModel
             uint32_t bindImage_set = 1,
             uint32_t renderFlags = BindImages,
             uint32_t frame_index = 0);
+  // fills frame_index's slice of frame_uniforms from the current node matrices and joints; its
+  // previous submission must have completed
+  void update_uniforms(uint32_t frame_index);
+  // view_model maps model space to view space, LOD selection stays off until this is called
+  void set_lodView(const glm::mat4& view_model, const glm::mat4& projection, float viewport_height);
+  // BuildMeshlets only: rebuilds meshlet_draws from the meshlets of each primitive's selected
+  // level that survive cone and frustum rejection, draw_meshlets then records them in place of
+  // that level's range
+  void cull_meshlets(const glm::mat4& view_model, const glm::mat4& projection);
+  void draw_meshlets(VkCommandBuffer command_buffer,
+                     VkPipelineLayout pipeline_layout,
+                     uint32_t bindImage_set = 1,
+                     uint32_t renderFlags = BindImages,
+                     uint32_t frame_index = 0);
+  // IndirectDraws only: writes the frame's commands for the primitives inside the frustum
+  // (meshlet commands where cull_meshlets applies) sorted into one batch per alpha mode, compact
+  // region and index type; the frame's previous submission must have completed
+  void update_indirect(uint32_t frame_index,
+                       const glm::mat4& view_model,
+                       const glm::mat4& projection);
+  // one vkCmdDrawIndexedIndirect per matching batch after bind_buffers/bind_compactBuffers, with
+  // the per-draw storage buffer (layouts.draws) bound at draw_set
+  void draw_indirect(VkCommandBuffer command_buffer,
+                     VkPipelineLayout pipeline_layout,
+                     uint32_t frame_index,
+                     uint32_t draw_set = 2,
+                     uint32_t renderFlags = RenderOpaqueNodes,
+                     int32_t compact_region = -1);
+  // BindlessMaterials only: binds the frame's texture table and material buffer
+  // (layouts.bindless) once, draws then skip material binds and pass the material index as
+  // firstInstance; shaders read materials[gl_InstanceIndex] directly or
+  // draws[gl_InstanceIndex].material when indirect. Entries patched since the frame's table was
+  // last bound are written first, so its previous submission must have completed
+  void bind_bindless(VkCommandBuffer command_buffer,
+                     VkPipelineLayout pipeline_layout,
+                     uint32_t frame_index,
+                     uint32_t bindless_set = 1);
+  // imgs[img_index] became resident: queues its entry for every frame's bindless table, or moves
+  // the materials sampling it to new sets since their old sets may still be in use by frames in
+  // flight
+  void patch_texture(uint32_t img_index);
+  // streamed images only: tells the streamer how finely the base color and normal textures of
+  // the primitives inside the frustum are drawn, call it every frame ahead of its update
+  void request_mips(const glm::mat4& view_model,
+                    const glm::mat4& projection,
+                    float viewport_height);
+  // CompactVertices only: every region needs a pipeline built from its own layout
+  void bind_compactBuffers(VkCommandBuffer command_buffer, uint32_t region);
+  void draw_compact(VkCommandBuffer command_buffer,
+                    VkPipelineLayout pipeline_layout,
+                    uint32_t region,
+                    uint32_t bindImage_set = 1,
+                    uint32_t renderFlags = BindImages,
+                    uint32_t frame_index = 0);
   void destroyer();
 
   // ----------------------    members     -----------------------
@@ -691,11 +890,21 @@ struct EngineGltfModel
   Primitive::Dimensions dimensions;
 
   Descriptor::EngineDescriptorPool descriptor_pool{};
+  // per-frame ring of every mesh's UniformBlock, all meshes share uniform_set and only differ
+  // in their dynamic offset
+  Buffer::EngineFrameAllocator frame_uniforms{};
+  Descriptor::EngineDescriptorSet uniform_set{};
 
   struct
   {
+    // dynamic uniform buffer of one UniformBlock at binding 0
     Descriptor::EngineDescriptorSetLayout matrices;
+    uint32_t matrices_set{0};
     Descriptor::EngineDescriptorSetLayout texture;
+    // IndirectDraws: IndirectDrawData[] storage buffer at binding 0
+    Descriptor::EngineDescriptorSetLayout draws;
+    // BindlessMaterials: sampler2D[imgs.size()] at binding 0, BindlessMaterialData[] at 1
+    Descriptor::EngineDescriptorSetLayout bindless;
     uint32_t descript_bindingflags =
         DescriptorBindingFlags::ImageBaseColor | DescriptorBindingFlags::ImageNormalMap;
   } layouts;
@@ -707,11 +916,135 @@ struct EngineGltfModel
         vertex_buffer{};
     Buffer::EngineIndexBuffer<uint32_t> index_buffer{};
   } model;
+
+  // components kept by every compact layout even when a primitive lacks them, so primitives
+  // fall into fewer regions (shader permutations), set before init
+  uint32_t compact_components{GLTF_EngineModelVertexData::POS | GLTF_EngineModelVertexData::NORMAL
+                              | GLTF_EngineModelVertexData::UV};
+  struct CompactRegion
+  {
+    CompactVertexLayout layout{};
+    VkDeviceSize offset{};
+    uint32_t vertex_count{};
+  };
+  struct
+  {
+    Buffer::EngineBuffer vertex_buffer{};
+    std::vector<CompactRegion> regions{};
+    VkDeviceSize bytes{};
+    VkDeviceSize full_bytes{};
+  } compact;
+  // uint32 region at offset 0 followed by the uint16 region
+  struct
+  {
+    Buffer::EngineBuffer buffer{};
+    VkDeviceSize uint16_offset{};
+    VkDeviceSize bytes{};
+    VkDeviceSize full_bytes{};
+  } packed_indices;
+  // bounds are in the space the vertices are stored in, like Primitive::dimensions
+  std::vector<Utils::Meshlet> meshlets;
+  // neighbouring visible meshlets are merged into one command, vertexOffset and firstIndex
+  // address model.vertex_buffer and the index buffer bind_buffers/drawNode bind
+  struct
+  {
+    std::vector<VkDrawIndexedIndirectCommand> commands{};
+    uint32_t visible{};
+    uint32_t frustum_culled{};
+    uint32_t backface_culled{};
+  } meshlet_draws;
+  struct IndirectBatch
+  {
+    GltfMaterial::AlphaMode alphaMode{};
+    int32_t compact_region{-1};
+    VkIndexType indexType{VK_INDEX_TYPE_UINT32};
+    uint32_t firstCommand{};
+    uint32_t commandCount{};
+  };
+  struct IndirectFrame
+  {
+    Buffer::EngineBuffer commands{};
+    Buffer::EngineBuffer draws{};
+    VkDrawIndexedIndirectCommand* mapped_commands{};
+    IndirectDrawData* mapped_draws{};
+    std::vector<IndirectBatch> batches{};
+    uint32_t command_count{};
+    uint32_t draw_count{};
+  };
+  struct
+  {
+    std::array<IndirectFrame, Macro::MAX_FRAMES_IN_FLIGHT> frames{};
+    Descriptor::EngineDescriptorSets sets{};
+    uint32_t command_capacity{};
+    uint32_t draw_capacity{};
+  } indirect;
+  struct
+  {
+    Descriptor::EngineDescriptorPool pool{};
+    // one table per frame slot, frames in flight keep sampling theirs while patches land
+    Descriptor::EngineDescriptorSets sets{};
+    // per frame slot, imgs indices patched since its table was last bound
+    std::array<std::vector<uint32_t>, Macro::MAX_FRAMES_IN_FLIGHT> pending{};
+    Buffer::EngineBuffer materials{};
+    bool enabled{};
+  } bindless;
+  // streamed images: patch_texture gives a material a spare set or one from patched_sets, the
+  // set it replaces may still be bound by frames in flight and becomes spare after
+  // MAX_FRAMES_IN_FLIGHT streamer updates, like the streamer's replaced images
+  Descriptor::EngineDescriptorAllocator patched_sets{};
+  struct RetiredSet
+  {
+    VkDescriptorSet set{};
+    uint64_t frame{};
+  };
+  std::deque<RetiredSet> retired_sets;
+  std::vector<VkDescriptorSet> spare_sets;
+  Image::EngineTextureStreamer* texture_streamer{};
+  // EngineTextureStreamer ids of imgs, UINT32_MAX for images that are not streamed
+  std::vector<uint32_t> stream_ids;
+  // AtlasTextures: limits set before init, pages are imgs between the glTF images and the
+  // trailing empty texture
+  struct
+  {
+    uint32_t max_extent{256};
+    uint32_t page_size{2048};
+    // texels of repeated edge around every image, bilinear taps and log2(padding) mips stay
+    // inside it
+    uint32_t padding{4};
+    // per glTF image, the imgs index of the page it moved to or UINT32_MAX
+    std::vector<uint32_t> redirects{};
+    // per glTF material, uv * xy + zw lands in its rect; empty without atlased materials
+    std::vector<glm::vec4> uv_transforms{};
+    uint32_t page_count{};
+  } atlas;
+  // a primitive drops one LOD level each time its projected radius halves below lod_pixels
+  struct
+  {
+    glm::mat4 view_model{1.0f};
+    float proj_scale{};
+    float viewport_height{};
+    float lod_pixels{256.0f};
+    bool enabled{};
+  } lod_view;
   const Device::LogicalDevice::EngineDevice* device{};
 
   // ----------------------    private     -----------------------
  private:
   void load_imgs(tinygltf::Model& input, VkCommandPool _pool);
+  // AtlasTextures: packs the eligible images into pages and uploads them, their decoded pixels
+  // are released so gltf_LoadImage skips them
+  void load_atlas(tinygltf::Model& input, VkCommandPool _pool);
+  // every image starts as the trailing empty texture and is decoded and uploaded by streamer,
+  // which calls patch_texture on this model, so it must not move until streamer is idle;
+  // PNG/JPG images are compressed into texture_cache unless it is empty
+  void stream_imgs(tinygltf::Model& input,
+                   VkCommandPool _pool,
+                   Image::EngineTextureStreamer* streamer,
+                   const std::string& texture_cache);
+  [[nodiscard]] const VkDescriptorImageInfo& placeholder() const
+  {
+    return imgs.back().descriptor;
+  }
   void load_node(const tinygltf::Node& _node,
                  const tinygltf::Model& _input,
                  uint32_t _index,
@@ -721,7 +1054,34 @@ struct EngineGltfModel
   void load_nodes(const Device::LogicalDevice::EngineDevice* _device,
                   VkCommandPool _pool,
                   const tinygltf::Model& _input,
+                  const std::string& _gltf_file,
                   uint32_t flags);
+  std::vector<Primitive*> all_primitives();
+  void optimize_meshes(std::vector<uint32_t>& _indexbuffer,
+                       std::vector<GLTF_EngineModelVertexData>& _vertexbuffer);
+  void build_meshlets(std::vector<uint32_t>& _indexbuffer,
+                      const std::vector<GLTF_EngineModelVertexData>& _vertexbuffer);
+  void generate_lods(std::vector<uint32_t>& _indexbuffer,
+                     const std::vector<GLTF_EngineModelVertexData>& _vertexbuffer);
+  bool load_meshCache(const std::string& _cache_file,
+                      uint64_t _stamp,
+                      uint32_t _flags,
+                      std::vector<uint32_t>& _indexbuffer,
+                      std::vector<GLTF_EngineModelVertexData>& _vertexbuffer);
+  void save_meshCache(const std::string& _cache_file,
+                      uint64_t _stamp,
+                      uint32_t _flags,
+                      const std::vector<uint32_t>& _indexbuffer,
+                      const std::vector<GLTF_EngineModelVertexData>& _vertexbuffer);
+  [[nodiscard]] uint32_t select_lod(const Primitive& primitive, const glm::mat4& node_matrix) const;
+  void load_compactVertices(const Device::LogicalDevice::EngineDevice* _device,
+                            VkCommandPool _pool,
+                            const std::vector<GLTF_EngineModelVertexData>& _vertexbuffer);
+  void load_packedIndices(const Device::LogicalDevice::EngineDevice* _device,
+                          VkCommandPool _pool,
+                          const std::vector<uint32_t>& _indexbuffer);
+  void load_indirect();
+  void load_bindless(VkCommandPool _pool);
   void load_skins(tinygltf::Model& input);
   void load_animations(tinygltf::Model& input);
   void load_materials(tinygltf::Model& input);
@@ -732,7 +1092,9 @@ struct EngineGltfModel
                 GltfNode* node,
                 uint32_t bindImage_set,
                 uint32_t renderFlags,
-                uint32_t frame_index);
+                uint32_t frame_index,
+                int32_t compact_region = -1,
+                bool use_meshlets = false);
 
   // ------------------------------ creator  --------------------------------------
 
@@ -740,10 +1102,12 @@ struct EngineGltfModel
                const Device::LogicalDevice::EngineDevice* _device,
                const Buffer::EngineCommandPool* _pool,
                const VkAllocationCallbacks* alloc = nullptr,
-               const uint32_t loading_flag = PreTransformVertices | FlipY)
+               const uint32_t loading_flag = PreTransformVertices | FlipY,
+               Image::EngineTextureStreamer* streamer = nullptr)
   {
     device = _device;
     Alloc = alloc;
+    loading_flags = loading_flag;
 
     tinygltf::Model gltf_input;
     tinygltf::TinyGLTF gltf_context;
@@ -754,6 +1118,10 @@ struct EngineGltfModel
       {
         gltf_context.SetImageLoader(loadImageDataFuncEmpty, nullptr);
       }
+    else if (streamer)
+      {
+        gltf_context.SetImageLoader(loadImageDataFuncDeferred, nullptr);
+      }
     else
       {
         gltf_context.SetImageLoader(loadImageDataFunc, nullptr);
@@ -767,11 +1135,20 @@ struct EngineGltfModel
     // load elements
     if (!(loading_flag & FileLoadingFlags::DontLoadImages))
       {
-        load_imgs(gltf_input, _pool->command_pool);
+        if (streamer && (loading_flag & FileLoadingFlags::AtlasTextures))
+          fmt::println("[warn] {}: streamed textures are not atlased", gltf_file);
+        if (streamer)
+          stream_imgs(gltf_input,
+                      _pool->command_pool,
+                      streamer,
+                      (loading_flag & FileLoadingFlags::CompressTextures) ? gltf_file + ".texcache"
+                                                                          : std::string{});
+        else
+          load_imgs(gltf_input, _pool->command_pool);
       }
 
     load_materials(gltf_input);
-    load_nodes(device, _pool->command_pool, gltf_input, loading_flag);
+    load_nodes(device, _pool->command_pool, gltf_input, gltf_file, loading_flag);
     if (!gltf_input.animations.empty())
       {
         load_animations(gltf_input);
@@ -782,15 +1159,9 @@ struct EngineGltfModel
 
     // descriptor pool for all
     {
-      uint32_t ubo_count{0};
+      // every mesh binds the same set at its own dynamic offset
+      uint32_t ubo_count{1};
       uint32_t img_count{0};
-      for (auto node : linear_nodes)
-        {
-          if (node->mesh)
-            {
-              ubo_count++;
-            }
-        }
       for (auto& material : materials)
         {
           if (material.base_color.texture)
@@ -799,7 +1170,7 @@ struct EngineGltfModel
             }
         }
       std::vector<VkDescriptorPoolSize> poolSizes = {
-          {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, ubo_count},
+          {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, ubo_count},
       };
       if (img_count)
         {
@@ -814,40 +1185,59 @@ struct EngineGltfModel
                   VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, img_count));
             }
         }
-      const uint32_t maxSetCount = img_count + ubo_count;
+      uint32_t maxSetCount = img_count + ubo_count;
+      if (loading_flag & FileLoadingFlags::IndirectDraws)
+        {
+          poolSizes.push_back(Descriptor::Get_DescriptorPoolSize(
+              VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, Macro::MAX_FRAMES_IN_FLIGHT));
+          maxSetCount += Macro::MAX_FRAMES_IN_FLIGHT;
+        }
       descriptor_pool.init(device, maxSetCount, poolSizes, Alloc);
     }
 
-    // uniform buffer descriptor layout & sets
+    // per-frame uniform ring & its dynamic descriptor set
     {
       auto binding{Descriptor::GetLayoutBinding(
-          VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 0)};
+          VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT, 0)};
       layouts.matrices.init(device, std::vector<VkDescriptorSetLayoutBinding>{binding}, Alloc);
 
-      std::function<void(GltfNode * node, VkDescriptorSetLayout layout)> lambda_node_descript =
-          [&](GltfNode* node, VkDescriptorSetLayout layout) {
-            if (node->mesh)
-              {
-                node->mesh->set.init(device, &layouts.matrices, &descriptor_pool);
-
-                auto write{Descriptor::GetDescriptSet_Write(node->mesh->set.descriptor_set,
-                                                            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                                            0,
-                                                            &node->mesh->unibuffer.descriptor)};
-                node->mesh->set.updateWrite(&write[0]);
-              }
-            for (auto& child : node->children)
-              {
-                lambda_node_descript(child, layouts.matrices.layout);
-              }
-          };
-
-      for (auto node : nodes)
+      // every mesh takes a whole UniformBlock (the descriptor range), update writes the used bytes
+      const VkDeviceSize alignment{std::max<VkDeviceSize>(
+          device->pPD->properties.limits.minUniformBufferOffsetAlignment, 1)};
+      VkDeviceSize frame_bytes{0};
+      for (auto node : linear_nodes)
+        {
+          if (node->mesh)
+            frame_bytes += (sizeof(UniformBlock) + alignment - 1) / alignment * alignment;
+        }
+      frame_uniforms.init(device,
+                          frame_bytes,
+                          VkBufferUsageFlags{VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT},
+                          VkDeviceSize{0},
+                          Alloc);
+      for (uint32_t i = 0; i < Macro::MAX_FRAMES_IN_FLIGHT; i++)
         {
-          lambda_node_descript(node, layouts.matrices.layout);
+          update_uniforms(i);
         }
+
+      uniform_set.init(device, &layouts.matrices, &descriptor_pool);
+      const VkDescriptorBufferInfo uniform_info{frame_uniforms.descriptor(sizeof(UniformBlock))};
+      auto write{Descriptor::GetDescriptSet_Write(
+          uniform_set.descriptor_set, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 0, &uniform_info)};
+      uniform_set.updateWrite(&write[0]);
     }
 
+    bindless.enabled = (loading_flag & FileLoadingFlags::BindlessMaterials) && !imgs.empty();
+    if (bindless.enabled && !device->descriptor_indexing)
+      {
+        fmt::println("[warn] {}: no descriptor indexing, using per-material sets", gltf_file);
+        bindless.enabled = false;
+      }
+    if (bindless.enabled)
+      {
+        load_bindless(_pool->command_pool);
+      }
+
     // texture imgs descriptor layout & sets
     {
       std::vector<VkDescriptorSetLayoutBinding> binding{};
@@ -864,19 +1254,32 @@ struct EngineGltfModel
                                                          static_cast<uint32_t>(binding.size())));
         }
       layouts.texture.init(device, binding, Alloc);
+      Descriptor::EngineDescriptorWriteBatch batch(device, materials.size() * binding.size());
       for (auto& material : materials)
         {
-          if (material.base_color.is_available())
+          // bindless draws index the shared table instead
+          if (!bindless.enabled && material.base_color.is_available())
             {
               material.create_set(descriptor_pool.descriptor_pool,
                                   layouts.texture.layout,
-                                  layouts.descript_bindingflags);
+                                  layouts.descript_bindingflags,
+                                  batch,
+                                  placeholder());
             }
         }
+      batch.flush();
     }
+
+    if (loading_flag & FileLoadingFlags::IndirectDraws)
+      {
+        load_indirect();
+      }
   }
 
   std::vector<Image::EngineTextureImage> imgs;
+  // index type bound while recording draw/draw_compact with CompactIndices
+  VkIndexType bound_indexType{VK_INDEX_TYPE_MAX_ENUM};
+  uint32_t loading_flags{};
   const VkAllocationCallbacks* Alloc{};
 };
 
@@ -911,7 +1314,7 @@ struct EngineCubeMap
   }
   void destroyer();
 
-  void generate_descriptor(const Descriptor::EngineDescriptorPool& _pool,
+  void generate_descriptor(Descriptor::EngineDescriptorAllocator& _allocator,
                            Descriptor::EngineDescriptorSetLayout& _layout,
                            Descriptor::EngineDescriptorSet& _set,
                            uint32_t binding);
@@ -0,0 +1,240 @@
+#include "VertexQuantize.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "fmt/core.h"
+#include "src/Core/Source/Model/Model.hpp"
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/type_precision.hpp>
+
+static_assert(SngoEngine::Core::Source::Model::GLTF_EngineModelVertexData::TANGENT
+                  == 1 << SngoEngine::Core::Source::Model::COMPACT_TANGENT,
+              "CompactAttribute must follow GLTF_EngineModelVertexData::component");
+
+//===========================================================================================================================
+// quantization helpers
+//===========================================================================================================================
+
+namespace
+{
+inline float sign_not_zero(float v)
+{
+  return v >= 0.0f ? 1.0f : -1.0f;
+}
+
+const char* const COMPONENT_NAMES[SngoEngine::Core::Source::Model::COMPACT_ATTRIBUTE_COUNT]{
+    "POS", "NORMAL", "UV", "COLOR", "JOINT0", "WEIGHT0", "TANGENT"};
+}  // namespace
+
+glm::vec2 SngoEngine::Core::Source::Model::Oct_Encode(glm::vec3 n)
+{
+  const float l1{std::abs(n.x) + std::abs(n.y) + std::abs(n.z)};
+  if (l1 == 0.0f)
+    return {0.0f, 0.0f};
+  n /= l1;
+  if (n.z < 0.0f)
+    return {(1.0f - std::abs(n.y)) * sign_not_zero(n.x),
+            (1.0f - std::abs(n.x)) * sign_not_zero(n.y)};
+  return {n.x, n.y};
+}
+
+glm::vec3 SngoEngine::Core::Source::Model::Oct_Decode(glm::vec2 e)
+{
+  glm::vec3 v{e.x, e.y, 1.0f - std::abs(e.x) - std::abs(e.y)};
+  if (v.z < 0.0f)
+    {
+      v.x = (1.0f - std::abs(e.y)) * sign_not_zero(e.x);
+      v.y = (1.0f - std::abs(e.x)) * sign_not_zero(e.y);
+    }
+  return glm::normalize(v);
+}
+
+//===========================================================================================================================
+// CompactVertexLayout
+//===========================================================================================================================
+
+SngoEngine::Core::Source::Model::CompactVertexLayout
+SngoEngine::Core::Source::Model::CompactVertexLayout::From_Components(uint32_t components,
+                                                                      bool wide_joints)
+{
+  CompactVertexLayout layout{};
+  layout.components = components | GLTF_EngineModelVertexData::POS;
+  layout.wide_joints = wide_joints && (components & GLTF_EngineModelVertexData::JOINT0);
+
+  const std::array<std::pair<VkFormat, uint32_t>, COMPACT_ATTRIBUTE_COUNT> attributes{{
+      {VK_FORMAT_R32G32B32_SFLOAT, 12},
+      {VK_FORMAT_R16G16_SNORM, 4},
+      {VK_FORMAT_R16G16_SFLOAT, 4},
+      {VK_FORMAT_R8G8B8A8_UNORM, 4},
+      {layout.wide_joints ? VK_FORMAT_R16G16B16A16_UINT : VK_FORMAT_R8G8B8A8_UINT,
+       layout.wide_joints ? 8u : 4u},
+      {VK_FORMAT_R8G8B8A8_UNORM, 4},
+      {VK_FORMAT_R16G16B16A16_SNORM, 8},
+  }};
+
+  for (uint32_t i = 0; i < COMPACT_ATTRIBUTE_COUNT; i++)
+    {
+      if (!(layout.components & (1u << i)))
+        continue;
+      layout.formats[i] = attributes[i].first;
+      layout.offsets[i] = layout.stride;
+      layout.stride += attributes[i].second;
+    }
+  return layout;
+}
+
+VkVertexInputBindingDescription
+SngoEngine::Core::Source::Model::CompactVertexLayout::getBindingDescription(uint32_t binding) const
+{
+  VkVertexInputBindingDescription binding_description{};
+  binding_description.binding = binding;
+  binding_description.stride = stride;
+  binding_description.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+  return binding_description;
+}
+
+std::vector<VkVertexInputAttributeDescription>
+SngoEngine::Core::Source::Model::CompactVertexLayout::getAttributeDescriptions(
+    int _com,
+    uint32_t binding) const
+{
+  std::vector<VkVertexInputAttributeDescription> attributes{};
+  for (uint32_t i = 0; i < COMPACT_ATTRIBUTE_COUNT; i++)
+    {
+      if (!(_com & components & (1u << i)))
+        continue;
+
+      VkVertexInputAttributeDescription attri{};
+      attri.binding = binding;
+      attri.location = static_cast<uint32_t>(attributes.size());
+      attri.format = formats[i];
+      attri.offset = offsets[i];
+      attributes.push_back(attri);
+    }
+  return attributes;
+}
+
+std::string SngoEngine::Core::Source::Model::CompactVertexLayout::shader_prologue(int _com) const
+{
+  return Vertex_ShaderPrologue(_com, this);
+}
+
+std::string SngoEngine::Core::Source::Model::Vertex_ShaderPrologue(
+    int _com,
+    const CompactVertexLayout* layout)
+{
+  // {type, decode} for the float layout and the compact layout
+  const std::array<std::array<const char*, 4>, COMPACT_ATTRIBUTE_COUNT> inputs{{
+      {"vec3", "(v)", "vec3", "(v)"},
+      {"vec3", "(v)", "vec2", "sngo_oct_decode(v)"},
+      {"vec2", "(v)", "vec2", "(v)"},
+      {"vec4", "(v)", "vec4", "(v)"},
+      {"vec4", "(v)", "uvec4", "vec4(v)"},
+      {"vec4", "(v)", "vec4", "(v)"},
+      {"vec4", "(v)", "vec4", "vec4(sngo_oct_decode((v).xy), (v).z)"},
+  }};
+
+  std::string prologue{};
+  if (layout)
+    {
+      prologue +=
+          "#define SNGO_COMPACT_VERTEX 1\n"
+          "vec3 sngo_oct_decode(vec2 e)\n"
+          "{\n"
+          "  vec3 v = vec3(e, 1.0 - abs(e.x) - abs(e.y));\n"
+          "  if (v.z < 0.0)\n"
+          "    v.xy = (1.0 - abs(e.yx)) * vec2(e.x >= 0.0 ? 1.0 : -1.0, e.y >= 0.0 ? 1.0 : -1.0);\n"
+          "  return normalize(v);\n"
+          "}\n";
+    }
+
+  const uint32_t present{layout ? layout->components : 0x7Fu};
+  uint32_t location{0};
+  for (uint32_t i = 0; i < COMPACT_ATTRIBUTE_COUNT; i++)
+    {
+      if (!(static_cast<uint32_t>(_com) & present & (1u << i)))
+        continue;
+
+      const auto& input{inputs[i]};
+      prologue += fmt::format("#define SNGO_HAS_{0} 1\n"
+                              "#define SNGO_LOC_{0} {1}\n"
+                              "#define SNGO_{0}_TYPE {2}\n"
+                              "#define SNGO_DECODE_{0}(v) {3}\n",
+                              COMPONENT_NAMES[i],
+                              location++,
+                              input[layout ? 2 : 0],
+                              input[layout ? 3 : 1]);
+    }
+  return prologue;
+}
+
+//===========================================================================================================================
+// Encode_CompactVertices
+//===========================================================================================================================
+
+void SngoEngine::Core::Source::Model::Encode_CompactVertices(const CompactVertexLayout& layout,
+                                                             const GLTF_EngineModelVertexData* src,
+                                                             size_t count,
+                                                             std::byte* dst)
+{
+  const uint32_t com{layout.components};
+  auto put = [](std::byte* at, const auto& value) { std::memcpy(at, &value, sizeof(value)); };
+
+  for (size_t v = 0; v < count; v++, dst += layout.stride)
+    {
+      const GLTF_EngineModelVertexData& vert{src[v]};
+
+      // glm::vec3 may be padded to 16 bytes when aligned gentypes are forced
+      const std::array<float, 3> pos{vert.pos.x, vert.pos.y, vert.pos.z};
+      put(dst + layout.offsets[COMPACT_POS], pos);
+
+      if (com & GLTF_EngineModelVertexData::NORMAL)
+        put(dst + layout.offsets[COMPACT_NORMAL], glm::packSnorm2x16(Oct_Encode(vert.normal)));
+
+      if (com & GLTF_EngineModelVertexData::UV)
+        put(dst + layout.offsets[COMPACT_UV], glm::packHalf2x16(vert.uv));
+
+      if (com & GLTF_EngineModelVertexData::COLOR)
+        put(dst + layout.offsets[COMPACT_COLOR], glm::packUnorm4x8(vert.color));
+
+      if (com & GLTF_EngineModelVertexData::JOINT0)
+        {
+          const glm::uvec4 joint{glm::max(vert.joint0, glm::vec4(0.0f)) + 0.5f};
+          if (layout.wide_joints)
+            put(dst + layout.offsets[COMPACT_JOINT0], glm::u16vec4(joint));
+          else
+            put(dst + layout.offsets[COMPACT_JOINT0], glm::u8vec4(glm::min(joint, 255u)));
+        }
+
+      if (com & GLTF_EngineModelVertexData::WEIGHT0)
+        {
+          const glm::vec4 w{glm::max(vert.weight0, glm::vec4(0.0f))};
+          const float sum{w.x + w.y + w.z + w.w};
+          glm::ivec4 q{0};
+          if (sum > 0.0f)
+            {
+              q = glm::ivec4(glm::round(w / sum * 255.0f));
+              // hand the rounding error to the largest weight so the blend still sums to one
+              int largest{0};
+              for (int i = 1; i < 4; i++)
+                largest = q[i] > q[largest] ? i : largest;
+              q[largest] += 255 - (q.x + q.y + q.z + q.w);
+            }
+          put(dst + layout.offsets[COMPACT_WEIGHT0], glm::u8vec4(glm::clamp(q, 0, 255)));
+        }
+
+      if (com & GLTF_EngineModelVertexData::TANGENT)
+        {
+          const glm::vec2 oct{Oct_Encode(glm::vec3(vert.tangent))};
+          put(dst + layout.offsets[COMPACT_TANGENT],
+              glm::packSnorm4x16(glm::vec4(oct, vert.tangent.w < 0.0f ? -1.0f : 1.0f, 0.0f)));
+        }
+    }
+}
@@ -0,0 +1,97 @@
+#ifndef __SNGO_VERTEX_QUANTIZE_H
+#define __SNGO_VERTEX_QUANTIZE_H
+
+#include <vulkan/vulkan_core.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#define GLM_FORCE_RADIANS
+#define GLM_FORCE_DEPTH_ZERO_TO_ONE
+#include <glm/glm.hpp>
+
+namespace SngoEngine::Core::Source::Model
+{
+
+struct GLTF_EngineModelVertexData;
+
+//===========================================================================================================================
+// quantization helpers
+//===========================================================================================================================
+
+// unit vector -> octahedral coordinates in [-1, 1]^2
+glm::vec2 Oct_Encode(glm::vec3 n);
+glm::vec3 Oct_Decode(glm::vec2 e);
+
+//===========================================================================================================================
+// CompactVertexLayout
+//===========================================================================================================================
+
+// bit i matches GLTF_EngineModelVertexData::component (1 << i)
+enum CompactAttribute : uint32_t
+{
+  COMPACT_POS,
+  COMPACT_NORMAL,
+  COMPACT_UV,
+  COMPACT_COLOR,
+  COMPACT_JOINT0,
+  COMPACT_WEIGHT0,
+  COMPACT_TANGENT,
+  COMPACT_ATTRIBUTE_COUNT
+};
+
+// interleaved quantized vertex holding only the components a primitive uses:
+//   pos      R32G32B32_SFLOAT        12B
+//   normal   R16G16_SNORM (oct)       4B
+//   uv       R16G16_SFLOAT            4B
+//   color    R8G8B8A8_UNORM           4B
+//   joint0   R8G8B8A8_UINT            4B  (R16G16B16A16_UINT when a joint index >= 256)
+//   weight0  R8G8B8A8_UNORM           4B  (renormalized to sum to 255)
+//   tangent  R16G16B16A16_SNORM       8B  (oct.x, oct.y, handedness, 0)
+struct CompactVertexLayout
+{
+  uint32_t components{};
+  bool wide_joints{};
+  uint32_t stride{};
+  std::array<uint32_t, COMPACT_ATTRIBUTE_COUNT> offsets{};
+  std::array<VkFormat, COMPACT_ATTRIBUTE_COUNT> formats{};
+
+  static CompactVertexLayout From_Components(uint32_t components, bool wide_joints = false);
+
+  bool operator==(const CompactVertexLayout& other) const
+  {
+    return components == other.components && wide_joints == other.wide_joints;
+  }
+
+  [[nodiscard]] VkVertexInputBindingDescription getBindingDescription(uint32_t binding = 0) const;
+  // same sequential location scheme as GLTF_EngineModelVertexData::getAttributeDescriptions,
+  // _com components missing from the layout are skipped
+  [[nodiscard]] std::vector<VkVertexInputAttributeDescription> getAttributeDescriptions(
+      int _com,
+      uint32_t binding) const;
+
+  // #defines selecting the matching vertex shader permutation, see Vertex_ShaderPrologue
+  [[nodiscard]] std::string shader_prologue(int _com) const;
+};
+
+// GLSL prologue for a vertex shader reading the attributes in _com, passed to
+// EngineShaderStage as _vert_prologue. For every present component X (POS, NORMAL, UV, COLOR,
+// JOINT0, WEIGHT0, TANGENT) it defines SNGO_HAS_X, SNGO_LOC_X (location), SNGO_X_TYPE (input
+// type) and SNGO_DECODE_X(v) (to the 96 byte vertex meaning), so one source serves both layouts:
+//   layout(location = SNGO_LOC_NORMAL) in SNGO_NORMAL_TYPE inNormal;
+//   vec3 normal = SNGO_DECODE_NORMAL(inNormal);
+// layout == nullptr describes the float GLTF_EngineModelVertexData layout
+std::string Vertex_ShaderPrologue(int _com, const CompactVertexLayout* layout = nullptr);
+
+// writes count vertices of src into dst with the given layout, dst holds count * layout.stride
+void Encode_CompactVertices(const CompactVertexLayout& layout,
+                            const GLTF_EngineModelVertexData* src,
+                            size_t count,
+                            std::byte* dst);
+
+}  // namespace SngoEngine::Core::Source::Model
+
+#endif
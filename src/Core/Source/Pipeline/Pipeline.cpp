@@ -3,6 +3,9 @@
 #include <glslang/Public/ShaderLang.h>
 #include <vulkan/vulkan_core.h>
 
+#include <algorithm>
+#include <string>
+
 #include "src/Core/Data.h"
 #include "src/Core/Device/LogicalDevice.hpp"
 #include "src/Core/Render/RenderPass.hpp"
@@ -120,6 +123,33 @@ VkPushConstantRange SngoEngine::Core::Source::Pipeline::Get_PushConstantRange(
   return pushConstantRange;
 }
 
+std::string SngoEngine::Core::Source::Pipeline::Inject_ShaderPrologue(const std::string& code,
+                                                                      const std::string& prologue)
+{
+  if (prologue.empty())
+    return code;
+
+  // #version must stay the first directive, sources without one get the prologue on top
+  size_t at{0};
+  const size_t version{code.find("#version")};
+  if (version != std::string::npos)
+    {
+      const size_t line_end{code.find('\n', version)};
+      at = line_end == std::string::npos ? code.size() : line_end + 1;
+    }
+
+  std::string out{code.substr(0, at)};
+  if (!out.empty() && out.back() != '\n')
+    out += '\n';
+  out += prologue;
+  if (out.back() != '\n')
+    out += '\n';
+  // keeps compiler line numbers pointing at the original source
+  out += "#line " + std::to_string(std::count(code.begin(), code.begin() + at, '\n') + 1) + "\n";
+  out.append(code, at, std::string::npos);
+  return out;
+}
+
 //===========================================================================================================================
 // EnginePipelineLayout
 //===========================================================================================================================
@@ -128,17 +158,21 @@ SngoEngine::Core::Source::Pipeline::EngineShaderStage::EngineShaderStage(
     const std::string& _vert_file,
     const std::string& _frag_file,
     const std::string& _vert_name,
-    const std::string& _frag_name)
+    const std::string& _frag_name,
+    const std::string& _vert_prologue,
+    const std::string& _frag_prologue)
 {
   vert_name = _vert_name;
   frag_name = _frag_name;
 
-  std::string vert_code{Utils::read_file(_vert_file).data()};
+  std::string vert_code{
+      Inject_ShaderPrologue(Utils::read_file(_vert_file).data(), _vert_prologue)};
   vertex_shader_module = {
       Utils::Glsl_ShaderCompiler(_device->logical_device, EShLangVertex, vert_code)};
   stages[0] = {Source::Pipeline::Get_VertexShader_CreateInfo(vert_name, vertex_shader_module)};
 
-  std::string frag_code{Utils::read_file(_frag_file).data()};
+  std::string frag_code{
+      Inject_ShaderPrologue(Utils::read_file(_frag_file).data(), _frag_prologue)};
   fragment_shader_module = {
       Utils::Glsl_ShaderCompiler(_device->logical_device, EShLangFragment, frag_code)};
   stages[1] = {Source::Pipeline::Get_FragmentShader_CreateInfo(frag_name, fragment_shader_module)};
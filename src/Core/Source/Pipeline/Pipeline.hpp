@@ -39,6 +39,9 @@ VkPushConstantRange Get_PushConstantRange(VkShaderStageFlags stageFlags,
                                           uint32_t size,
                                           uint32_t offset = 0);
 
+// inserts prologue (#defines, helper functions) right after the #version line of a GLSL source
+std::string Inject_ShaderPrologue(const std::string& code, const std::string& prologue);
+
 //===========================================================================================================================
 // EnginePipelineLayout
 //===========================================================================================================================
@@ -56,7 +59,9 @@ struct EngineShaderStage
                              const std::string& _vert_file,
                              const std::string& _frag_file,
                              const std::string& _vert_name = "main",
-                             const std::string& _frag_name = "main");
+                             const std::string& _frag_name = "main",
+                             const std::string& _vert_prologue = "",
+                             const std::string& _frag_prologue = "");
 };
 
 //===========================================================================================================================
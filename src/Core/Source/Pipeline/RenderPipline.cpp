@@ -143,7 +143,14 @@ void SngoEngine::Core::Source::RenderPipeline::EngineFrameBufferAttachment::init
     }
   assert(aspectMask > 0);
 
-  if (!(_usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT))
+  // transient attachments are never sampled, they get lazily allocated memory where the device
+  // has it and ordinary device local memory elsewhere
+  VkMemoryPropertyFlags properties{VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT};
+  if (_usage & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT)
+    {
+      properties |= VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT;
+    }
+  else
     {
       _usage = VkImageUsageFlagBits(_usage | VK_IMAGE_USAGE_SAMPLED_BIT);
     }
@@ -158,7 +165,7 @@ void SngoEngine::Core::Source::RenderPipeline::EngineFrameBufferAttachment::init
                                   samples,
                                   VK_IMAGE_LAYOUT_UNDEFINED,
                                   _flags},
-           VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+           properties);
 
   VkImageViewType view_format{_flags == VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT
                                   ? VK_IMAGE_VIEW_TYPE_CUBE
@@ -187,6 +194,7 @@ void SngoEngine::Core::Source::RenderPipeline::EngineFrameBufferAttachment::dest
 
 void SngoEngine::Core::Source::RenderPipeline::EngineOffscreenHDR_RenderPass::init(
     const Device::LogicalDevice::EngineDevice* _device,
+    Render::EngineRenderGraph* graph,
     VkExtent2D _extent,
     VkSampleCountFlagBits samplers,
     const VkAllocationCallbacks* alloc)
@@ -194,105 +202,33 @@ void SngoEngine::Core::Source::RenderPipeline::EngineOffscreenHDR_RenderPass::in
 {
   extent = _extent;
   device = _device;
-  const uint32_t attach_count{5};
+  const VkFormat depth_format{Image::Find_DepthFormat(_device->pPD->physical_device)};
 
-  // attchments initialization
+  // attchments declaration
   {
-    VkImageUsageFlagBits _usage{VkImageUsageFlagBits(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)};
-
-    attchment_FloatingPoint_0.init(
-        _device, VK_FORMAT_R32G32B32A32_SFLOAT, _usage, extent, samplers);
-    attchment_FloatingPoint_1.init(
-        _device, VK_FORMAT_R32G32B32A32_SFLOAT, _usage, extent, samplers);
-    attchment_Depth.init(_device,
-                         Image::Find_DepthFormat(_device->pPD->physical_device),
-                         VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-                         extent,
-                         samplers);
-    attchment_Resolve_0.init(
-        _device, VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, extent);
-    attchment_Resolve_1.init(
-        _device, VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, extent);
+    // the multisampled targets are only resolved and the depth only tested
+    const Render::GraphImage_Info transient{VK_FORMAT_R32G32B32A32_SFLOAT,
+                                            extent,
+                                            samplers,
+                                            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT};
+    attchment_FloatingPoint_0 = graph->create_image("hdr_floating_point_0", transient);
+    attchment_FloatingPoint_1 = graph->create_image("hdr_floating_point_1", transient);
+    attchment_Depth = graph->create_image(
+        "hdr_depth",
+        {depth_format, extent, samplers, VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT});
+    attchment_Resolve_0 =
+        graph->create_image("hdr_resolve_0", {VK_FORMAT_R32G32B32A32_SFLOAT, extent});
+    attchment_Resolve_1 =
+        graph->create_image("hdr_resolve_1", {VK_FORMAT_R32G32B32A32_SFLOAT, extent});
   }
 
-  // Attachment Description
-  std::vector<VkAttachmentDescription> attachmentDescs{attach_count};
-  {
-    // attachment_0 : color
-    {
-      attachmentDescs[0].samples = samplers;
-
-      attachmentDescs[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-      attachmentDescs[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-
-      attachmentDescs[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-      attachmentDescs[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      attachmentDescs[0].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
-      attachmentDescs[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    }
-
-    // attachment_1 : color
-    {
-      attachmentDescs[1].samples = samplers;
-
-      attachmentDescs[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-      attachmentDescs[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-
-      attachmentDescs[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-      attachmentDescs[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      attachmentDescs[1].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
-      attachmentDescs[1].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    }
-
-    // attachment_3 : depth stencil
-    {
-      attachmentDescs[2].samples = samplers;
-
-      attachmentDescs[2].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-      attachmentDescs[2].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-
-      attachmentDescs[2].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-      attachmentDescs[2].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[2].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      attachmentDescs[2].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
-      attachmentDescs[2].format = attchment_Depth.format;
-    }
-
-    // attachment_4 : resolve
-    {
-      attachmentDescs[3].samples = VK_SAMPLE_COUNT_1_BIT;
-
-      attachmentDescs[3].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-      attachmentDescs[3].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-
-      attachmentDescs[3].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-      attachmentDescs[3].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[3].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      attachmentDescs[3].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
-      attachmentDescs[3].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    }
-
-    // attachment_5 : resolve
-    {
-      attachmentDescs[4].samples = VK_SAMPLE_COUNT_1_BIT;
-
-      attachmentDescs[4].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-      attachmentDescs[4].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-
-      attachmentDescs[4].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-      attachmentDescs[4].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[4].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      attachmentDescs[4].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
-      attachmentDescs[4].format = VK_FORMAT_R32G32B32A32_SFLOAT;
-    }
-  }
+  // Attachment Description, ops derived from the declared usage
+  std::vector<VkAttachmentDescription> attachmentDescs{
+      graph->attachment_description(attchment_FloatingPoint_0),
+      graph->attachment_description(attchment_FloatingPoint_1),
+      graph->attachment_description(attchment_Depth),
+      graph->attachment_description(attchment_Resolve_0),
+      graph->attachment_description(attchment_Resolve_1)};
 
   // color references
   std::vector<VkAttachmentReference> colorReferences{};
@@ -318,46 +254,6 @@ void SngoEngine::Core::Source::RenderPipeline::EngineOffscreenHDR_RenderPass::in
     subpass.pDepthStencilAttachment = depthReference.data();
   }
 
-  // dependency
-  std::vector<VkSubpassDependency> dependencies{2};
-  {
-    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependencies[0].dstSubpass = 0;
-
-    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-
-    dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-    dependencies[0].dstAccessMask =
-        VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-    dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-    //--------------------------------------------------------------------------------------
-
-    dependencies[1].srcSubpass = 0;
-    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
-
-    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-
-    dependencies[1].srcAccessMask =
-        VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-
-    dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-  }
-
-  // attachments
-  std::vector<VkImageView> attachments{attach_count};
-  {
-    attachments[0] = attchment_FloatingPoint_0.view.image_view;
-    attachments[1] = attchment_FloatingPoint_1.view.image_view;
-    attachments[2] = attchment_Depth.view.image_view;
-    attachments[3] = attchment_Resolve_0.view.image_view;
-    attachments[4] = attchment_Resolve_1.view.image_view;
-  }
-
   // sampler info
   auto sampler_info{Image::Get_Default_Sampler(_device)};
   {
@@ -374,14 +270,41 @@ void SngoEngine::Core::Source::RenderPipeline::EngineOffscreenHDR_RenderPass::in
     sampler_info.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
   }
 
-  renderpass.init(_device, dependencies, &subpass, attachmentDescs, alloc);
+  // no external dependencies, the graph's barriers order the pass against its neighbours
+  renderpass.init(_device, std::vector<VkSubpassDependency>{}, &subpass, attachmentDescs, alloc);
+  sampler.init(_device, sampler_info, alloc);
+}
+
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder
+SngoEngine::Core::Source::RenderPipeline::EngineOffscreenHDR_RenderPass::add_pass(
+    Render::EngineRenderGraph* graph,
+    Render::EngineRenderGraph::Execute execute) const
+{
+  auto pass{graph->add_pass("offscreen_hdr", std::move(execute))};
+  pass.write(attchment_FloatingPoint_0, Render::GraphUsage::ColorAttachment)
+      .write(attchment_FloatingPoint_1, Render::GraphUsage::ColorAttachment)
+      .write(attchment_Depth, Render::GraphUsage::DepthAttachment)
+      .write(attchment_Resolve_0, Render::GraphUsage::ColorAttachment)
+      .write(attchment_Resolve_1, Render::GraphUsage::ColorAttachment);
+  return pass;
+}
+
+void SngoEngine::Core::Source::RenderPipeline::EngineOffscreenHDR_RenderPass::construct_framebuffer(
+    const Render::EngineRenderGraph* graph,
+    const VkAllocationCallbacks* alloc)
+{
+  // attachments
+  std::vector<VkImageView> attachments{graph->view(attchment_FloatingPoint_0),
+                                       graph->view(attchment_FloatingPoint_1),
+                                       graph->view(attchment_Depth),
+                                       graph->view(attchment_Resolve_0),
+                                       graph->view(attchment_Resolve_1)};
+
   framebuffer.init(
-      _device,
+      device,
       Data::FrameBufferCreate_Info{
           renderpass.render_pass, attachments, VkExtent3D{extent.width, extent.height, 1}},
       alloc);
-
-  sampler.init(_device, sampler_info, alloc);
 }
 
 //===========================================================================================================================
@@ -390,6 +313,7 @@ void SngoEngine::Core::Source::RenderPipeline::EngineOffscreenHDR_RenderPass::in
 
 void SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::init(
     const Device::LogicalDevice::EngineDevice* _device,
+    Render::EngineRenderGraph* graph,
     VkExtent2D _extent,
     const VkAllocationCallbacks* alloc)
 {
@@ -397,10 +321,10 @@ void SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::ini
   device = _device;
   const uint32_t attach_count{1};
 
-  // attchments initialization
+  // attchments declaration
   {
-    attchment_FloatingPoint.init(
-        _device, VK_FORMAT_R32G32B32A32_SFLOAT, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, extent);
+    attchment_FloatingPoint =
+        graph->create_image("bloom_floating_point", {VK_FORMAT_R32G32B32A32_SFLOAT, extent});
   }
 
   // Attachment Description
@@ -416,9 +340,9 @@ void SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::ini
       attachmentDescs[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
       attachmentDescs[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
 
-      attachmentDescs[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      attachmentDescs[0].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
-      attachmentDescs[0].format = attchment_FloatingPoint.format;
+      attachmentDescs[0].initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+      attachmentDescs[0].finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+      attachmentDescs[0].format = VK_FORMAT_R32G32B32A32_SFLOAT;
     }
   }
 
@@ -436,42 +360,6 @@ void SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::ini
     subpass.colorAttachmentCount = 1;
   }
 
-  // dependency
-  std::vector<VkSubpassDependency> dependencies{2};
-  {
-    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependencies[0].dstSubpass = 0;
-
-    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-
-    dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-    dependencies[0].dstAccessMask =
-        VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-
-    dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-    //--------------------------------------------------------------------------------------
-
-    dependencies[1].srcSubpass = 0;
-    dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
-
-    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-
-    dependencies[1].srcAccessMask =
-        VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-
-    dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-  }
-
-  // attachments
-  std::vector<VkImageView> attachments{attach_count};
-  {
-    attachments[0] = attchment_FloatingPoint.view.image_view;
-  }
-
   // sampler_infomation
   auto sampler_info{Image::Get_Default_Sampler(_device)};
   {
@@ -488,17 +376,36 @@ void SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::ini
     sampler_info.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
   }
 
-  renderpass.init(_device, dependencies, &subpass, attachmentDescs, alloc);
+  renderpass.init(_device, std::vector<VkSubpassDependency>{}, &subpass, attachmentDescs, alloc);
+  sampler.init(_device, sampler_info, alloc);
+}
+
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder
+SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::add_pass(
+    Render::EngineRenderGraph* graph,
+    Render::EngineRenderGraph::Execute execute) const
+{
+  auto pass{graph->add_pass("bloom_filter", std::move(execute))};
+  pass.write(attchment_FloatingPoint, Render::GraphUsage::ColorAttachment);
+  return pass;
+}
+
+void SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::construct_framebuffer(
+    const Render::EngineRenderGraph* graph,
+    const VkAllocationCallbacks* alloc)
+{
+  // attachments
+  std::vector<VkImageView> attachments{graph->view(attchment_FloatingPoint)};
+
   framebuffer.init(
-      _device,
+      device,
       Data::FrameBufferCreate_Info{
           renderpass.render_pass, attachments, VkExtent3D{extent.width, extent.height, 1}},
       alloc);
-  sampler.init(_device, sampler_info, alloc);
 }
 
 void SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::construct_descriptor(
-    Descriptor::EngineDescriptorPool* _pool,
+    Descriptor::EngineDescriptorAllocator* _allocator,
     std::vector<VkDescriptorImageInfo>& imginfos,
     const VkAllocationCallbacks* alloc)
 {
@@ -511,7 +418,7 @@ void SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::con
           VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, 1)};
 
   bloom_setlayout.init(device, setLayoutBindings, alloc);
-  bloom_set.init(device, &bloom_setlayout, _pool);
+  bloom_set.init(device, &bloom_setlayout, _allocator);
 
   std::vector<VkWriteDescriptorSet> writes{
       Descriptor::GetDescriptSet_Write(
@@ -561,8 +468,6 @@ void SngoEngine::Core::Source::RenderPipeline::EngineBloomFilter_RenderPass::des
 {
   if (device)
     {
-      attchment_FloatingPoint.destroyer();
-
       framebuffer.destroyer();
       renderpass.destroyer();
       sampler.destroyer();
@@ -599,84 +504,42 @@ VkSampleCountFlagBits SngoEngine::Core::Source::RenderPipeline::MSAA_maxAvailabl
 
 void SngoEngine::Core::Source::RenderPipeline::EngineMSAA_RenderPass::init(
     Device::LogicalDevice::EngineDevice* _device,
+    Render::EngineRenderGraph* graph,
     VkExtent2D _extent,
     VkFormat color_format,
     VkSampleCountFlagBits samplers,
-    SwapChain::EngineSwapChain* swap_chain,
     bool contaion_gui_subpass,
     const VkAllocationCallbacks* alloc)
 {
   extent = _extent;
   device = _device;
-  const uint32_t attach_count{3};
+  const VkFormat depth_format{Image::Find_DepthFormat(_device->pPD->physical_device)};
 
   assert((device->pPD->properties.limits.framebufferColorSampleCounts & samplers)
          && (device->pPD->properties.limits.framebufferDepthSampleCounts & samplers));
 
-  // attchments initialization
+  // attchments declaration
   {
-    attchment_Color.init(_device,
-                         color_format,
-                         VkImageUsageFlagBits(VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT
-                                              | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT),
-                         extent,
-                         samplers);
-
-    attchment_Depth.init(_device,
-                         Image::Find_DepthFormat(_device->pPD->physical_device),
-                         VkImageUsageFlagBits(VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT
-                                              | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT),
-                         extent,
-                         samplers);
+    attchment_Color = graph->create_image(
+        "msaa_color",
+        {color_format, extent, samplers, VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT});
+    attchment_Depth = graph->create_image(
+        "msaa_depth",
+        {depth_format, extent, samplers, VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT});
+    // acquired by the frame, the acquire semaphore is waited on at color attachment output
+    attchment_Present = graph->import_image("swap_chain",
+                                            {color_format, extent},
+                                            VK_IMAGE_LAYOUT_UNDEFINED,
+                                            VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+                                            VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
   }
 
-  // Attachment Description
-  std::vector<VkAttachmentDescription> attachmentDescs{attach_count};
-  {
-    // attachment_0 : color
-    {
-      attachmentDescs[0].samples = samplers;
-
-      attachmentDescs[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-      attachmentDescs[0].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-      attachmentDescs[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      attachmentDescs[0].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
-
-      attachmentDescs[0].format = color_format;
-    }
-    // attachment_1 : resolve
-    {
-      attachmentDescs[1].samples = VK_SAMPLE_COUNT_1_BIT;
-
-      attachmentDescs[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-      attachmentDescs[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-
-      attachmentDescs[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-      attachmentDescs[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      attachmentDescs[1].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-      attachmentDescs[1].format = color_format;
-    }
-    // attachment_2 : depth
-    {
-      attachmentDescs[2].samples = samplers;
-
-      attachmentDescs[2].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-      attachmentDescs[2].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[2].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-      attachmentDescs[2].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-
-      attachmentDescs[2].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-      attachmentDescs[2].finalLayout = VK_IMAGE_LAYOUT_GENERAL;
-      attachmentDescs[2].format = attchment_Depth.format;
-    }
-  }
+  // Attachment Description, ops derived from the declared usage; the resolve target is the
+  // swap chain, the graph moves it to present layout afterwards
+  std::vector<VkAttachmentDescription> attachmentDescs{
+      graph->attachment_description(attchment_Color),
+      graph->attachment_description(attchment_Present),
+      graph->attachment_description(attchment_Depth)};
 
   // color references
   VkAttachmentReference colorReference{};
@@ -712,36 +575,9 @@ void SngoEngine::Core::Source::RenderPipeline::EngineMSAA_RenderPass::init(
       }
   }
 
-  // dependency
-  std::vector<VkSubpassDependency> dependencies{2};
+  // dependency, only between the scene and gui subpasses, the graph handles the outside
+  std::vector<VkSubpassDependency> dependencies{};
   {
-    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependencies[0].dstSubpass = 0;
-
-    dependencies[0].srcStageMask =
-        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-    dependencies[0].dstStageMask =
-        VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-    dependencies[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    dependencies[0].dstAccessMask =
-        VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
-    dependencies[0].dependencyFlags = 0;
-
-    //--------------------------------------------------------------------------------------
-
-    dependencies[1].srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependencies[1].dstSubpass = 0;
-
-    dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependencies[1].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependencies[1].srcAccessMask = 0;
-    dependencies[1].dstAccessMask =
-        VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-
-    dependencies[1].dependencyFlags = 0;
-
-    //--------------------------------------------------------------------------------------
-
     if (contaion_gui_subpass)
       {
         VkSubpassDependency depen{};
@@ -761,16 +597,33 @@ void SngoEngine::Core::Source::RenderPipeline::EngineMSAA_RenderPass::init(
       }
   }
 
+  renderpass.init(_device, dependencies, subpasses, attachmentDescs, alloc);
+}
+
+SngoEngine::Core::Render::EngineRenderGraph::PassBuilder
+SngoEngine::Core::Source::RenderPipeline::EngineMSAA_RenderPass::add_pass(
+    Render::EngineRenderGraph* graph,
+    Render::EngineRenderGraph::Execute execute) const
+{
+  auto pass{graph->add_pass("msaa_composition", std::move(execute))};
+  pass.write(attchment_Color, Render::GraphUsage::ColorAttachment)
+      .write(attchment_Depth, Render::GraphUsage::DepthAttachment)
+      .write(attchment_Present, Render::GraphUsage::ColorAttachment);
+  return pass;
+}
+
+void SngoEngine::Core::Source::RenderPipeline::EngineMSAA_RenderPass::construct_framebuffer(
+    const Render::EngineRenderGraph* graph,
+    SwapChain::EngineSwapChain* swap_chain)
+{
   // attachments
-  std::vector<VkImageView> attachments{attach_count};
+  std::vector<VkImageView> attachments{3};
   {
-    attachments[0] = attchment_Color.view.image_view;
+    attachments[0] = graph->view(attchment_Color);
 
-    attachments[2] = attchment_Depth.view.image_view;
+    attachments[2] = graph->view(attchment_Depth);
   }
 
-  renderpass.init(_device, dependencies, subpasses, attachmentDescs, alloc);
-
   VkFramebufferCreateInfo frameBufferCreateInfo = {};
   {
     frameBufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
@@ -788,12 +641,12 @@ void SngoEngine::Core::Source::RenderPipeline::EngineMSAA_RenderPass::init(
     {
       attachments[1] = swap_chain->image_views[i];
       Utils::Vk_Exception(vkCreateFramebuffer(
-          _device->logical_device, &frameBufferCreateInfo, nullptr, &framebuffers[i]));
+          device->logical_device, &frameBufferCreateInfo, nullptr, &framebuffers[i]));
     }
 }
 
 void SngoEngine::Core::Source::RenderPipeline::EngineMSAA_RenderPass::construct_descriptor(
-    Descriptor::EngineDescriptorPool* _pool,
+    Descriptor::EngineDescriptorAllocator* _allocator,
     std::vector<VkDescriptorImageInfo>& imginfos,
     const VkAllocationCallbacks* alloc)
 {
@@ -806,7 +659,7 @@ void SngoEngine::Core::Source::RenderPipeline::EngineMSAA_RenderPass::construct_
           VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, 1)};
 
   msaa_setlayout.init(device, setLayoutBindings, alloc);
-  msaa_set.init(device, &msaa_setlayout, _pool);
+  msaa_set.init(device, &msaa_setlayout, _allocator);
 
   std::vector<VkWriteDescriptorSet> writes{
       Descriptor::GetDescriptSet_Write(
@@ -849,9 +702,6 @@ void SngoEngine::Core::Source::RenderPipeline::EngineMSAA_RenderPass::destroyer(
 {
   if (device)
     {
-      attchment_Color.destroyer();
-
-      attchment_Depth.destroyer();
       framebuffers.destroyer();
       renderpass.destroyer();
 
@@ -973,7 +823,7 @@ void SngoEngine::Core::Source::RenderPipeline::EngineShadowMap_RenderPass::init(
 }
 
 void SngoEngine::Core::Source::RenderPipeline::EngineShadowMap_RenderPass::construct_descriptor(
-    Descriptor::EngineDescriptorPool* _pool,
+    Descriptor::EngineDescriptorAllocator* _allocator,
     VkDescriptorBufferInfo debug_buffer_info,
     VkDescriptorBufferInfo offscreen_buffer_info,
     VkDescriptorBufferInfo scene_buffer_info,
@@ -990,9 +840,9 @@ void SngoEngine::Core::Source::RenderPipeline::EngineShadowMap_RenderPass::const
           VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, 1)};
 
   SM_setlayout.init(device, setLayoutBindings, alloc);
-  sets.debug.init(device, &SM_setlayout, _pool);
-  sets.offscreen.init(device, &SM_setlayout, _pool);
-  sets.scene.init(device, &SM_setlayout, _pool);
+  sets.debug.init(device, &SM_setlayout, _allocator);
+  sets.offscreen.init(device, &SM_setlayout, _allocator);
+  sets.scene.init(device, &SM_setlayout, _allocator);
 
   // debug set
   std::vector<VkWriteDescriptorSet> writes = {
@@ -1510,13 +1360,13 @@ void SngoEngine::Core::Source::RenderPipeline::EngineIrradianceCube_RenderPass::
   VkViewport viewport = Render::RenderPass::Get_ViewPort((float)dim, (float)dim, 0.0f, 1.0f);
   VkRect2D scissor = Render::RenderPass::Get_Rect2D(dim, dim, 0, 0);
 
-  Image::Transition_ImageLayout(device,
-                                cmd_pool(),
+  // every transition is recorded into the one command buffer, in order with the copies
+  Buffer::EngineOnceCommandBuffer cmdbuffer(device, cmd_pool(), device->graphics_queue);
+  Image::Transition_ImageLayout(cmdbuffer(),
                                 attachment_CubeMap.img(),
                                 subresourceRange,
                                 VK_IMAGE_LAYOUT_UNDEFINED,
                                 VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-  Buffer::EngineOnceCommandBuffer cmdbuffer(device, cmd_pool(), device->graphics_queue);
 
   Block_IrradianceCube push_block{};
 
@@ -1554,8 +1404,7 @@ void SngoEngine::Core::Source::RenderPipeline::EngineIrradianceCube_RenderPass::
 
           vkCmdEndRenderPass(cmdbuffer());
 
-          Image::Transition_ImageLayout(device,
-                                        cmd_pool(),
+          Image::Transition_ImageLayout(cmdbuffer(),
                                         attachment_Offscreen.img(),
                                         Data::ImageSubresourceRange_Info{VK_IMAGE_ASPECT_COLOR_BIT},
                                         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
@@ -1581,8 +1430,7 @@ void SngoEngine::Core::Source::RenderPipeline::EngineIrradianceCube_RenderPass::
                            &copyRegion);
 
             Image::Transition_ImageLayout(
-                device,
-                cmd_pool(),
+                cmdbuffer(),
                 attachment_Offscreen.img(),
                 Data::ImageSubresourceRange_Info{VK_IMAGE_ASPECT_COLOR_BIT},
                 VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
@@ -1591,12 +1439,13 @@ void SngoEngine::Core::Source::RenderPipeline::EngineIrradianceCube_RenderPass::
         }
     }
 
-  Image::Transition_ImageLayout(device,
-                                cmd_pool(),
-                                attachment_Offscreen.img(),
-                                Data::ImageSubresourceRange_Info{VK_IMAGE_ASPECT_COLOR_BIT},
-                                VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                                VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+  // the offscreen target is back in COLOR_ATTACHMENT_OPTIMAL after the last face, the cube is
+  // what gets sampled through CubeMap_descriptor
+  Image::Transition_ImageLayout(cmdbuffer(),
+                                attachment_CubeMap.img(),
+                                subresourceRange,
+                                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                                VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
 
   cmdbuffer.end_buffer();
 }
\ No newline at end of file
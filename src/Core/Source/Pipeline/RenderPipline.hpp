@@ -7,6 +7,7 @@
 
 #include "src/Core/Device/LogicalDevice.hpp"
 #include "src/Core/Render/FrameBuffer.hpp"
+#include "src/Core/Render/RenderGraph.hpp"
 #include "src/Core/Render/RenderPass.hpp"
 #include "src/Core/Source/Buffer/CommandBuffer.hpp"
 #include "src/Core/Source/Buffer/Descriptor.hpp"
@@ -54,6 +55,8 @@ struct EngineFrameBufferAttachment
     destroyer();
   }
 
+  // with VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT the image is lazily allocated where possible,
+  // describe it with RenderPass::Usage_Attachment so it is never loaded or stored
   void init(const Device::LogicalDevice::EngineDevice* _device,
             VkFormat _format,
             VkImageUsageFlagBits _usage,
@@ -69,13 +72,15 @@ struct EngineFrameBufferAttachment
 // EngineOffscreenHDR_RenderPass
 //===========================================================================================================================
 
+// The attachments are images of the frame graph: the render pass expects them in attachment
+// layout and leaves them there, the graph inserts the barriers around it.
 struct EngineOffscreenHDR_RenderPass
 {
-  EngineFrameBufferAttachment attchment_FloatingPoint_0{};
-  EngineFrameBufferAttachment attchment_FloatingPoint_1{};
-  EngineFrameBufferAttachment attchment_Depth{};
-  EngineFrameBufferAttachment attchment_Resolve_0{};
-  EngineFrameBufferAttachment attchment_Resolve_1{};
+  Render::GraphResource attchment_FloatingPoint_0{};
+  Render::GraphResource attchment_FloatingPoint_1{};
+  Render::GraphResource attchment_Depth{};
+  Render::GraphResource attchment_Resolve_0{};
+  Render::GraphResource attchment_Resolve_1{};
 
   Render::EngineFrameBuffer framebuffer{};
   Render::RenderPass::EngineRenderPass renderpass{};
@@ -85,10 +90,18 @@ struct EngineOffscreenHDR_RenderPass
 
   VkExtent2D extent{};
 
+  // declares the attachments in the graph and creates the render pass
   void init(const Device::LogicalDevice::EngineDevice* _device,
+            Render::EngineRenderGraph* graph,
             VkExtent2D _extent,
             VkSampleCountFlagBits samplers,
             const VkAllocationCallbacks* alloc = nullptr);
+  // a pass writing every attachment, the caller adds what it reads
+  Render::EngineRenderGraph::PassBuilder add_pass(Render::EngineRenderGraph* graph,
+                                                  Render::EngineRenderGraph::Execute execute) const;
+  // after the graph is compiled
+  void construct_framebuffer(const Render::EngineRenderGraph* graph,
+                             const VkAllocationCallbacks* alloc = nullptr);
 };
 
 //===========================================================================================================================
@@ -97,7 +110,7 @@ struct EngineOffscreenHDR_RenderPass
 
 struct EngineBloomFilter_RenderPass
 {
-  EngineFrameBufferAttachment attchment_FloatingPoint{};
+  Render::GraphResource attchment_FloatingPoint{};
 
   Render::EngineFrameBuffer framebuffer{};
   Render::RenderPass::EngineRenderPass renderpass{};
@@ -116,9 +129,14 @@ struct EngineBloomFilter_RenderPass
   void destroyer();
 
   void init(const Device::LogicalDevice::EngineDevice* _device,
+            Render::EngineRenderGraph* graph,
             VkExtent2D _extent,
             const VkAllocationCallbacks* alloc = nullptr);
-  void construct_descriptor(Descriptor::EngineDescriptorPool* _pool,
+  Render::EngineRenderGraph::PassBuilder add_pass(Render::EngineRenderGraph* graph,
+                                                  Render::EngineRenderGraph::Execute execute) const;
+  void construct_framebuffer(const Render::EngineRenderGraph* graph,
+                             const VkAllocationCallbacks* alloc = nullptr);
+  void construct_descriptor(Descriptor::EngineDescriptorAllocator* _allocator,
                             std::vector<VkDescriptorImageInfo>& imginfos,
                             const VkAllocationCallbacks* alloc = nullptr);
   void construct_pipeline(std::vector<VkPipelineShaderStageCreateInfo>& _shader_stage,
@@ -138,10 +156,12 @@ struct EngineBloomFilter_RenderPass
 
 VkSampleCountFlagBits MSAA_maxAvailableSampleCount(Device::LogicalDevice::EngineDevice* _device);
 
+// Resolves into the swap chain image, which the graph imports and hands over for presenting.
 struct EngineMSAA_RenderPass
 {
-  EngineFrameBufferAttachment attchment_Color{};
-  EngineFrameBufferAttachment attchment_Depth{};
+  Render::GraphResource attchment_Color{};
+  Render::GraphResource attchment_Depth{};
+  Render::GraphResource attchment_Present{};
 
   Render::EngineFrameBuffers framebuffers{};
   Render::RenderPass::EngineRenderPass renderpass{};
@@ -157,15 +177,21 @@ struct EngineMSAA_RenderPass
   Device::LogicalDevice::EngineDevice* device;
 
   void init(Device::LogicalDevice::EngineDevice* _device,
+            Render::EngineRenderGraph* graph,
             VkExtent2D _extent,
             VkFormat color_format,
             VkSampleCountFlagBits samplers,
-            SwapChain::EngineSwapChain* swap_chain,
             bool contaion_gui_subpass = true,
             const VkAllocationCallbacks* alloc = nullptr);
   void destroyer();
 
-  void construct_descriptor(Descriptor::EngineDescriptorPool* _pool,
+  Render::EngineRenderGraph::PassBuilder add_pass(Render::EngineRenderGraph* graph,
+                                                  Render::EngineRenderGraph::Execute execute) const;
+  // one framebuffer per swap chain image
+  void construct_framebuffer(const Render::EngineRenderGraph* graph,
+                             SwapChain::EngineSwapChain* swap_chain);
+
+  void construct_descriptor(Descriptor::EngineDescriptorAllocator* _allocator,
                             std::vector<VkDescriptorImageInfo>& imginfos,
                             const VkAllocationCallbacks* alloc = nullptr);
 
@@ -219,7 +245,7 @@ struct EngineShadowMap_RenderPass
   void init(Device::LogicalDevice::EngineDevice* _device,
             VkExtent2D _extent,
             const VkAllocationCallbacks* alloc = nullptr);
-  void construct_descriptor(Descriptor::EngineDescriptorPool* _pool,
+  void construct_descriptor(Descriptor::EngineDescriptorAllocator* _allocator,
                             VkDescriptorBufferInfo debug_buffer_info,
                             VkDescriptorBufferInfo offscreen_buffer_info,
                             VkDescriptorBufferInfo scene_buffer_info,
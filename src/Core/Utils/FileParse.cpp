@@ -0,0 +1,334 @@
+#include "FileParse.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "fmt/core.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SNGO_FILEPARSE_SSE2
+#endif
+
+//===========================================================================================================================
+// MappedFile
+//===========================================================================================================================
+
+SngoEngine::Core::Utils::MappedFile::MappedFile(MappedFile&& other) noexcept
+    : data(std::exchange(other.data, nullptr)),
+      size(std::exchange(other.size, 0)),
+      file_handle(std::exchange(other.file_handle, nullptr)),
+      mapping_handle(std::exchange(other.mapping_handle, nullptr))
+{
+}
+
+SngoEngine::Core::Utils::MappedFile& SngoEngine::Core::Utils::MappedFile::operator=(
+    MappedFile&& other) noexcept
+{
+  if (this != &other)
+    {
+      destroyer();
+      data = std::exchange(other.data, nullptr);
+      size = std::exchange(other.size, 0);
+      file_handle = std::exchange(other.file_handle, nullptr);
+      mapping_handle = std::exchange(other.mapping_handle, nullptr);
+    }
+  return *this;
+}
+
+#ifdef _WIN32
+
+void SngoEngine::Core::Utils::MappedFile::creator(const std::string& filename)
+{
+  HANDLE file = CreateFileA(filename.c_str(),
+                            GENERIC_READ,
+                            FILE_SHARE_READ,
+                            nullptr,
+                            OPEN_EXISTING,
+                            FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+    throw std::runtime_error("failed to open file " + filename);
+
+  LARGE_INTEGER file_size{};
+  if (!GetFileSizeEx(file, &file_size))
+    {
+      CloseHandle(file);
+      throw std::runtime_error("failed to query size of " + filename);
+    }
+  file_handle = file;
+  size = static_cast<size_t>(file_size.QuadPart);
+  if (size == 0)
+    return;
+
+  HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (mapping == nullptr)
+    {
+      destroyer();
+      throw std::runtime_error("failed to map file " + filename);
+    }
+  mapping_handle = mapping;
+  data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (data == nullptr)
+    {
+      destroyer();
+      throw std::runtime_error("failed to map file " + filename);
+    }
+}
+
+void SngoEngine::Core::Utils::MappedFile::destroyer()
+{
+  if (data)
+    UnmapViewOfFile(data);
+  if (mapping_handle)
+    CloseHandle(mapping_handle);
+  if (file_handle)
+    CloseHandle(file_handle);
+  data = nullptr;
+  size = 0;
+  mapping_handle = nullptr;
+  file_handle = nullptr;
+}
+
+#else
+
+void SngoEngine::Core::Utils::MappedFile::creator(const std::string& filename)
+{
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("failed to open file " + filename);
+
+  struct stat st{};
+  if (fstat(fd, &st) != 0)
+    {
+      close(fd);
+      throw std::runtime_error("failed to query size of " + filename);
+    }
+  size = static_cast<size_t>(st.st_size);
+  if (size != 0)
+    {
+      void* p = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (p == MAP_FAILED)
+        {
+          close(fd);
+          size = 0;
+          throw std::runtime_error("failed to map file " + filename);
+        }
+      madvise(p, size, MADV_SEQUENTIAL);
+      data = static_cast<const char*>(p);
+    }
+  // the mapping keeps its own reference to the file
+  close(fd);
+}
+
+void SngoEngine::Core::Utils::MappedFile::destroyer()
+{
+  if (data)
+    munmap(const_cast<char*>(data), size);
+  data = nullptr;
+  size = 0;
+}
+
+#endif
+
+//===========================================================================================================================
+// text scanning
+//===========================================================================================================================
+
+namespace
+{
+inline bool is_space(char c)
+{
+  return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+inline bool starts_number(char c)
+{
+  return (c >= '0' && c <= '9') || c == '.' || c == '-' || c == '+';
+}
+}  // namespace
+
+const char* SngoEngine::Core::Utils::Skip_Whitespace(const char* p, const char* end)
+{
+#ifdef SNGO_FILEPARSE_SSE2
+  const __m128i space{_mm_set1_epi8(' ')};
+  const __m128i lower{_mm_set1_epi8('\t' - 1)};
+  const __m128i upper{_mm_set1_epi8('\r' + 1)};
+  while (end - p >= 16)
+    {
+      const __m128i chunk{_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))};
+      // bytes >= 0x80 compare as negative and are never whitespace
+      const __m128i ws{_mm_or_si128(
+          _mm_cmpeq_epi8(chunk, space),
+          _mm_and_si128(_mm_cmpgt_epi8(chunk, lower), _mm_cmplt_epi8(chunk, upper)))};
+      const auto mask{static_cast<uint32_t>(~_mm_movemask_epi8(ws)) & 0xFFFFu};
+      if (mask)
+        return p + std::countr_zero(mask);
+      p += 16;
+    }
+#endif
+  while (p < end && is_space(*p))
+    ++p;
+  return p;
+}
+
+const char* SngoEngine::Core::Utils::Skip_Line(const char* p, const char* end)
+{
+  const void* nl{std::memchr(p, '\n', static_cast<size_t>(end - p))};
+  return nl ? static_cast<const char*>(nl) + 1 : end;
+}
+
+bool SngoEngine::Core::Utils::Parse_Floats(std::string_view text,
+                                           std::vector<float>& values,
+                                           std::string* err)
+{
+  const char* begin{text.data()};
+  const char* p{begin};
+  const char* end{begin + text.size()};
+
+  auto fail = [&](const char* at, const char* what) {
+    if (err)
+      *err = fmt::format("{} at line {}", what, std::count(begin, at, '\n') + 1);
+    return false;
+  };
+
+  // most measured data is a number every ~8 characters
+  values.reserve(values.size() + text.size() / 8);
+  while ((p = Skip_Whitespace(p, end)) < end)
+    {
+      if (*p == '#')
+        {
+          p = Skip_Line(p, end);
+          continue;
+        }
+      if (*p == ',')
+        {
+          ++p;
+          continue;
+        }
+      if (!starts_number(*p))
+        return fail(p, "unexpected character");
+
+      // from_chars does not take an explicit '+'
+      const char* first{*p == '+' ? p + 1 : p};
+      float v{};
+      auto [ptr, ec] = std::from_chars(first, end, v);
+      if (ec != std::errc{} || (ptr < end && !is_space(*ptr) && *ptr != '#' && *ptr != ','))
+        return fail(p, "unable to parse float value");
+      values.push_back(v);
+      p = ptr;
+    }
+  return true;
+}
+
+//===========================================================================================================================
+// Benchmark_FloatFile
+//===========================================================================================================================
+
+namespace
+{
+// the reader Read_FloatFile used before the mapped parser, kept only as the benchmark baseline
+std::vector<float> read_floats_stdio(const std::string& filename)
+{
+  FILE* f = fopen(filename.c_str(), "rb");
+  if (f == nullptr)
+    throw std::runtime_error("Unable to open file " + filename);
+
+  int c;
+  bool inNumber = false;
+  char curNumber[32];
+  int curNumberPos = 0;
+  std::vector<float> values;
+  while ((c = getc(f)) != EOF)
+    {
+      if (inNumber)
+        {
+          if ((isdigit(c) != 0) || c == '.' || c == 'e' || c == 'E' || c == '-' || c == '+')
+            {
+              if (curNumberPos < static_cast<int>(sizeof(curNumber)) - 1)
+                curNumber[curNumberPos++] = static_cast<char>(c);
+            }
+          else
+            {
+              curNumber[curNumberPos++] = '\0';
+              try
+                {
+                  values.push_back(std::stof(std::string(curNumber)));
+                }
+              catch (...)
+                {
+                }
+              inNumber = false;
+              curNumberPos = 0;
+            }
+        }
+      else if ((isdigit(c) != 0) || c == '.' || c == '-' || c == '+')
+        {
+          inNumber = true;
+          curNumber[curNumberPos++] = static_cast<char>(c);
+        }
+      else if (c == '#')
+        {
+          while ((c = getc(f)) != '\n' && c != EOF)
+            ;
+        }
+    }
+  fclose(f);
+  return values;
+}
+}  // namespace
+
+void SngoEngine::Core::Utils::Benchmark_FloatFile(const std::string& filename, uint32_t iterations)
+{
+  using Clock = std::chrono::steady_clock;
+  iterations = std::max(iterations, 1u);
+
+  size_t file_size{MappedFile(filename).size};
+  if (file_size == 0)
+    {
+      fmt::println("Benchmark_FloatFile: {} is empty", filename);
+      return;
+    }
+
+  size_t count_stdio{}, count_mapped{};
+
+  auto t0{Clock::now()};
+  for (uint32_t i = 0; i < iterations; i++)
+    count_stdio = read_floats_stdio(filename).size();
+  auto t1{Clock::now()};
+  for (uint32_t i = 0; i < iterations; i++)
+    {
+      MappedFile file{filename};
+      std::vector<float> values;
+      Parse_Floats(file.view(), values);
+      count_mapped = values.size();
+    }
+  auto t2{Clock::now()};
+
+  const double mb{static_cast<double>(file_size) * iterations / (1024.0 * 1024.0)};
+  const double s_stdio{std::chrono::duration<double>(t1 - t0).count()};
+  const double s_mapped{std::chrono::duration<double>(t2 - t1).count()};
+
+  fmt::println("Benchmark_FloatFile: {} ({} bytes, {} iterations)", filename, file_size, iterations);
+  fmt::println("  getc + stof      : {:8.2f} MB/s, {} values", mb / s_stdio, count_stdio);
+  fmt::println("  mmap + from_chars: {:8.2f} MB/s, {} values", mb / s_mapped, count_mapped);
+  fmt::println("  speedup          : {:.2f}x", s_stdio / s_mapped);
+}
@@ -0,0 +1,72 @@
+#ifndef __SNGO_FILEPARSE_H
+#define __SNGO_FILEPARSE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace SngoEngine::Core::Utils
+{
+
+//===========================================================================================================================
+// MappedFile
+//===========================================================================================================================
+
+// read-only memory mapping of a whole file, empty files map to {nullptr, 0}
+struct MappedFile
+{
+  const char* data{};
+  size_t size{};
+
+  MappedFile() = default;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  explicit MappedFile(const std::string& filename)
+  {
+    creator(filename);
+  }
+  void init(const std::string& filename)
+  {
+    destroyer();
+    creator(filename);
+  }
+  ~MappedFile()
+  {
+    destroyer();
+  }
+  void destroyer();
+
+  [[nodiscard]] std::string_view view() const
+  {
+    return {data, size};
+  }
+
+ private:
+  void creator(const std::string& filename);
+
+  void* file_handle{};
+  void* mapping_handle{};
+};
+
+//===========================================================================================================================
+// text scanning
+//===========================================================================================================================
+
+// first character in [p, end) that is not ' ', '\t', '\n', '\v', '\f' or '\r'
+const char* Skip_Whitespace(const char* p, const char* end);
+// first character after the next '\n', or end
+const char* Skip_Line(const char* p, const char* end);
+
+// whitespace or comma separated floats with '#' line comments, the format of Read_FloatFile
+bool Parse_Floats(std::string_view text, std::vector<float>& values, std::string* err = nullptr);
+
+// MB/s of the previous getc/stof reader against the mapped from_chars reader
+void Benchmark_FloatFile(const std::string& filename, uint32_t iterations = 16);
+
+}  // namespace SngoEngine::Core::Utils
+
+#endif
@@ -0,0 +1,387 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+// set on the pool's own threads, UINT32_MAX everywhere else
+thread_local const SngoEngine::Core::Utils::EngineJobSystem* tls_system{};
+thread_local uint32_t tls_worker{UINT32_MAX};
+// jobs running on this thread, a job waiting inside another one is only timed by the outer one
+thread_local uint32_t tls_depth{};
+
+uint64_t Elapsed_Ns(std::chrono::steady_clock::time_point start)
+{
+  return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                   std::chrono::steady_clock::now() - start)
+                                   .count());
+}
+}  // namespace
+
+//===========================================================================================================================
+// EngineJobSystem
+//===========================================================================================================================
+
+void SngoEngine::Core::Utils::EngineJobSystem::creator(uint32_t worker_count)
+{
+  if (worker_count == 0)
+    worker_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+
+  stopping = false;
+  workers.clear();
+  for (uint32_t i = 0; i < worker_count; i++)
+    workers.push_back(std::make_unique<Worker>());
+  for (uint32_t i = 0; i < worker_count; i++)
+    workers[i]->thread = std::thread(&EngineJobSystem::worker_loop, this, i);
+}
+
+void SngoEngine::Core::Utils::EngineJobSystem::destroyer()
+{
+  if (workers.empty())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (auto& worker : workers)
+    worker->thread.join();
+  workers.clear();
+}
+
+uint32_t SngoEngine::Core::Utils::EngineJobSystem::current_worker() const
+{
+  return tls_system == this ? tls_worker : UINT32_MAX;
+}
+
+SngoEngine::Core::Utils::JobHandle SngoEngine::Core::Utils::EngineJobSystem::schedule(
+    std::function<void()> fn,
+    const std::vector<JobHandle>& dependencies)
+{
+  auto job{std::make_shared<Job>()};
+  job->fn = std::move(fn);
+
+  for (const JobHandle& dependency : dependencies)
+    {
+      if (!dependency)
+        continue;
+      std::lock_guard<std::mutex> lock(dependency->mutex);
+      if (dependency->done.load(std::memory_order_acquire))
+        {
+          if (dependency->error)
+            {
+              std::lock_guard<std::mutex> job_lock(job->mutex);
+              if (!job->error)
+                job->error = dependency->error;
+            }
+          continue;
+        }
+      job->pending.fetch_add(1, std::memory_order_relaxed);
+      dependency->continuations.push_back(job);
+    }
+
+  // drops the scheduling guard, queues the job right away when no dependency is outstanding
+  if (job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    push(job);
+  return job;
+}
+
+void SngoEngine::Core::Utils::EngineJobSystem::push(JobHandle job)
+{
+  if (workers.empty())
+    {
+      execute(job, external, false);
+      return;
+    }
+
+  uint32_t target{current_worker()};
+  if (target == UINT32_MAX)
+    target = next_worker.fetch_add(1, std::memory_order_relaxed) % worker_count();
+  // counted first, a thief seeing the count early only looks once more
+  queued.fetch_add(1);
+  {
+    std::lock_guard<std::mutex> lock(workers[target]->mutex);
+    workers[target]->jobs.push_back(std::move(job));
+  }
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex);
+  }
+  if (waiting.load() > 0)
+    wake.notify_all();
+  else
+    wake.notify_one();
+}
+
+SngoEngine::Core::Utils::JobHandle SngoEngine::Core::Utils::EngineJobSystem::find_job(
+    uint32_t self,
+    bool& stolen)
+{
+  stolen = false;
+  if (queued.load(std::memory_order_acquire) == 0)
+    return nullptr;
+
+  if (self != UINT32_MAX)
+    {
+      Worker& own{*workers[self]};
+      std::lock_guard<std::mutex> lock(own.mutex);
+      if (!own.jobs.empty())
+        {
+          JobHandle job{std::move(own.jobs.back())};
+          own.jobs.pop_back();
+          queued.fetch_sub(1, std::memory_order_relaxed);
+          return job;
+        }
+    }
+
+  const uint32_t count{worker_count()};
+  const uint32_t start{self == UINT32_MAX ? 0 : self + 1};
+  for (uint32_t i = 0; i < count; i++)
+    {
+      const uint32_t victim{(start + i) % count};
+      if (victim == self)
+        continue;
+      Worker& other{*workers[victim]};
+      std::lock_guard<std::mutex> lock(other.mutex);
+      if (!other.jobs.empty())
+        {
+          JobHandle job{std::move(other.jobs.front())};
+          other.jobs.pop_front();
+          queued.fetch_sub(1, std::memory_order_relaxed);
+          stolen = self != UINT32_MAX;
+          return job;
+        }
+    }
+  return nullptr;
+}
+
+void SngoEngine::Core::Utils::EngineJobSystem::execute(const JobHandle& job,
+                                                       Counters& counters,
+                                                       bool stolen)
+{
+  const auto start{std::chrono::steady_clock::now()};
+  tls_depth++;
+  bool failed;
+  {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    failed = static_cast<bool>(job->error);
+  }
+  if (!failed)
+    {
+      try
+        {
+          job->fn();
+        }
+      catch (...)
+        {
+          std::lock_guard<std::mutex> lock(job->mutex);
+          job->error = std::current_exception();
+        }
+    }
+  // releases whatever the closure captured before the continuations start
+  job->fn = nullptr;
+
+  if (--tls_depth == 0)
+    counters.busy_ns.fetch_add(Elapsed_Ns(start), std::memory_order_relaxed);
+  counters.executed.fetch_add(1, std::memory_order_relaxed);
+  if (stolen)
+    counters.stolen.fetch_add(1, std::memory_order_relaxed);
+  finish(job);
+}
+
+void SngoEngine::Core::Utils::EngineJobSystem::finish(const JobHandle& job)
+{
+  std::vector<JobHandle> continuations;
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    job->done.store(true);
+    continuations.swap(job->continuations);
+    error = job->error;
+  }
+
+  // seq_cst against wait() publishing itself in waiting before it checks done
+  if (waiting.load() > 0)
+    {
+      {
+        std::lock_guard<std::mutex> lock(sleep_mutex);
+      }
+      wake.notify_all();
+    }
+
+  for (JobHandle& continuation : continuations)
+    {
+      if (error)
+        {
+          std::lock_guard<std::mutex> lock(continuation->mutex);
+          if (!continuation->error)
+            continuation->error = error;
+        }
+      if (continuation->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        push(std::move(continuation));
+    }
+}
+
+void SngoEngine::Core::Utils::EngineJobSystem::worker_loop(uint32_t self)
+{
+  tls_system = this;
+  tls_worker = self;
+  Worker& worker{*workers[self]};
+
+  while (true)
+    {
+      bool stolen;
+      if (JobHandle job{find_job(self, stolen)})
+        {
+          execute(job, worker.counters, stolen);
+          continue;
+        }
+
+      const auto start{std::chrono::steady_clock::now()};
+      {
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [this] { return stopping || queued.load(std::memory_order_acquire) > 0; });
+        if (stopping && queued.load(std::memory_order_acquire) == 0)
+          break;
+      }
+      worker.counters.idle_ns.fetch_add(Elapsed_Ns(start), std::memory_order_relaxed);
+    }
+}
+
+void SngoEngine::Core::Utils::EngineJobSystem::wait(const JobHandle& job)
+{
+  if (!job)
+    return;
+
+  const uint32_t self{current_worker()};
+  Counters& counters{self == UINT32_MAX ? external : workers[self]->counters};
+  while (!job->done.load(std::memory_order_acquire))
+    {
+      bool stolen;
+      if (JobHandle other{find_job(self, stolen)})
+        {
+          execute(other, counters, stolen);
+          continue;
+        }
+
+      const auto start{std::chrono::steady_clock::now()};
+      waiting.fetch_add(1);
+      {
+        std::unique_lock<std::mutex> lock(sleep_mutex);
+        wake.wait(lock, [&] {
+          return job->done.load() || queued.load() > 0;
+        });
+      }
+      waiting.fetch_sub(1, std::memory_order_acq_rel);
+      if (tls_depth == 0)
+        counters.idle_ns.fetch_add(Elapsed_Ns(start), std::memory_order_relaxed);
+    }
+
+  std::lock_guard<std::mutex> lock(job->mutex);
+  if (job->error)
+    std::rethrow_exception(job->error);
+}
+
+void SngoEngine::Core::Utils::EngineJobSystem::wait(const std::vector<JobHandle>& jobs)
+{
+  // every job is waited on before the first error is rethrown, nothing may still reference the
+  // caller's stack afterwards
+  std::exception_ptr error;
+  for (const JobHandle& job : jobs)
+    {
+      try
+        {
+          wait(job);
+        }
+      catch (...)
+        {
+          if (!error)
+            error = std::current_exception();
+        }
+    }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+void SngoEngine::Core::Utils::EngineJobSystem::parallel_for(
+    size_t count,
+    size_t grain,
+    const std::function<void(size_t, size_t)>& fn)
+{
+  if (count == 0)
+    return;
+  grain = std::max<size_t>(grain, 1);
+  if (count <= grain)
+    {
+      fn(0, count);
+      return;
+    }
+
+  std::vector<JobHandle> jobs;
+  jobs.reserve((count + grain - 1) / grain - 1);
+  for (size_t begin = grain; begin < count; begin += grain)
+    {
+      const size_t end{std::min(begin + grain, count)};
+      jobs.push_back(schedule([&fn, begin, end]() { fn(begin, end); }));
+    }
+
+  // the caller takes the first range instead of idling
+  std::exception_ptr error;
+  try
+    {
+      fn(0, grain);
+    }
+  catch (...)
+    {
+      error = std::current_exception();
+    }
+  try
+    {
+      wait(jobs);
+    }
+  catch (...)
+    {
+      if (!error)
+        error = std::current_exception();
+    }
+  if (error)
+    std::rethrow_exception(error);
+}
+
+std::vector<SngoEngine::Core::Utils::JobWorkerStats>
+SngoEngine::Core::Utils::EngineJobSystem::stats() const
+{
+  auto snapshot = [](const Counters& counters) {
+    JobWorkerStats stat{};
+    stat.executed = counters.executed.load(std::memory_order_relaxed);
+    stat.stolen = counters.stolen.load(std::memory_order_relaxed);
+    stat.busy_ms = static_cast<double>(counters.busy_ns.load(std::memory_order_relaxed)) * 1e-6;
+    stat.idle_ms = static_cast<double>(counters.idle_ns.load(std::memory_order_relaxed)) * 1e-6;
+    return stat;
+  };
+
+  std::vector<JobWorkerStats> res;
+  for (const auto& worker : workers)
+    res.push_back(snapshot(worker->counters));
+  res.push_back(snapshot(external));
+  return res;
+}
+
+void SngoEngine::Core::Utils::EngineJobSystem::reset_stats()
+{
+  auto reset = [](Counters& counters) {
+    counters.executed.store(0, std::memory_order_relaxed);
+    counters.stolen.store(0, std::memory_order_relaxed);
+    counters.busy_ns.store(0, std::memory_order_relaxed);
+    counters.idle_ns.store(0, std::memory_order_relaxed);
+  };
+  for (auto& worker : workers)
+    reset(worker->counters);
+  reset(external);
+}
+
+SngoEngine::Core::Utils::EngineJobSystem& SngoEngine::Core::Utils::Job_System()
+{
+  static EngineJobSystem system{0};
+  return system;
+}
@@ -0,0 +1,141 @@
+#ifndef __SNGO_JOBSYSTEM_H
+#define __SNGO_JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace SngoEngine::Core::Utils
+{
+
+//===========================================================================================================================
+// EngineJobSystem
+//===========================================================================================================================
+
+struct Job
+{
+  std::function<void()> fn;
+  // unfinished dependencies, plus one while the job is being scheduled
+  std::atomic<uint32_t> pending{1};
+  std::atomic<bool> done{};
+
+  std::mutex mutex;
+  // jobs waiting on this one, released when it finishes
+  std::vector<std::shared_ptr<Job>> continuations;
+  // thrown by fn, or inherited from a failed dependency in which case fn is skipped
+  std::exception_ptr error;
+};
+using JobHandle = std::shared_ptr<Job>;
+
+struct JobWorkerStats
+{
+  uint64_t executed{};
+  // executed jobs taken from another worker's queue
+  uint64_t stolen{};
+  double busy_ms{};
+  double idle_ms{};
+};
+
+// Work-stealing thread pool. Every worker owns a deque, it pushes and pops jobs at the back and
+// idle workers steal from the front of the others. Threads outside the pool hand jobs to the
+// workers round robin.
+//
+// A job runs once all of its dependencies finished, the last one to finish queues it, so a
+// continuation never blocks a thread. wait() is the only blocking call and it keeps executing
+// queued jobs until the handle is done, which makes waiting from inside a job (nested
+// parallel_for) safe.
+struct EngineJobSystem
+{
+  EngineJobSystem() = default;
+  EngineJobSystem(const EngineJobSystem&) = delete;
+  EngineJobSystem& operator=(const EngineJobSystem&) = delete;
+  // 0 workers sizes the pool to the hardware threads minus the one calling wait()
+  explicit EngineJobSystem(uint32_t worker_count)
+  {
+    creator(worker_count);
+  }
+  void init(uint32_t worker_count = 0)
+  {
+    destroyer();
+    creator(worker_count);
+  }
+  ~EngineJobSystem()
+  {
+    destroyer();
+  }
+  // finishes the queued jobs, then joins the workers
+  void destroyer();
+
+  JobHandle schedule(std::function<void()> fn, const std::vector<JobHandle>& dependencies = {});
+  JobHandle then(const JobHandle& dependency, std::function<void()> fn)
+  {
+    return schedule(std::move(fn), {dependency});
+  }
+  // rethrows the exception of the job or of the dependency that failed it
+  void wait(const JobHandle& job);
+  void wait(const std::vector<JobHandle>& jobs);
+
+  // fn(begin, end) over [0, count) in ranges of grain elements, returns once all of them ran
+  void parallel_for(size_t count, size_t grain, const std::function<void(size_t, size_t)>& fn);
+
+  [[nodiscard]] uint32_t worker_count() const
+  {
+    return static_cast<uint32_t>(workers.size());
+  }
+  // one entry per worker, the last one adds up the threads outside the pool helping in wait()
+  [[nodiscard]] std::vector<JobWorkerStats> stats() const;
+  void reset_stats();
+
+ private:
+  void creator(uint32_t worker_count);
+
+  struct Counters
+  {
+    std::atomic<uint64_t> executed{};
+    std::atomic<uint64_t> stolen{};
+    std::atomic<uint64_t> busy_ns{};
+    std::atomic<uint64_t> idle_ns{};
+  };
+
+  struct Worker
+  {
+    std::mutex mutex;
+    std::deque<JobHandle> jobs;
+    std::thread thread;
+    Counters counters;
+  };
+
+  void push(JobHandle job);
+  // own queue first (newest job), then the others (oldest job)
+  JobHandle find_job(uint32_t self, bool& stolen);
+  void execute(const JobHandle& job, Counters& counters, bool stolen);
+  void finish(const JobHandle& job);
+  void worker_loop(uint32_t self);
+  [[nodiscard]] uint32_t current_worker() const;
+
+  std::vector<std::unique_ptr<Worker>> workers;
+  Counters external;
+  std::atomic<uint32_t> next_worker{};
+
+  // jobs sitting in any queue, idle workers sleep while it is 0
+  std::atomic<size_t> queued{};
+  std::atomic<uint32_t> waiting{};
+  std::mutex sleep_mutex;
+  std::condition_variable wake;
+  bool stopping{};
+};
+
+// the engine-wide pool, sized to the hardware on first use
+EngineJobSystem& Job_System();
+
+}  // namespace SngoEngine::Core::Utils
+
+#endif
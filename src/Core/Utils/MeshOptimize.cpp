@@ -0,0 +1,330 @@
+#include "MeshOptimize.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+
+//===========================================================================================================================
+// cache analysis
+//===========================================================================================================================
+
+SngoEngine::Core::Utils::VertexCacheStats SngoEngine::Core::Utils::Analyze_VertexCache(
+    const uint32_t* indices,
+    size_t index_count,
+    uint32_t vertex_count,
+    uint32_t cache_size)
+{
+  // a vertex is cached while fewer than cache_size misses happened since it was loaded
+  std::vector<uint64_t> loaded_at(vertex_count, 0);
+  std::vector<uint8_t> referenced(vertex_count, 0);
+  uint64_t misses{0};
+
+  for (size_t i = 0; i < index_count; i++)
+    {
+      const uint32_t v{indices[i]};
+      referenced[v] = 1;
+      if (loaded_at[v] == 0 || misses - loaded_at[v] + 1 > cache_size)
+        {
+          misses++;
+          loaded_at[v] = misses;
+        }
+    }
+
+  const size_t used{static_cast<size_t>(std::count(referenced.begin(), referenced.end(), 1))};
+  VertexCacheStats stats{};
+  if (index_count >= 3)
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(index_count / 3);
+  if (used)
+    stats.atvr = static_cast<float>(misses) / static_cast<float>(used);
+  return stats;
+}
+
+//===========================================================================================================================
+// Optimize_VertexCache
+//===========================================================================================================================
+
+namespace
+{
+struct TriangleAdjacency
+{
+  std::vector<uint32_t> offsets{};
+  std::vector<uint32_t> triangles{};
+  std::vector<uint32_t> counts{};
+
+  TriangleAdjacency(const uint32_t* indices, size_t index_count, uint32_t vertex_count)
+      : offsets(vertex_count + 1, 0), triangles(index_count), counts(vertex_count, 0)
+  {
+    for (size_t i = 0; i < index_count; i++)
+      counts[indices[i]]++;
+    for (uint32_t v = 0; v < vertex_count; v++)
+      offsets[v + 1] = offsets[v] + counts[v];
+
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < index_count; i++)
+      triangles[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+  }
+};
+}  // namespace
+
+std::vector<uint32_t> SngoEngine::Core::Utils::Optimize_VertexCache(uint32_t* indices,
+                                                                    size_t index_count,
+                                                                    uint32_t vertex_count,
+                                                                    uint32_t cache_size)
+{
+  const size_t triangle_count{index_count / 3};
+  std::vector<uint32_t> clusters;
+  if (triangle_count == 0)
+    return clusters;
+
+  TriangleAdjacency adjacency{indices, triangle_count * 3, vertex_count};
+  std::vector<uint32_t>& live{adjacency.counts};
+  std::vector<uint32_t> cache_time(vertex_count, 0);
+  std::vector<uint8_t> emitted(triangle_count, 0);
+  std::vector<uint32_t> dead_end;
+  std::vector<uint32_t> candidates;
+  std::vector<uint32_t> output;
+  output.reserve(triangle_count * 3);
+
+  uint32_t time{cache_size + 1};
+  uint32_t cursor{0};
+  int64_t fan{indices[0]};
+  clusters.push_back(0);
+
+  while (fan >= 0)
+    {
+      candidates.clear();
+      const auto f{static_cast<uint32_t>(fan)};
+      for (uint32_t a = adjacency.offsets[f]; a < adjacency.offsets[f + 1]; a++)
+        {
+          const uint32_t t{adjacency.triangles[a]};
+          if (emitted[t])
+            continue;
+          emitted[t] = 1;
+          for (uint32_t c = 0; c < 3; c++)
+            {
+              const uint32_t v{indices[3 * t + c]};
+              output.push_back(v);
+              dead_end.push_back(v);
+              candidates.push_back(v);
+              live[v]--;
+              if (time - cache_time[v] > cache_size)
+                cache_time[v] = time++;
+            }
+        }
+
+      // the candidate that stays in cache with the most of its triangles left wins
+      fan = -1;
+      int64_t best_priority{-1};
+      for (uint32_t v : candidates)
+        {
+          if (live[v] == 0)
+            continue;
+          int64_t priority{0};
+          if (time - cache_time[v] + 2 * live[v] <= cache_size)
+            priority = time - cache_time[v];
+          if (priority > best_priority)
+            {
+              best_priority = priority;
+              fan = v;
+            }
+        }
+      if (fan >= 0)
+        continue;
+
+      // dead end: walk back through recently emitted vertices, then scan for any live one
+      while (!dead_end.empty() && fan < 0)
+        {
+          const uint32_t v{dead_end.back()};
+          dead_end.pop_back();
+          if (live[v] > 0)
+            fan = v;
+        }
+      while (fan < 0 && cursor < vertex_count)
+        {
+          if (live[cursor] > 0)
+            fan = cursor;
+          cursor++;
+        }
+      if (fan >= 0)
+        clusters.push_back(static_cast<uint32_t>(output.size() / 3));
+    }
+
+  std::copy(output.begin(), output.end(), indices);
+  return clusters;
+}
+
+//===========================================================================================================================
+// Optimize_Overdraw
+//===========================================================================================================================
+
+namespace
+{
+// FIFO misses of [begin, end) triangles with a cache that starts empty
+uint32_t count_misses(const uint32_t* indices,
+                      uint32_t begin,
+                      uint32_t end,
+                      std::vector<uint32_t>& loaded_at,
+                      uint32_t& stamp,
+                      uint32_t cache_size)
+{
+  // loaded_at values of earlier calls are at least stamp behind and count as misses
+  const uint32_t base{stamp};
+  uint32_t misses{0};
+  for (uint32_t i = 3 * begin; i < 3 * end; i++)
+    {
+      const uint32_t v{indices[i]};
+      if (loaded_at[v] <= base || stamp - loaded_at[v] + 1 > cache_size)
+        {
+          misses++;
+          loaded_at[v] = ++stamp;
+        }
+    }
+  stamp += cache_size + 1;
+  return misses;
+}
+}  // namespace
+
+void SngoEngine::Core::Utils::Optimize_Overdraw(uint32_t* indices,
+                                                size_t index_count,
+                                                const float* positions,
+                                                uint32_t vertex_count,
+                                                const std::vector<uint32_t>& clusters,
+                                                uint32_t cache_size,
+                                                float threshold)
+{
+  const auto triangle_count{static_cast<uint32_t>(index_count / 3)};
+  if (triangle_count == 0 || clusters.empty())
+    return;
+
+  // soft boundaries: inside a hard cluster, cut wherever the ACMR of the running piece already
+  // matches the cluster's ACMR, restarting the cache there costs little
+  std::vector<uint32_t> loaded_at(vertex_count, 0);
+  uint32_t stamp{0};
+  std::vector<uint32_t> bounds;
+  for (size_t c = 0; c < clusters.size(); c++)
+    {
+      const uint32_t begin{clusters[c]};
+      const uint32_t end{c + 1 < clusters.size() ? clusters[c + 1] : triangle_count};
+      const float cluster_acmr{
+          static_cast<float>(count_misses(indices, begin, end, loaded_at, stamp, cache_size))
+          / static_cast<float>(end - begin)};
+
+      bounds.push_back(begin);
+      uint32_t piece_start{begin};
+      uint32_t misses{0};
+      const uint32_t base{stamp};
+      for (uint32_t t = begin; t < end; t++)
+        {
+          for (uint32_t k = 0; k < 3; k++)
+            {
+              const uint32_t v{indices[3 * t + k]};
+              if (loaded_at[v] <= base || stamp - loaded_at[v] + 1 > cache_size)
+                {
+                  misses++;
+                  loaded_at[v] = ++stamp;
+                }
+            }
+          const auto piece_triangles{static_cast<float>(t + 1 - piece_start)};
+          if (t + 1 < end
+              && static_cast<float>(misses) / piece_triangles <= cluster_acmr * threshold)
+            {
+              bounds.push_back(t + 1);
+              piece_start = t + 1;
+              misses = 0;
+              stamp += cache_size + 1;
+            }
+        }
+      stamp += cache_size + 1;
+    }
+  bounds.push_back(triangle_count);
+
+  // sort key: how far the cluster sits out along its own average normal
+  auto vertex = [&](uint32_t v) {
+    return std::array<float, 3>{positions[3 * v], positions[3 * v + 1], positions[3 * v + 2]};
+  };
+  std::array<double, 3> mesh_centroid{};
+  for (size_t i = 0; i < index_count; i++)
+    {
+      const auto p{vertex(indices[i])};
+      for (int k = 0; k < 3; k++)
+        mesh_centroid[k] += p[k];
+    }
+  for (double& m : mesh_centroid)
+    m /= static_cast<double>(triangle_count) * 3.0;
+
+  const size_t cluster_count{bounds.size() - 1};
+  std::vector<float> sort_key(cluster_count, 0.0f);
+  for (size_t c = 0; c < cluster_count; c++)
+    {
+      std::array<double, 3> centroid{}, normal{};
+      double area_sum{0.0};
+      for (uint32_t t = bounds[c]; t < bounds[c + 1]; t++)
+        {
+          const auto a{vertex(indices[3 * t])};
+          const auto b{vertex(indices[3 * t + 1])};
+          const auto d{vertex(indices[3 * t + 2])};
+          const double e1[3]{b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+          const double e2[3]{d[0] - a[0], d[1] - a[1], d[2] - a[2]};
+          const double n[3]{e1[1] * e2[2] - e1[2] * e2[1],
+                            e1[2] * e2[0] - e1[0] * e2[2],
+                            e1[0] * e2[1] - e1[1] * e2[0]};
+          const double area{std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2])};
+          for (int k = 0; k < 3; k++)
+            {
+              centroid[k] += (a[k] + b[k] + d[k]) / 3.0 * area;
+              normal[k] += n[k];
+            }
+          area_sum += area;
+        }
+      if (area_sum <= 0.0)
+        continue;
+      const double length{
+          std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2])};
+      double key{0.0};
+      for (int k = 0; k < 3; k++)
+        {
+          const double direction{length > 0.0 ? normal[k] / length : 0.0};
+          key += (centroid[k] / area_sum - mesh_centroid[k]) * direction;
+        }
+      sort_key[c] = static_cast<float>(key);
+    }
+
+  std::vector<uint32_t> order(cluster_count);
+  std::iota(order.begin(), order.end(), 0u);
+  std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+    return sort_key[a] > sort_key[b];
+  });
+
+  std::vector<uint32_t> sorted;
+  sorted.reserve(size_t{triangle_count} * 3);
+  for (uint32_t c : order)
+    sorted.insert(sorted.end(), indices + 3 * bounds[c], indices + 3 * bounds[c + 1]);
+  std::copy(sorted.begin(), sorted.end(), indices);
+}
+
+//===========================================================================================================================
+// Optimize_VertexFetch
+//===========================================================================================================================
+
+std::vector<uint32_t> SngoEngine::Core::Utils::Optimize_VertexFetch(uint32_t* indices,
+                                                                    size_t index_count,
+                                                                    uint32_t vertex_count)
+{
+  constexpr uint32_t unused{UINT32_MAX};
+  std::vector<uint32_t> remap(vertex_count, unused);
+  uint32_t next{0};
+  for (size_t i = 0; i < index_count; i++)
+    {
+      uint32_t& id{remap[indices[i]]};
+      if (id == unused)
+        id = next++;
+      indices[i] = id;
+    }
+  for (uint32_t& id : remap)
+    {
+      if (id == unused)
+        id = next++;
+    }
+  return remap;
+}
@@ -0,0 +1,164 @@
+#ifndef __SNGO_MESHOPTIMIZE_H
+#define __SNGO_MESHOPTIMIZE_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "fmt/core.h"
+
+namespace SngoEngine::Core::Utils
+{
+
+//===========================================================================================================================
+// cache analysis
+//===========================================================================================================================
+
+struct VertexCacheStats
+{
+  // transformed vertices per triangle, 0.5 is the ideal, 3 the worst
+  float acmr{};
+  // transformed vertices per referenced vertex, 1 is the ideal
+  float atvr{};
+};
+
+// simulates a FIFO post-transform cache of cache_size entries over a triangle list
+VertexCacheStats Analyze_VertexCache(const uint32_t* indices,
+                                     size_t index_count,
+                                     uint32_t vertex_count,
+                                     uint32_t cache_size = 16);
+
+//===========================================================================================================================
+// optimization passes
+//===========================================================================================================================
+
+// Tipsify (Sander et al. 2007) triangle reorder for a cache of cache_size entries, returns the
+// first triangle of every hard cluster (a point where the cache is effectively flushed)
+std::vector<uint32_t> Optimize_VertexCache(uint32_t* indices,
+                                           size_t index_count,
+                                           uint32_t vertex_count,
+                                           uint32_t cache_size = 16);
+
+// splits the Tipsify clusters where their ACMR allows (threshold 1.05 costs at most 5% ACMR) and
+// sorts them front-facing-outwards first, so near-convex parts occlude the rest of the mesh
+void Optimize_Overdraw(uint32_t* indices,
+                       size_t index_count,
+                       const float* positions,
+                       uint32_t vertex_count,
+                       const std::vector<uint32_t>& clusters,
+                       uint32_t cache_size = 16,
+                       float threshold = 1.05f);
+
+// renumbers vertices in first-use order and rewrites indices, remap[old] = new; unreferenced
+// vertices keep their relative order after the referenced ones
+std::vector<uint32_t> Optimize_VertexFetch(uint32_t* indices,
+                                           size_t index_count,
+                                           uint32_t vertex_count);
+
+template <typename V>
+void Remap_Vertices(V* vertices, uint32_t vertex_count, const std::vector<uint32_t>& remap)
+{
+  std::vector<V> old(vertices, vertices + vertex_count);
+  for (uint32_t v = 0; v < vertex_count; v++)
+    vertices[remap[v]] = old[v];
+}
+
+//===========================================================================================================================
+// Optimize_Mesh
+//===========================================================================================================================
+
+struct MeshOptimizeStats
+{
+  size_t triangles{};
+  VertexCacheStats before{};
+  VertexCacheStats after{};
+  double ms{};
+
+  void accumulate(const MeshOptimizeStats& other)
+  {
+    const auto t{static_cast<float>(triangles)};
+    const auto o{static_cast<float>(other.triangles)};
+    auto mix = [&](float a, float b) { return t + o > 0 ? (a * t + b * o) / (t + o) : 0.0f; };
+    before = {mix(before.acmr, other.before.acmr), mix(before.atvr, other.before.atvr)};
+    after = {mix(after.acmr, other.after.acmr), mix(after.atvr, other.after.atvr)};
+    triangles += other.triangles;
+    ms += other.ms;
+  }
+  void print(const char* what) const
+  {
+    fmt::println("{}: {} triangles, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}, "
+                 "{:.2f} ms ({:.2f} ms / M triangles)",
+                 what,
+                 triangles,
+                 before.acmr,
+                 after.acmr,
+                 before.atvr,
+                 after.atvr,
+                 ms,
+                 triangles ? ms * 1e6 / static_cast<double>(triangles) : 0.0);
+  }
+};
+
+// cache reorder, overdraw cluster sort and fetch remap of one triangle list whose indices are
+// relative to vertices[0]; V needs a glm::vec3-like pos member
+template <typename V>
+MeshOptimizeStats Optimize_Mesh(V* vertices,
+                                uint32_t vertex_count,
+                                uint32_t* indices,
+                                size_t index_count)
+{
+  using Clock = std::chrono::steady_clock;
+  MeshOptimizeStats stats{};
+  stats.triangles = index_count / 3;
+  if (index_count < 3 || vertex_count == 0)
+    return stats;
+
+  const auto t0{Clock::now()};
+  stats.before = Analyze_VertexCache(indices, index_count, vertex_count);
+
+  std::vector<float> positions(size_t{vertex_count} * 3);
+  for (uint32_t v = 0; v < vertex_count; v++)
+    {
+      positions[3 * v + 0] = vertices[v].pos.x;
+      positions[3 * v + 1] = vertices[v].pos.y;
+      positions[3 * v + 2] = vertices[v].pos.z;
+    }
+
+  const auto clusters{Optimize_VertexCache(indices, index_count, vertex_count)};
+  Optimize_Overdraw(indices, index_count, positions.data(), vertex_count, clusters);
+  Remap_Vertices(vertices, vertex_count, Optimize_VertexFetch(indices, index_count, vertex_count));
+
+  stats.after = Analyze_VertexCache(indices, index_count, vertex_count);
+  stats.ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+  return stats;
+}
+
+// the same for a whole indexed mesh of any index type, e.g. the output of Load_Vetex_Index
+template <typename V, typename I>
+MeshOptimizeStats Optimize_Mesh(std::vector<V>& vertices, std::vector<I>& indices)
+{
+  if constexpr (std::is_same_v<I, uint32_t>)
+    {
+      return Optimize_Mesh(vertices.data(),
+                           static_cast<uint32_t>(vertices.size()),
+                           indices.data(),
+                           indices.size() - indices.size() % 3);
+    }
+  else
+    {
+      std::vector<uint32_t> wide(indices.begin(), indices.end());
+      auto stats{Optimize_Mesh(vertices.data(),
+                               static_cast<uint32_t>(vertices.size()),
+                               wide.data(),
+                               wide.size() - wide.size() % 3)};
+      for (size_t i = 0; i < wide.size(); i++)
+        indices[i] = static_cast<I>(wide[i]);
+      return stats;
+    }
+}
+
+}  // namespace SngoEngine::Core::Utils
+
+#endif
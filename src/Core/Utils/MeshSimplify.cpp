@@ -0,0 +1,334 @@
+#include "MeshSimplify.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+#include "src/Core/Utils/MeshOptimize.hpp"
+#include "src/Core/Utils/Math.hpp"
+
+//===========================================================================================================================
+// Simplify_Mesh
+//===========================================================================================================================
+
+namespace
+{
+// symmetric 4x4 plane quadric: xx xy xz xw yy yz yw zz zw ww, plus the accumulated area
+struct Quadric
+{
+  std::array<double, 10> q{};
+  double weight{};
+
+  void add_plane(const double n[3], double d, double w)
+  {
+    const double p[4]{n[0], n[1], n[2], d};
+    size_t k{0};
+    for (int i = 0; i < 4; i++)
+      for (int j = i; j < 4; j++)
+        q[k++] += w * p[i] * p[j];
+    weight += w;
+  }
+  void add(const Quadric& other)
+  {
+    for (size_t k = 0; k < q.size(); k++)
+      q[k] += other.q[k];
+    weight += other.weight;
+  }
+  // mean squared distance of p to the accumulated planes
+  [[nodiscard]] double error(const float* p) const
+  {
+    const double x{p[0]}, y{p[1]}, z{p[2]};
+    const double e{q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x
+                   + q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y + q[7] * z * z
+                   + 2 * q[8] * z + q[9]};
+    return weight > 0.0 ? std::max(e, 0.0) / weight : 0.0;
+  }
+};
+
+struct Collapse
+{
+  uint32_t from;
+  uint32_t to;
+  double cost;
+};
+
+void triangle_normal(const float* a, const float* b, const float* c, double n[3])
+{
+  const double e1[3]{double(b[0]) - a[0], double(b[1]) - a[1], double(b[2]) - a[2]};
+  const double e2[3]{double(c[0]) - a[0], double(c[1]) - a[1], double(c[2]) - a[2]};
+  n[0] = e1[1] * e2[2] - e1[2] * e2[1];
+  n[1] = e1[2] * e2[0] - e1[0] * e2[2];
+  n[2] = e1[0] * e2[1] - e1[1] * e2[0];
+}
+
+uint64_t edge_key(uint32_t a, uint32_t b)
+{
+  return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+}
+}  // namespace
+
+std::vector<uint32_t> SngoEngine::Core::Utils::Simplify_Mesh(const uint32_t* indices,
+                                                             size_t index_count,
+                                                             const float* positions,
+                                                             const float* attributes,
+                                                             uint32_t attribute_count,
+                                                             uint32_t vertex_count,
+                                                             size_t target_index_count,
+                                                             float max_error,
+                                                             float* result_error)
+{
+  std::vector<uint32_t> result(indices, indices + index_count - index_count % 3);
+  if (result_error)
+    *result_error = 0.0f;
+  if (result.size() <= target_index_count)
+    return result;
+
+  const float* pos{positions};
+  auto p = [pos](uint32_t v) { return pos + 3 * size_t{v}; };
+
+  // vertices sharing a position are one topological vertex, attribute seams get locked
+  std::vector<uint32_t> welded(vertex_count);
+  std::vector<uint8_t> locked(vertex_count, 0);
+  {
+    struct PositionHash
+    {
+      size_t operator()(const std::array<float, 3>& k) const
+      {
+        return Math::HashBuffer(k.data(), sizeof(k));
+      }
+    };
+    std::unordered_map<std::array<float, 3>, uint32_t, PositionHash> first;
+    first.reserve(vertex_count);
+    for (uint32_t v = 0; v < vertex_count; v++)
+      {
+        auto [it, inserted] = first.try_emplace({p(v)[0], p(v)[1], p(v)[2]}, v);
+        welded[v] = it->second;
+        if (!inserted)
+          locked[v] = locked[it->second] = 1;
+      }
+    for (uint32_t v = 0; v < vertex_count; v++)
+      locked[v] |= locked[welded[v]];
+  }
+
+  // open and non-manifold edges
+  {
+    std::unordered_map<uint64_t, uint32_t> edges;
+    edges.reserve(result.size());
+    for (size_t i = 0; i < result.size(); i += 3)
+      for (int e = 0; e < 3; e++)
+        edges[edge_key(welded[result[i + e]], welded[result[i + (e + 1) % 3]])]++;
+    std::vector<uint8_t> border(vertex_count, 0);
+    for (const auto& [key, count] : edges)
+      {
+        if (count != 2)
+          border[key >> 32] = border[key & 0xFFFFFFFFu] = 1;
+      }
+    for (uint32_t v = 0; v < vertex_count; v++)
+      locked[v] |= border[welded[v]];
+  }
+
+  std::vector<Quadric> quadrics(vertex_count);
+  for (size_t i = 0; i < result.size(); i += 3)
+    {
+      double n[3];
+      triangle_normal(p(result[i]), p(result[i + 1]), p(result[i + 2]), n);
+      const double area{std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2])};
+      if (area <= 0.0)
+        continue;
+      for (double& c : n)
+        c /= area;
+      const float* pa{p(result[i])};
+      const double d{-(n[0] * pa[0] + n[1] * pa[1] + n[2] * pa[2])};
+      for (int k = 0; k < 3; k++)
+        quadrics[result[i + k]].add_plane(n, d, area);
+    }
+
+  auto attribute_cost = [&](uint32_t a, uint32_t b) {
+    double cost{0.0};
+    for (uint32_t k = 0; k < attribute_count; k++)
+      {
+        const double d{double(attributes[size_t{a} * attribute_count + k])
+                       - attributes[size_t{b} * attribute_count + k]};
+        cost += d * d;
+      }
+    return cost;
+  };
+
+  const double error_limit{double(max_error) * max_error};
+  double worst{0.0};
+  std::vector<Collapse> candidates;
+  std::vector<uint32_t> adjacency_offsets, adjacency;
+  std::vector<uint8_t> touched(vertex_count);
+  std::vector<uint32_t> collapse_to(vertex_count);
+
+  while (result.size() > target_index_count)
+    {
+      candidates.clear();
+      for (size_t i = 0; i < result.size(); i += 3)
+        for (int e = 0; e < 3; e++)
+          {
+            const uint32_t a{result[i + e]}, b{result[i + (e + 1) % 3]};
+            for (auto [from, to] : {std::pair{a, b}, std::pair{b, a}})
+              {
+                if (locked[from] || from == to)
+                  continue;
+                Quadric q{quadrics[from]};
+                q.add(quadrics[to]);
+                candidates.push_back({from, to, q.error(p(to)) + attribute_cost(from, to)});
+              }
+          }
+      if (candidates.empty())
+        break;
+      std::sort(candidates.begin(), candidates.end(), [](const Collapse& l, const Collapse& r) {
+        return l.cost < r.cost;
+      });
+
+      // vertex -> triangle adjacency of the current result
+      adjacency_offsets.assign(vertex_count + 1, 0);
+      for (uint32_t v : result)
+        adjacency_offsets[v + 1]++;
+      for (uint32_t v = 0; v < vertex_count; v++)
+        adjacency_offsets[v + 1] += adjacency_offsets[v];
+      adjacency.resize(result.size());
+      {
+        std::vector<uint32_t> fill(adjacency_offsets.begin(), adjacency_offsets.end() - 1);
+        for (size_t i = 0; i < result.size(); i++)
+          adjacency[fill[result[i]]++] = static_cast<uint32_t>(i / 3);
+      }
+
+      std::fill(touched.begin(), touched.end(), 0);
+      for (uint32_t v = 0; v < vertex_count; v++)
+        collapse_to[v] = v;
+
+      size_t triangles_left{result.size() / 3};
+      const size_t target_triangles{target_index_count / 3};
+      size_t collapses{0};
+      for (const Collapse& c : candidates)
+        {
+          if (c.cost > error_limit || triangles_left <= target_triangles)
+            break;
+          if (touched[c.from] || touched[c.to])
+            continue;
+
+          // reject collapses that flip or squash a triangle around the removed vertex
+          bool valid{true};
+          size_t removed{0};
+          for (uint32_t a = adjacency_offsets[c.from]; a < adjacency_offsets[c.from + 1]; a++)
+            {
+              const uint32_t* tri{&result[3 * size_t{adjacency[a]}]};
+              if (tri[0] == c.to || tri[1] == c.to || tri[2] == c.to)
+                {
+                  removed++;
+                  continue;
+                }
+              const float* corners[3]{p(tri[0]), p(tri[1]), p(tri[2])};
+              double before[3], after[3];
+              triangle_normal(corners[0], corners[1], corners[2], before);
+              for (auto& corner : corners)
+                {
+                  if (corner == p(c.from))
+                    corner = p(c.to);
+                }
+              triangle_normal(corners[0], corners[1], corners[2], after);
+              const double dot{before[0] * after[0] + before[1] * after[1] + before[2] * after[2]};
+              const double lengths{
+                  std::sqrt(before[0] * before[0] + before[1] * before[1] + before[2] * before[2])
+                  * std::sqrt(after[0] * after[0] + after[1] * after[1] + after[2] * after[2])};
+              if (dot <= 0.25 * lengths)
+                {
+                  valid = false;
+                  break;
+                }
+            }
+          if (!valid)
+            continue;
+
+          // everything around from is rewritten this pass, keep it stable until the next one
+          for (uint32_t a = adjacency_offsets[c.from]; a < adjacency_offsets[c.from + 1]; a++)
+            for (int k = 0; k < 3; k++)
+              touched[result[3 * size_t{adjacency[a]} + k]] = 1;
+          collapse_to[c.from] = c.to;
+          quadrics[c.to].add(quadrics[c.from]);
+          worst = std::max(worst, c.cost);
+          triangles_left -= removed;
+          collapses++;
+        }
+      if (collapses == 0)
+        break;
+
+      size_t out{0};
+      for (size_t i = 0; i < result.size(); i += 3)
+        {
+          const uint32_t a{collapse_to[result[i]]}, b{collapse_to[result[i + 1]]},
+              c{collapse_to[result[i + 2]]};
+          if (a == b || b == c || a == c)
+            continue;
+          result[out++] = a;
+          result[out++] = b;
+          result[out++] = c;
+        }
+      result.resize(out);
+    }
+
+  if (result_error)
+    *result_error = static_cast<float>(std::sqrt(worst));
+  return result;
+}
+
+//===========================================================================================================================
+// Build_LodChain
+//===========================================================================================================================
+
+std::vector<SngoEngine::Core::Utils::MeshLod> SngoEngine::Core::Utils::Build_LodChain(
+    const uint32_t* indices,
+    size_t index_count,
+    const float* positions,
+    const float* attributes,
+    uint32_t attribute_count,
+    uint32_t vertex_count,
+    uint32_t max_levels)
+{
+  std::vector<MeshLod> lods;
+  if (index_count < 3 || vertex_count == 0)
+    return lods;
+
+  // coarse levels may move the surface by up to a tenth of the mesh extent
+  std::array<float, 3> lo{positions[0], positions[1], positions[2]}, hi{lo};
+  for (uint32_t v = 0; v < vertex_count; v++)
+    for (int k = 0; k < 3; k++)
+      {
+        lo[k] = std::min(lo[k], positions[3 * size_t{v} + k]);
+        hi[k] = std::max(hi[k], positions[3 * size_t{v} + k]);
+      }
+  const float extent{std::sqrt((hi[0] - lo[0]) * (hi[0] - lo[0]) + (hi[1] - lo[1]) * (hi[1] - lo[1])
+                               + (hi[2] - lo[2]) * (hi[2] - lo[2]))};
+
+  const uint32_t* source{indices};
+  size_t source_count{index_count};
+  for (uint32_t level = 0; level < max_levels; level++)
+    {
+      const size_t target{(source_count / 3 / 2) * 3};
+      MeshLod lod{};
+      lod.indices = Simplify_Mesh(source,
+                                  source_count,
+                                  positions,
+                                  attributes,
+                                  attribute_count,
+                                  vertex_count,
+                                  target,
+                                  0.1f * extent,
+                                  &lod.error);
+      if (lod.indices.empty() || lod.indices.size() * 10 > source_count * 9)
+        break;
+      // every level is simplified from the previous one, so the errors add up
+      if (!lods.empty())
+        lod.error += lods.back().error;
+      Optimize_VertexCache(lod.indices.data(), lod.indices.size(), vertex_count);
+      lods.push_back(std::move(lod));
+      source = lods.back().indices.data();
+      source_count = lods.back().indices.size();
+    }
+  return lods;
+}
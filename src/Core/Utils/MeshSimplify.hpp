@@ -0,0 +1,49 @@
+#ifndef __SNGO_MESHSIMPLIFY_H
+#define __SNGO_MESHSIMPLIFY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SngoEngine::Core::Utils
+{
+
+//===========================================================================================================================
+// Simplify_Mesh
+//===========================================================================================================================
+
+// Quadric error metric simplification by vertex-restricted edge collapse: the result indexes the
+// same vertices, so LODs only cost index memory. attributes holds attribute_count floats per
+// vertex (already weighted) whose squared distance is added to the collapse cost. Open borders,
+// non-manifold edges and vertices split by attribute seams are locked.
+// Stops at target_index_count or when the next collapse moves the surface more than max_error;
+// result_error receives the largest accepted error (position units).
+std::vector<uint32_t> Simplify_Mesh(const uint32_t* indices,
+                                    size_t index_count,
+                                    const float* positions,
+                                    const float* attributes,
+                                    uint32_t attribute_count,
+                                    uint32_t vertex_count,
+                                    size_t target_index_count,
+                                    float max_error,
+                                    float* result_error = nullptr);
+
+struct MeshLod
+{
+  std::vector<uint32_t> indices{};
+  float error{};
+};
+
+// up to max_levels coarser levels, each targeting half the triangles of the previous one;
+// the chain ends early once a level removes less than 10% of the triangles
+std::vector<MeshLod> Build_LodChain(const uint32_t* indices,
+                                    size_t index_count,
+                                    const float* positions,
+                                    const float* attributes,
+                                    uint32_t attribute_count,
+                                    uint32_t vertex_count,
+                                    uint32_t max_levels = 4);
+
+}  // namespace SngoEngine::Core::Utils
+
+#endif
@@ -0,0 +1,273 @@
+#include "Meshlet.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+//===========================================================================================================================
+// Build_Meshlets
+//===========================================================================================================================
+
+namespace
+{
+void compute_bounds(SngoEngine::Core::Utils::Meshlet& meshlet,
+                    const uint32_t* indices,
+                    const std::vector<uint32_t>& vertices,
+                    const float* positions,
+                    const float* normals)
+{
+  auto p = [positions](uint32_t v) { return positions + 3 * size_t{v}; };
+
+  float lo[3]{p(vertices[0])[0], p(vertices[0])[1], p(vertices[0])[2]};
+  float hi[3]{lo[0], lo[1], lo[2]};
+  for (uint32_t v : vertices)
+    for (int k = 0; k < 3; k++)
+      {
+        lo[k] = std::min(lo[k], p(v)[k]);
+        hi[k] = std::max(hi[k], p(v)[k]);
+      }
+  float radius2{0.0f};
+  for (int k = 0; k < 3; k++)
+    meshlet.center[k] = (lo[k] + hi[k]) * 0.5f;
+  for (uint32_t v : vertices)
+    {
+      const float d[3]{p(v)[0] - meshlet.center[0],
+                       p(v)[1] - meshlet.center[1],
+                       p(v)[2] - meshlet.center[2]};
+      radius2 = std::max(radius2, d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    }
+  meshlet.radius = std::sqrt(radius2);
+
+  // unit face normals, averaged into the cone axis
+  float face_normals[SngoEngine::Core::Utils::MESHLET_MAX_TRIANGLES * 2][3];
+  uint32_t face_count{0};
+  float axis[3]{};
+  for (uint32_t t = 0; t < meshlet.triangle_count; t++)
+    {
+      const uint32_t* tri{indices + 3 * size_t{t}};
+      const float* a{p(tri[0])};
+      const float* b{p(tri[1])};
+      const float* c{p(tri[2])};
+      const float e1[3]{b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+      const float e2[3]{c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+      float n[3]{e1[1] * e2[2] - e1[2] * e2[1],
+                 e1[2] * e2[0] - e1[0] * e2[2],
+                 e1[0] * e2[1] - e1[1] * e2[0]};
+      const float length{std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2])};
+      if (length <= 0.0f || face_count == std::size(face_normals))
+        continue;
+      float sign{1.0f / length};
+      if (normals)
+        {
+          float shading{0.0f};
+          for (int k = 0; k < 3; k++)
+            shading += n[k]
+                       * (normals[3 * size_t{tri[0]} + k] + normals[3 * size_t{tri[1]} + k]
+                          + normals[3 * size_t{tri[2]} + k]);
+          if (shading < 0.0f)
+            sign = -sign;
+        }
+      for (int k = 0; k < 3; k++)
+        {
+          face_normals[face_count][k] = n[k] * sign;
+          axis[k] += n[k] * sign;
+        }
+      face_count++;
+    }
+
+  const float axis_length{std::sqrt(axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2])};
+  meshlet.cone_cutoff = 1.0f;
+  if (face_count == 0 || axis_length < 1e-6f)
+    return;
+  float min_dot{1.0f};
+  for (int k = 0; k < 3; k++)
+    meshlet.cone_axis[k] = axis[k] / axis_length;
+  for (uint32_t f = 0; f < face_count; f++)
+    {
+      min_dot = std::min(min_dot,
+                         face_normals[f][0] * meshlet.cone_axis[0]
+                             + face_normals[f][1] * meshlet.cone_axis[1]
+                             + face_normals[f][2] * meshlet.cone_axis[2]);
+    }
+  // a spread of 90 degrees or more always has a triangle facing the viewer
+  if (min_dot > 0.0f)
+    meshlet.cone_cutoff = std::sqrt(1.0f - min_dot * min_dot);
+}
+}  // namespace
+
+std::vector<SngoEngine::Core::Utils::Meshlet> SngoEngine::Core::Utils::Build_Meshlets(
+    uint32_t* indices,
+    size_t index_count,
+    const float* positions,
+    const float* normals,
+    uint32_t vertex_count,
+    uint32_t max_vertices,
+    uint32_t max_triangles)
+{
+  const size_t triangle_count{index_count / 3};
+  std::vector<Meshlet> meshlets;
+  if (triangle_count == 0 || vertex_count == 0)
+    return meshlets;
+  max_vertices = std::max(max_vertices, 3u);
+  max_triangles = std::clamp(max_triangles, 1u, MESHLET_MAX_TRIANGLES * 2);
+
+  // vertex -> triangle adjacency and the number of triangles still waiting on each vertex
+  std::vector<uint32_t> offsets(vertex_count + 1, 0);
+  std::vector<uint32_t> live(vertex_count, 0);
+  for (size_t i = 0; i < triangle_count * 3; i++)
+    live[indices[i]]++;
+  for (uint32_t v = 0; v < vertex_count; v++)
+    offsets[v + 1] = offsets[v] + live[v];
+  std::vector<uint32_t> adjacency(triangle_count * 3);
+  {
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < triangle_count * 3; i++)
+      adjacency[fill[indices[i]]++] = static_cast<uint32_t>(i / 3);
+  }
+
+  std::vector<uint8_t> emitted(triangle_count, 0);
+  // id of the last meshlet a vertex was added to
+  std::vector<uint32_t> owner(vertex_count, UINT32_MAX);
+  std::vector<uint32_t> meshlet_vertices;
+  meshlet_vertices.reserve(max_vertices);
+  std::vector<uint32_t> output;
+  output.reserve(triangle_count * 3);
+
+  Meshlet current{};
+  auto current_id = [&meshlets]() { return static_cast<uint32_t>(meshlets.size()); };
+  auto new_vertices = [&](uint32_t t) {
+    const uint32_t* tri{indices + 3 * size_t{t}};
+    const uint32_t id{current_id()};
+    return uint32_t{owner[tri[0]] != id} + uint32_t{owner[tri[1]] != id && tri[1] != tri[0]}
+           + uint32_t{owner[tri[2]] != id && tri[2] != tri[0] && tri[2] != tri[1]};
+  };
+  auto finish = [&]() {
+    if (current.triangle_count)
+      {
+        compute_bounds(current,
+                       output.data() + 3 * size_t{current.triangle_offset},
+                       meshlet_vertices,
+                       positions,
+                       normals);
+        meshlets.push_back(current);
+      }
+    current = {};
+    current.triangle_offset = static_cast<uint32_t>(output.size() / 3);
+    meshlet_vertices.clear();
+  };
+
+  size_t cursor{0};
+  for (size_t done = 0; done < triangle_count; done++)
+    {
+      // prefer the neighbour adding the fewest vertices, then the one closing most fans
+      int64_t best{-1};
+      uint32_t best_new{4}, best_live{UINT32_MAX};
+      for (uint32_t v : meshlet_vertices)
+        {
+          if (live[v] == 0)
+            continue;
+          for (uint32_t a = offsets[v]; a < offsets[v + 1]; a++)
+            {
+              const uint32_t t{adjacency[a]};
+              if (emitted[t])
+                continue;
+              const uint32_t* tri{indices + 3 * size_t{t}};
+              const uint32_t added{new_vertices(t)};
+              const uint32_t pending{live[tri[0]] + live[tri[1]] + live[tri[2]]};
+              if (added < best_new || (added == best_new && pending < best_live))
+                {
+                  best = t;
+                  best_new = added;
+                  best_live = pending;
+                }
+            }
+        }
+      if (best < 0)
+        {
+          while (emitted[cursor])
+            cursor++;
+          best = static_cast<int64_t>(cursor);
+          best_new = new_vertices(static_cast<uint32_t>(best));
+        }
+
+      if (current.vertex_count + best_new > max_vertices || current.triangle_count >= max_triangles)
+        finish();
+
+      const auto t{static_cast<uint32_t>(best)};
+      emitted[t] = 1;
+      for (int k = 0; k < 3; k++)
+        {
+          const uint32_t v{indices[3 * size_t{t} + k]};
+          if (owner[v] != current_id())
+            {
+              owner[v] = current_id();
+              meshlet_vertices.push_back(v);
+              current.vertex_count++;
+            }
+          live[v]--;
+          output.push_back(v);
+        }
+      current.triangle_count++;
+    }
+  finish();
+
+  std::copy(output.begin(), output.end(), indices);
+  return meshlets;
+}
+
+//===========================================================================================================================
+// culling
+//===========================================================================================================================
+
+void SngoEngine::Core::Utils::Extract_FrustumPlanes(const float* matrix, float planes[6][4])
+{
+  auto row = [matrix](int r, int c) { return matrix[c * 4 + r]; };
+  // left, right, bottom, top, near (z >= 0), far
+  const int rows[6]{0, 0, 1, 1, 2, 2};
+  const float signs[6]{1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f};
+  for (int p = 0; p < 6; p++)
+    {
+      for (int c = 0; c < 4; c++)
+        {
+          planes[p][c] = (p == 4) ? row(2, c) : row(3, c) + signs[p] * row(rows[p], c);
+        }
+      const float length{std::sqrt(planes[p][0] * planes[p][0] + planes[p][1] * planes[p][1]
+                                   + planes[p][2] * planes[p][2])};
+      if (length > 0.0f)
+        {
+          for (float& c : planes[p])
+            c /= length;
+        }
+    }
+}
+
+bool SngoEngine::Core::Utils::Sphere_InFrustum(const float center[3],
+                                               float radius,
+                                               const float planes[6][4])
+{
+  for (int p = 0; p < 6; p++)
+    {
+      const float distance{planes[p][0] * center[0] + planes[p][1] * center[1]
+                           + planes[p][2] * center[2] + planes[p][3]};
+      if (distance < -radius)
+        return false;
+    }
+  return true;
+}
+
+bool SngoEngine::Core::Utils::Meshlet_InFrustum(const Meshlet& meshlet, const float planes[6][4])
+{
+  return Sphere_InFrustum(meshlet.center, meshlet.radius, planes);
+}
+
+bool SngoEngine::Core::Utils::Meshlet_Backfacing(const Meshlet& meshlet, const float camera[3])
+{
+  if (meshlet.cone_cutoff >= 1.0f)
+    return false;
+  const float d[3]{meshlet.center[0] - camera[0],
+                   meshlet.center[1] - camera[1],
+                   meshlet.center[2] - camera[2]};
+  const float distance{std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2])};
+  // the whole sphere has to see the meshlet from behind
+  return d[0] * meshlet.cone_axis[0] + d[1] * meshlet.cone_axis[1] + d[2] * meshlet.cone_axis[2]
+         >= meshlet.cone_cutoff * distance + meshlet.radius;
+}
@@ -0,0 +1,60 @@
+#ifndef __SNGO_MESHLET_H
+#define __SNGO_MESHLET_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace SngoEngine::Core::Utils
+{
+
+//===========================================================================================================================
+// Meshlet
+//===========================================================================================================================
+
+constexpr uint32_t MESHLET_MAX_VERTICES{64};
+constexpr uint32_t MESHLET_MAX_TRIANGLES{124};
+
+struct Meshlet
+{
+  // triangles [triangle_offset, triangle_offset + triangle_count) of the reordered index list
+  uint32_t triangle_offset{};
+  uint32_t triangle_count{};
+  uint32_t vertex_count{};
+
+  float center[3]{};
+  float radius{};
+  // every triangle faces away from a viewer inside the cone around -cone_axis, cone_cutoff is
+  // the sine of its half angle; 1 when the normals spread too far to ever cull
+  float cone_axis[3]{};
+  float cone_cutoff{1.0f};
+};
+
+// greedily grows meshlets of at most max_vertices unique vertices and max_triangles triangles
+// from triangles that share vertices with the current one, and reorders indices in place so
+// every meshlet is a contiguous index range. Bounds come from positions (3 floats each); when
+// normals are given they orient the cone, which keeps it right for mirrored (FlipY) winding
+std::vector<Meshlet> Build_Meshlets(uint32_t* indices,
+                                    size_t index_count,
+                                    const float* positions,
+                                    const float* normals,
+                                    uint32_t vertex_count,
+                                    uint32_t max_vertices = MESHLET_MAX_VERTICES,
+                                    uint32_t max_triangles = MESHLET_MAX_TRIANGLES);
+
+//===========================================================================================================================
+// culling
+//===========================================================================================================================
+
+// Gribb-Hartmann planes (xyz inward normal, w distance) of a column-major view-projection
+// matrix with Vulkan's [0, 1] clip depth, normalized in the space the matrix transforms from
+void Extract_FrustumPlanes(const float* matrix, float planes[6][4]);
+
+bool Sphere_InFrustum(const float center[3], float radius, const float planes[6][4]);
+bool Meshlet_InFrustum(const Meshlet& meshlet, const float planes[6][4]);
+// camera in the same space as the meshlet bounds
+bool Meshlet_Backfacing(const Meshlet& meshlet, const float camera[3]);
+
+}  // namespace SngoEngine::Core::Utils
+
+#endif
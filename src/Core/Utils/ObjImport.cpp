@@ -0,0 +1,248 @@
+#include "ObjImport.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+
+#include "src/Core/Utils/FileParse.hpp"
+#include "src/Core/Utils/JobSystem.hpp"
+
+//===========================================================================================================================
+// parallel helpers
+//===========================================================================================================================
+
+std::vector<std::pair<size_t, size_t>> SngoEngine::Core::Utils::Split_Range(size_t count)
+{
+  const size_t threads{std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), count)};
+
+  std::vector<std::pair<size_t, size_t>> ranges;
+  for (size_t t = 0; t < threads; t++)
+    ranges.emplace_back(count * t / threads, count * (t + 1) / threads);
+  return ranges;
+}
+
+void SngoEngine::Core::Utils::Parallel_For(size_t count,
+                                           const std::function<void(size_t, size_t)>& fn)
+{
+  const auto ranges{Split_Range(count)};
+  if (ranges.empty())
+    return;
+  Job_System().parallel_for(count, (count + ranges.size() - 1) / ranges.size(), fn);
+}
+
+//===========================================================================================================================
+// Parse_ObjParallel
+//===========================================================================================================================
+
+namespace
+{
+struct ObjChunk
+{
+  std::vector<float> positions{};
+  std::vector<float> texcoords{};
+  std::vector<SngoEngine::Core::Utils::ObjCorner> corners{};
+  // corners whose v / vt was a negative (relative) index and is still chunk-local
+  std::vector<size_t> relative_v{};
+  std::vector<size_t> relative_vt{};
+  std::string err{};
+};
+
+inline const char* skip_blank(const char* p, const char* end)
+{
+  while (p < end && (*p == ' ' || *p == '\t' || *p == '\r'))
+    ++p;
+  return p;
+}
+
+inline bool parse_float(const char*& p, const char* end, float& v)
+{
+  p = skip_blank(p, end);
+  if (p < end && *p == '+')
+    ++p;
+  auto [ptr, ec] = std::from_chars(p, end, v);
+  if (ec != std::errc{})
+    return false;
+  p = ptr;
+  return true;
+}
+
+inline bool parse_int(const char*& p, const char* end, int32_t& v)
+{
+  if (p < end && *p == '+')
+    ++p;
+  auto [ptr, ec] = std::from_chars(p, end, v);
+  if (ec != std::errc{})
+    return false;
+  p = ptr;
+  return true;
+}
+
+void parse_chunk(const char* p, const char* end, ObjChunk& chunk)
+{
+  std::vector<SngoEngine::Core::Utils::ObjCorner> face;
+  std::vector<uint8_t> face_relative;
+
+  while (p < end)
+    {
+      const char* line_end{static_cast<const char*>(std::memchr(p, '\n', end - p))};
+      if (!line_end)
+        line_end = end;
+      p = skip_blank(p, line_end);
+
+      if (line_end - p > 2 && p[0] == 'v' && (p[1] == ' ' || p[1] == '\t'))
+        {
+          float x{}, y{}, z{};
+          p += 2;
+          if (!parse_float(p, line_end, x) || !parse_float(p, line_end, y)
+              || !parse_float(p, line_end, z))
+            {
+              chunk.err = "invalid vertex position";
+              return;
+            }
+          chunk.positions.insert(chunk.positions.end(), {x, y, z});
+        }
+      else if (line_end - p > 3 && p[0] == 'v' && p[1] == 't' && (p[2] == ' ' || p[2] == '\t'))
+        {
+          float u{}, v{};
+          p += 3;
+          if (!parse_float(p, line_end, u))
+            {
+              chunk.err = "invalid texture coordinate";
+              return;
+            }
+          // the second component is optional for 1D textures
+          if (!parse_float(p, line_end, v))
+            v = 0.0f;
+          chunk.texcoords.insert(chunk.texcoords.end(), {u, v});
+        }
+      else if (line_end - p > 2 && p[0] == 'f' && (p[1] == ' ' || p[1] == '\t'))
+        {
+          p += 2;
+          face.clear();
+          face_relative.clear();
+          while ((p = skip_blank(p, line_end)) < line_end)
+            {
+              SngoEngine::Core::Utils::ObjCorner c{};
+              uint8_t relative{0};
+              int32_t idx{};
+              if (!parse_int(p, line_end, idx) || idx == 0)
+                {
+                  chunk.err = "invalid face index";
+                  return;
+                }
+              c.v = idx > 0 ? idx - 1 : static_cast<int32_t>(chunk.positions.size() / 3) + idx;
+              relative |= idx < 0 ? 1 : 0;
+
+              if (p < line_end && *p == '/')
+                {
+                  ++p;
+                  if (p < line_end && *p != '/')
+                    {
+                      if (!parse_int(p, line_end, idx) || idx == 0)
+                        {
+                          chunk.err = "invalid face index";
+                          return;
+                        }
+                      c.vt = idx > 0 ? idx - 1
+                                     : static_cast<int32_t>(chunk.texcoords.size() / 2) + idx;
+                      relative |= idx < 0 ? 2 : 0;
+                    }
+                  // the normal index is not used by the engine vertex
+                  while (p < line_end && *p != ' ' && *p != '\t' && *p != '\r')
+                    ++p;
+                }
+              face.push_back(c);
+              face_relative.push_back(relative);
+            }
+
+          // fan triangulation, the same as tinyobj does for convex polygons
+          for (size_t k = 1; k + 1 < face.size(); k++)
+            for (size_t corner : {size_t(0), k, k + 1})
+              {
+                if (face_relative[corner] & 1)
+                  chunk.relative_v.push_back(chunk.corners.size());
+                if (face_relative[corner] & 2)
+                  chunk.relative_vt.push_back(chunk.corners.size());
+                chunk.corners.push_back(face[corner]);
+              }
+        }
+
+      p = line_end + 1;
+    }
+}
+}  // namespace
+
+SngoEngine::Core::Utils::ObjGeometry SngoEngine::Core::Utils::Parse_ObjParallel(
+    const std::string& obj_file)
+{
+  MappedFile file{obj_file};
+  const char* begin{file.data};
+  const char* end{file.data + file.size};
+
+  // chunk boundaries are moved forward to the start of the next line
+  auto ranges{Split_Range(std::max<size_t>(file.size / (1 << 20), 1))};
+  std::vector<const char*> bounds{begin};
+  for (size_t i = 1; i < ranges.size(); i++)
+    {
+      const char* cut{begin + file.size * i / ranges.size()};
+      cut = std::max(cut, bounds.back());
+      cut = Skip_Line(cut, end);
+      bounds.push_back(cut);
+    }
+  bounds.push_back(end);
+
+  std::vector<ObjChunk> chunks(bounds.size() - 1);
+  Parallel_For(chunks.size(), [&](size_t first, size_t last) {
+    for (size_t c = first; c < last; c++)
+      parse_chunk(bounds[c], bounds[c + 1], chunks[c]);
+  });
+
+  std::vector<size_t> v_base(chunks.size() + 1, 0), vt_base(chunks.size() + 1, 0),
+      corner_base(chunks.size() + 1, 0);
+  for (size_t c = 0; c < chunks.size(); c++)
+    {
+      if (!chunks[c].err.empty())
+        throw std::runtime_error(obj_file + ": " + chunks[c].err);
+      v_base[c + 1] = v_base[c] + chunks[c].positions.size();
+      vt_base[c + 1] = vt_base[c] + chunks[c].texcoords.size();
+      corner_base[c + 1] = corner_base[c] + chunks[c].corners.size();
+    }
+
+  ObjGeometry geo{};
+  geo.positions.resize(v_base.back());
+  geo.texcoords.resize(vt_base.back());
+  geo.corners.resize(corner_base.back());
+
+  const auto position_count{static_cast<int32_t>(v_base.back() / 3)};
+  const auto texcoord_count{static_cast<int32_t>(vt_base.back() / 2)};
+  std::atomic<bool> out_of_range{false};
+
+  Parallel_For(chunks.size(), [&](size_t first, size_t last) {
+    for (size_t c = first; c < last; c++)
+      {
+        ObjChunk& chunk{chunks[c]};
+        for (size_t i : chunk.relative_v)
+          chunk.corners[i].v += static_cast<int32_t>(v_base[c] / 3);
+        for (size_t i : chunk.relative_vt)
+          chunk.corners[i].vt += static_cast<int32_t>(vt_base[c] / 2);
+
+        std::copy(
+            chunk.positions.begin(), chunk.positions.end(), geo.positions.begin() + v_base[c]);
+        std::copy(
+            chunk.texcoords.begin(), chunk.texcoords.end(), geo.texcoords.begin() + vt_base[c]);
+        std::copy(
+            chunk.corners.begin(), chunk.corners.end(), geo.corners.begin() + corner_base[c]);
+
+        for (const auto& corner : chunk.corners)
+          if (corner.v < 0 || corner.v >= position_count || corner.vt >= texcoord_count)
+            out_of_range.store(true, std::memory_order_relaxed);
+      }
+  });
+
+  if (out_of_range)
+    throw std::runtime_error(obj_file + ": face index out of range");
+  return geo;
+}
@@ -0,0 +1,218 @@
+#ifndef __SNGO_OBJIMPORT_H
+#define __SNGO_OBJIMPORT_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "fmt/core.h"
+#include "src/Core/Utils/Math.hpp"
+#include "src/Core/Utils/Utils.hpp"
+
+namespace SngoEngine::Core::Utils
+{
+
+//===========================================================================================================================
+// parallel helpers
+//===========================================================================================================================
+
+// [0, count) cut into at most one contiguous range per hardware thread
+std::vector<std::pair<size_t, size_t>> Split_Range(size_t count);
+// runs fn(begin, end) over about one range per hardware thread as jobs of Job_System(), the
+// caller runs the first range and returns once all of them ran
+void Parallel_For(size_t count, const std::function<void(size_t, size_t)>& fn);
+
+//===========================================================================================================================
+// ObjGeometry
+//===========================================================================================================================
+
+struct ObjCorner
+{
+  int32_t v{-1};
+  int32_t vt{-1};
+};
+
+// positions and texcoords of an .obj plus its faces fan-triangulated into corners
+struct ObjGeometry
+{
+  std::vector<float> positions{};
+  std::vector<float> texcoords{};
+  std::vector<ObjCorner> corners{};
+};
+
+// the file is cut into one chunk per thread at line boundaries, each chunk is parsed on its own
+ObjGeometry Parse_ObjParallel(const std::string& obj_file);
+
+//===========================================================================================================================
+// Load_Vetex_Index_Parallel
+//===========================================================================================================================
+
+// same output as Load_Vetex_Index (first-occurrence vertex order) but parsed in parallel and
+// deduplicated through a lock-free open-addressing table keyed by MurmurHash64A of the vertex
+// attributes
+template <typename V, typename I>
+void Load_Vetex_Index_Parallel(const std::string& obj_file,
+                               std::vector<V>& vertices,
+                               std::vector<I>& indices)
+{
+  const ObjGeometry geo{Parse_ObjParallel(obj_file)};
+  const size_t n{geo.corners.size()};
+  if (n == 0)
+    return;
+  if (n >= UINT32_MAX)
+    throw std::runtime_error("too many face corners in " + obj_file);
+
+  auto make_vertex = [&geo](size_t i) {
+    const ObjCorner c{geo.corners[i]};
+    V vertex{};
+    vertex.pos = {geo.positions[3 * c.v + 0],
+                  geo.positions[3 * c.v + 1],
+                  geo.positions[3 * c.v + 2]};
+    if (c.vt >= 0)
+      vertex.tex_coord = {geo.texcoords[2 * c.vt + 0], 1.0f - geo.texcoords[2 * c.vt + 1]};
+    vertex.color = {1.0f, 1.0f, 1.0f};
+    return vertex;
+  };
+
+  // the attributes, not the object bytes: padding inside V would tell equal vertices apart
+  auto hash_vertex = [](const V& vertex) {
+    const float key[8]{vertex.pos.x,
+                       vertex.pos.y,
+                       vertex.pos.z,
+                       vertex.tex_coord.x,
+                       vertex.tex_coord.y,
+                       vertex.color.x,
+                       vertex.color.y,
+                       vertex.color.z};
+    return Math::HashBuffer(key, sizeof(key));
+  };
+
+  size_t table_size{64};
+  while (table_size < 2 * n)
+    table_size <<= 1;
+  const size_t mask{table_size - 1};
+
+  // slots hold corner + 1, 0 is empty
+  std::vector<std::atomic<uint32_t>> slots(table_size);
+  std::vector<uint64_t> hashes(n);
+  std::vector<uint32_t> slot_of(n);
+
+  Parallel_For(n, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++)
+      {
+        const V vertex{make_vertex(i)};
+        const uint64_t h{hash_vertex(vertex)};
+        hashes[i] = h;
+
+        size_t s{h & mask};
+        while (true)
+          {
+            uint32_t cur{slots[s].load(std::memory_order_acquire)};
+            if (cur == 0)
+              {
+                if (slots[s].compare_exchange_strong(
+                        cur, uint32_t(i + 1), std::memory_order_acq_rel))
+                  break;
+              }
+            // hashes[j] is published by the release in the CAS that stored j + 1
+            const size_t j{cur - 1u};
+            if (hashes[j] == h && make_vertex(j) == vertex)
+              {
+                // keep the smallest corner so the vertex order matches the serial loader
+                while (cur - 1u > i
+                       && !slots[s].compare_exchange_weak(
+                           cur, uint32_t(i + 1), std::memory_order_acq_rel))
+                  ;
+                break;
+              }
+            s = (s + 1) & mask;
+          }
+        slot_of[i] = static_cast<uint32_t>(s);
+      }
+  });
+
+  // rep[i] is the first corner equal to i, corners that are their own rep become vertices
+  std::vector<uint32_t> rep(n);
+  Parallel_For(n, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++)
+      rep[i] = slots[slot_of[i]].load(std::memory_order_relaxed) - 1u;
+  });
+
+  // exclusive scan of the first-occurrence flags, one block per range
+  std::vector<uint32_t>& new_id{slot_of};
+  const auto blocks{Split_Range(n)};
+  std::vector<uint32_t> block_base(blocks.size() + 1, 0);
+  Parallel_For(blocks.size(), [&](size_t begin, size_t end) {
+    for (size_t b = begin; b < end; b++)
+      {
+        uint32_t count{0};
+        for (size_t i = blocks[b].first; i < blocks[b].second; i++)
+          count += rep[i] == i;
+        block_base[b + 1] = count;
+      }
+  });
+  for (size_t b = 0; b < blocks.size(); b++)
+    block_base[b + 1] += block_base[b];
+
+  const size_t vertex_base{vertices.size()};
+  const size_t index_base{indices.size()};
+  vertices.resize(vertex_base + block_base.back());
+  indices.resize(index_base + n);
+
+  Parallel_For(blocks.size(), [&](size_t begin, size_t end) {
+    for (size_t b = begin; b < end; b++)
+      {
+        uint32_t id{block_base[b]};
+        for (size_t i = blocks[b].first; i < blocks[b].second; i++)
+          if (rep[i] == i)
+            {
+              new_id[i] = id;
+              vertices[vertex_base + id] = make_vertex(i);
+              id++;
+            }
+      }
+  });
+  Parallel_For(n, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++)
+      indices[index_base + i] = static_cast<I>(vertex_base + new_id[rep[i]]);
+  });
+}
+
+// times Load_Vetex_Index against Load_Vetex_Index_Parallel on the same file
+template <typename V, typename I>
+void Benchmark_ObjImport(const std::string& obj_file)
+{
+  using Clock = std::chrono::steady_clock;
+
+  std::vector<V> serial_vertices, parallel_vertices;
+  std::vector<I> serial_indices, parallel_indices;
+
+  auto t0{Clock::now()};
+  Load_Vetex_Index<V, I>(obj_file, serial_vertices, serial_indices);
+  auto t1{Clock::now()};
+  Load_Vetex_Index_Parallel<V, I>(obj_file, parallel_vertices, parallel_indices);
+  auto t2{Clock::now()};
+
+  const double ms_serial{std::chrono::duration<double, std::milli>(t1 - t0).count()};
+  const double ms_parallel{std::chrono::duration<double, std::milli>(t2 - t1).count()};
+  const bool same{serial_vertices == parallel_vertices && serial_indices == parallel_indices};
+
+  fmt::println("Benchmark_ObjImport: {} ({} triangles)", obj_file, serial_indices.size() / 3);
+  fmt::println("  tinyobj + unordered_map : {:10.2f} ms, {} vertices",
+               ms_serial,
+               serial_vertices.size());
+  fmt::println("  parallel + murmur table : {:10.2f} ms, {} vertices",
+               ms_parallel,
+               parallel_vertices.size());
+  fmt::println(
+      "  speedup {:.2f}x, results {}", ms_serial / ms_parallel, same ? "match" : "DIFFER");
+}
+
+}  // namespace SngoEngine::Core::Utils
+
+#endif
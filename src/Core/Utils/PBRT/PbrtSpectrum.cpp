@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cstdint>
+#include <filesystem>
 #include <glm/detail/qualifier.hpp>
 #include <glm/matrix.hpp>
 #include <stdexcept>
@@ -12,6 +13,7 @@
 #include "src/Core/Utils/CHECK.hpp"
 #include "src/Core/Utils/ColorSpace/ColorSpace.hpp"
 #include "src/Core/Utils/ColorSpace/RGBUtils.hpp"
+#include "src/Core/Utils/JobSystem.hpp"
 #include "src/Core/Utils/Math.hpp"
 #include "src/Core/Utils/Utils.hpp"
 
@@ -63,7 +65,8 @@ SngoEngine::Core::PBRT::Spectrum::FromInterleaved(std::span<const float> samples
 {
   assert(0 == samples.size() % 2);
   uint32_t n = samples.size() / 2;
-  std::vector<float> lambda, v;
+  ScratchScope scratch{};
+  std::pmr::vector<float> lambda{Scratch_Resource()}, v{Scratch_Resource()};
 
   // Extend samples to cover range of visible wavelengths if needed.
   if (samples[0] > Lambda_min)
@@ -84,7 +87,7 @@ SngoEngine::Core::PBRT::Spectrum::FromInterleaved(std::span<const float> samples
       v.push_back(v.back());
     }
 
-  auto* spec = ALLOC.new_object<PiecewiseLinearSpectrum>(lambda, v);
+  auto* spec = ALLOC.new_object<PiecewiseLinearSpectrum>(lambda, v, ALLOC);
 
   if (normalize)
     // Normalize to have luminance of 1.
@@ -109,7 +112,8 @@ SngoEngine::Core::PBRT::Spectrum::Read_Spectrum(const std::string& fn)
           fmt::println("%s: extra value found in spectrum file.", fn);
           return {};
         }
-      std::vector<float> lambda, v;
+      ScratchScope scratch{};
+      std::pmr::vector<float> lambda{Scratch_Resource()}, v{Scratch_Resource()};
       for (size_t i = 0; i < vals.size() / 2; ++i)
         {
           if (i > 0 && vals[2 * i] <= lambda.back())
@@ -131,6 +135,37 @@ SngoEngine::Core::PBRT::Spectrum::Read_Spectrum(const std::string& fn)
     }
 }
 
+std::map<std::string, SngoEngine::Core::PBRT::Spectrum::Spectrum>
+SngoEngine::Core::PBRT::Spectrum::Read_SpectrumDirectory(const std::string& dir)
+{
+  std::vector<std::filesystem::path> files;
+  for (const auto& entry : std::filesystem::directory_iterator(dir))
+    if (entry.is_regular_file())
+      files.push_back(entry.path());
+
+  std::vector<std::optional<Spectrum>> spectra(files.size());
+  // one job per file, the files differ a lot in size
+  Utils::Job_System().parallel_for(files.size(), 1, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++)
+      {
+        try
+          {
+            spectra[i] = Read_Spectrum(files[i].string());
+          }
+        catch (const std::exception& e)
+          {
+            fmt::println("{}", e.what());
+          }
+      }
+  });
+
+  std::map<std::string, Spectrum> res;
+  for (size_t i = 0; i < files.size(); i++)
+    if (spectra[i])
+      res.emplace(files[i].stem().string(), *spectra[i]);
+  return res;
+}
+
 SngoEngine::Core::PBRT::Spectrum::SampledSpectrum SngoEngine::Core::PBRT::Spectrum::SafeDiv(
     SampledSpectrum a,
     SampledSpectrum b)
@@ -237,16 +272,22 @@ SngoEngine::Core::PBRT::Spectrum::BlackbodySpectrum::Sample(const SampledWavelen
 //===========================================================================================================================
 
 SngoEngine::Core::PBRT::Spectrum::DenselySampledSpectrum::DenselySampledSpectrum(int lambda_min,
-                                                                                 int lambda_max)
-    : lambda_min(lambda_min), lambda_max(lambda_max)
+                                                                                 int lambda_max,
+                                                                                 Allocator alloc)
+    : lambda_min(lambda_min),
+      lambda_max(lambda_max),
+      values(lambda_max - lambda_min + 1, 0.f, alloc)
 {
 }
 
 SngoEngine::Core::PBRT::Spectrum::DenselySampledSpectrum::DenselySampledSpectrum(
     const Spectrum& spec,
     int lambda_min,
-    int lambda_max)
-    : lambda_min(lambda_min), lambda_max(lambda_max), values(lambda_max - lambda_min + 1, 0.f)
+    int lambda_max,
+    Allocator alloc)
+    : lambda_min(lambda_min),
+      lambda_max(lambda_max),
+      values(lambda_max - lambda_min + 1, 0.f, alloc)
 {
   if (spec)
     for (int lambda = lambda_min; lambda <= lambda_max; ++lambda)
@@ -287,8 +328,9 @@ struct hash<SngoEngine::Core::PBRT::Spectrum::DenselySampledSpectrum>
 
 SngoEngine::Core::PBRT::Spectrum::PiecewiseLinearSpectrum::PiecewiseLinearSpectrum(
     std::span<const float> l,
-    std::span<const float> v)
-    : lambdas(l.begin(), l.end()), values(v.begin(), v.end())
+    std::span<const float> v,
+    Allocator alloc)
+    : lambdas(l.begin(), l.end(), alloc), values(v.begin(), v.end(), alloc)
 {
   assert(lambdas.size() == values.size());
   for (size_t i = 0; i < lambdas.size() - 1; ++i)
@@ -14,6 +14,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "SpectrumAllocator.hpp"
 #include "SpectrumData.hpp"
 #include "src/Core/Utils/ColorSpace/RGBUtils.hpp"
 #include "src/Core/Utils/Math.hpp"
@@ -22,7 +23,9 @@
 namespace SngoEngine::Core::PBRT::Spectrum
 {
 using Allocator = std::pmr::polymorphic_allocator<std::byte>;
-static Allocator ALLOC{};
+// one instance for the whole program, backed by the shared spectrum arena; only for the named
+// spectra and tables built at startup, a default Allocator{} puts runtime spectra on the heap
+inline Allocator ALLOC{Spectrum_Resource()};
 
 static constexpr float CIE_Y_integral = 106.856895;
 constexpr float Lambda_min = 360, Lambda_max = 830;
@@ -40,6 +43,8 @@ struct Spectrum;
 struct RGBColorSpace;
 
 static std::optional<Spectrum> Read_Spectrum(const std::string& fn);
+// every regular file of the directory parsed on worker threads, keyed by file stem
+std::map<std::string, Spectrum> Read_SpectrumDirectory(const std::string& dir);
 PiecewiseLinearSpectrum* FromInterleaved(std::span<const float> samples, bool normalize);
 inline float InnerProduct(const Spectrum& f, const Spectrum& g);
 inline SampledSpectrum SafeDiv(SampledSpectrum a, SampledSpectrum b);
@@ -358,11 +363,18 @@ struct DenselySampledSpectrum
 {
  public:
   // DenselySampledSpectrum Public Methods
-  explicit DenselySampledSpectrum(int lambda_min = Lambda_min, int lambda_max = Lambda_max);
+  explicit DenselySampledSpectrum(int lambda_min = Lambda_min,
+                                  int lambda_max = Lambda_max,
+                                  Allocator alloc = {});
   explicit DenselySampledSpectrum(const Spectrum& spec,
                                   int lambda_min = Lambda_min,
-                                  int lambda_max = Lambda_max);
-  DenselySampledSpectrum(const DenselySampledSpectrum& s) = default;
+                                  int lambda_max = Lambda_max,
+                                  Allocator alloc = {});
+  // copies go to the heap, moves keep the source's resource
+  DenselySampledSpectrum(const DenselySampledSpectrum&) = default;
+  DenselySampledSpectrum(DenselySampledSpectrum&&) noexcept = default;
+  DenselySampledSpectrum& operator=(const DenselySampledSpectrum&) = default;
+  DenselySampledSpectrum& operator=(DenselySampledSpectrum&&) = default;
 
   [[nodiscard]] SampledSpectrum Sample(const SampledWavelengths& lambda) const;
 
@@ -380,9 +392,10 @@ struct DenselySampledSpectrum
   template <typename F>
   static DenselySampledSpectrum SampleFunction(F func,
                                                int lambda_min = Lambda_min,
-                                               int lambda_max = Lambda_max)
+                                               int lambda_max = Lambda_max,
+                                               Allocator alloc = {})
   {
-    DenselySampledSpectrum s(lambda_min, lambda_max);
+    DenselySampledSpectrum s(lambda_min, lambda_max, alloc);
     for (int lambda = lambda_min; lambda <= lambda_max; ++lambda)
       s.values[lambda - lambda_min] = func(lambda);
     return s;
@@ -410,7 +423,7 @@ struct DenselySampledSpectrum
  private:
   friend struct std::hash<DenselySampledSpectrum>;
   int lambda_min, lambda_max;
-  std::vector<float> values;
+  std::pmr::vector<float> values;
 };
 
 //===========================================================================================================================
@@ -438,12 +451,14 @@ struct PiecewiseLinearSpectrum
 
   float operator()(float lambda) const;
 
-  PiecewiseLinearSpectrum(std::span<const float> lambdas, std::span<const float> values);
+  PiecewiseLinearSpectrum(std::span<const float> lambdas,
+                          std::span<const float> values,
+                          Allocator alloc = {});
 
  private:
   // PiecewiseLinearSpectrum Private Members
-  std::vector<float> lambdas{};
-  std::vector<float> values{};
+  std::pmr::vector<float> lambdas;
+  std::pmr::vector<float> values;
 };
 
 //===========================================================================================================================
@@ -624,14 +639,16 @@ static DenselySampledSpectrum* z;
 
 static std::map<std::string, Spectrum> named_Spectra_init() noexcept
 {
-  PiecewiseLinearSpectrum xpls(CIE_lambda, CIE_X);
-  Spectra::x = ALLOC.new_object<DenselySampledSpectrum>(&xpls);
+  // the piecewise tables are only sampled once, the dense X, Y and Z stay in the arena
+  ScratchScope scratch{};
+  PiecewiseLinearSpectrum xpls(CIE_lambda, CIE_X, Scratch_Resource());
+  Spectra::x = ALLOC.new_object<DenselySampledSpectrum>(&xpls, Lambda_min, Lambda_max, ALLOC);
 
-  PiecewiseLinearSpectrum ypls(CIE_lambda, CIE_Y);
-  y = ALLOC.new_object<DenselySampledSpectrum>(&ypls);
+  PiecewiseLinearSpectrum ypls(CIE_lambda, CIE_Y, Scratch_Resource());
+  y = ALLOC.new_object<DenselySampledSpectrum>(&ypls, Lambda_min, Lambda_max, ALLOC);
 
-  PiecewiseLinearSpectrum zpls(CIE_lambda, CIE_Z);
-  z = ALLOC.new_object<DenselySampledSpectrum>(&zpls);
+  PiecewiseLinearSpectrum zpls(CIE_lambda, CIE_Z, Scratch_Resource());
+  z = ALLOC.new_object<DenselySampledSpectrum>(&zpls, Lambda_min, Lambda_max, ALLOC);
 
   Spectrum illuma{FromInterleaved(CIE_Illum_A, true)};
   Spectrum illumd50{FromInterleaved(CIE_Illum_D5000, true)};
@@ -799,6 +816,7 @@ static inline const DenselySampledSpectrum& Z()
   return *z;
 }
 
+// the result and its samples live on the heap, the intermediate CIE D table in scratch
 static DenselySampledSpectrum D(float temperature)
 {
   // Convert temperature to CCT
@@ -828,11 +846,12 @@ static DenselySampledSpectrum D(float temperature)
   float M1 = (-1.3515f - 1.7703f * x + 5.9114f * y) / M;
   float M2 = (0.0300f - 31.4424f * x + 30.0717f * y) / M;
 
-  std::vector<float> values(nCIES);
+  ScratchScope scratch{};
+  std::pmr::vector<float> values(nCIES, Scratch_Resource());
   for (int i = 0; i < nCIES; ++i)
     values[i] = (CIE_S0[i] + CIE_S1[i] * M1 + CIE_S2[i] * M2) * 0.01;
 
-  PiecewiseLinearSpectrum dpls(CIE_S_lambda, values);
+  PiecewiseLinearSpectrum dpls(CIE_S_lambda, values, Scratch_Resource());
   DenselySampledSpectrum ret{Spectrum{&dpls}};
   return ret;
 }
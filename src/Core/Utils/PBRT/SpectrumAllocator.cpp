@@ -0,0 +1,167 @@
+#include "SpectrumAllocator.hpp"
+
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+
+#include "fmt/core.h"
+
+namespace
+{
+// CIE tables, the illuminants and the metal ior data are ~60 spectra of a few hundred floats
+constexpr size_t SPECTRUM_ARENA_INITIAL_SIZE = 256 * 1024;
+constexpr size_t SCRATCH_ARENA_INITIAL_SIZE = 16 * 1024;
+
+thread_local uint32_t scratch_depth{0};
+}  // namespace
+
+//===========================================================================================================================
+// EngineArenaResource
+//===========================================================================================================================
+
+SngoEngine::Core::PBRT::Spectrum::EngineArenaResource::EngineArenaResource(
+    size_t initial_size,
+    bool _synchronized,
+    std::pmr::memory_resource* upstream)
+    : counting(upstream), arena(initial_size, &counting), synchronized(_synchronized)
+{
+}
+
+SngoEngine::Core::PBRT::Spectrum::ArenaStats
+SngoEngine::Core::PBRT::Spectrum::EngineArenaResource::stats() const
+{
+  return {allocations.load(std::memory_order_relaxed),
+          bytes.load(std::memory_order_relaxed),
+          counting.blocks.load(std::memory_order_relaxed),
+          counting.bytes.load(std::memory_order_relaxed),
+          releases.load(std::memory_order_relaxed)};
+}
+
+void SngoEngine::Core::PBRT::Spectrum::EngineArenaResource::release()
+{
+  if (synchronized)
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      arena.release();
+    }
+  else
+    arena.release();
+  releases.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* SngoEngine::Core::PBRT::Spectrum::EngineArenaResource::do_allocate(size_t _bytes,
+                                                                         size_t alignment)
+{
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  bytes.fetch_add(_bytes, std::memory_order_relaxed);
+
+  if (synchronized)
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      return arena.allocate(_bytes, alignment);
+    }
+  return arena.allocate(_bytes, alignment);
+}
+
+void SngoEngine::Core::PBRT::Spectrum::EngineArenaResource::do_deallocate(void*, size_t, size_t)
+{
+}
+
+bool SngoEngine::Core::PBRT::Spectrum::EngineArenaResource::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept
+{
+  return this == &other;
+}
+
+void* SngoEngine::Core::PBRT::Spectrum::EngineArenaResource::CountingUpstream::do_allocate(
+    size_t _bytes,
+    size_t alignment)
+{
+  blocks.fetch_add(1, std::memory_order_relaxed);
+  bytes.fetch_add(_bytes, std::memory_order_relaxed);
+  return upstream->allocate(_bytes, alignment);
+}
+
+void SngoEngine::Core::PBRT::Spectrum::EngineArenaResource::CountingUpstream::do_deallocate(
+    void* p,
+    size_t _bytes,
+    size_t alignment)
+{
+  upstream->deallocate(p, _bytes, alignment);
+}
+
+bool SngoEngine::Core::PBRT::Spectrum::EngineArenaResource::CountingUpstream::do_is_equal(
+    const std::pmr::memory_resource& other) const noexcept
+{
+  return this == &other;
+}
+
+//===========================================================================================================================
+// spectrum arenas
+//===========================================================================================================================
+
+namespace
+{
+SngoEngine::Core::PBRT::Spectrum::EngineArenaResource& spectrum_arena()
+{
+  // never destroyed: spectra handed out at static-init time must outlive every other static
+  static auto* arena{
+      new SngoEngine::Core::PBRT::Spectrum::EngineArenaResource(SPECTRUM_ARENA_INITIAL_SIZE, true)};
+  return *arena;
+}
+
+SngoEngine::Core::PBRT::Spectrum::EngineArenaResource& scratch_arena()
+{
+  thread_local SngoEngine::Core::PBRT::Spectrum::EngineArenaResource arena(
+      SCRATCH_ARENA_INITIAL_SIZE, false);
+  return arena;
+}
+}  // namespace
+
+std::pmr::memory_resource* SngoEngine::Core::PBRT::Spectrum::Spectrum_Resource()
+{
+  return &spectrum_arena();
+}
+
+SngoEngine::Core::PBRT::Spectrum::ArenaStats
+SngoEngine::Core::PBRT::Spectrum::Spectrum_ArenaStats()
+{
+  return spectrum_arena().stats();
+}
+
+std::pmr::memory_resource* SngoEngine::Core::PBRT::Spectrum::Scratch_Resource()
+{
+  return &scratch_arena();
+}
+
+SngoEngine::Core::PBRT::Spectrum::ArenaStats
+SngoEngine::Core::PBRT::Spectrum::Scratch_ArenaStats()
+{
+  return scratch_arena().stats();
+}
+
+SngoEngine::Core::PBRT::Spectrum::ScratchScope::ScratchScope()
+{
+  ++scratch_depth;
+}
+
+SngoEngine::Core::PBRT::Spectrum::ScratchScope::~ScratchScope()
+{
+  if (--scratch_depth == 0)
+    scratch_arena().release();
+}
+
+void SngoEngine::Core::PBRT::Spectrum::Print_ArenaStats()
+{
+  auto print = [](const char* name, const ArenaStats& s) {
+    fmt::println("{:<10}: {} allocations, {} bytes, {} upstream blocks ({} bytes), {} releases",
+                 name,
+                 s.allocations,
+                 s.bytes,
+                 s.upstream_blocks,
+                 s.upstream_bytes,
+                 s.releases);
+  };
+  print("spectrum", Spectrum_ArenaStats());
+  print("scratch", Scratch_ArenaStats());
+}
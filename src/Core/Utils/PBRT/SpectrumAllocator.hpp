@@ -0,0 +1,94 @@
+#ifndef __PBRT_SPECTRUM_ALLOCATOR_H
+#define __PBRT_SPECTRUM_ALLOCATOR_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+
+namespace SngoEngine::Core::PBRT::Spectrum
+{
+
+//===========================================================================================================================
+// EngineArenaResource
+//===========================================================================================================================
+
+struct ArenaStats
+{
+  uint64_t allocations{};
+  uint64_t bytes{};
+  uint64_t upstream_blocks{};
+  uint64_t upstream_bytes{};
+  uint64_t releases{};
+};
+
+// monotonic arena that counts what passes through it, deallocate is a no-op and memory only
+// goes back to the upstream on release()
+class EngineArenaResource : public std::pmr::memory_resource
+{
+ public:
+  explicit EngineArenaResource(size_t initial_size,
+                               bool synchronized,
+                               std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+  EngineArenaResource(const EngineArenaResource&) = delete;
+  EngineArenaResource& operator=(const EngineArenaResource&) = delete;
+  ~EngineArenaResource() override = default;
+
+  [[nodiscard]] ArenaStats stats() const;
+  void release();
+
+ private:
+  struct CountingUpstream : public std::pmr::memory_resource
+  {
+    explicit CountingUpstream(std::pmr::memory_resource* _upstream) : upstream(_upstream) {}
+
+    std::pmr::memory_resource* upstream;
+    std::atomic<uint64_t> blocks{};
+    std::atomic<uint64_t> bytes{};
+
+   private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+  };
+
+  void* do_allocate(size_t bytes, size_t alignment) override;
+  void do_deallocate(void* p, size_t bytes, size_t alignment) override;
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  CountingUpstream counting;
+  std::pmr::monotonic_buffer_resource arena;
+  const bool synchronized;
+  mutable std::mutex lock;
+
+  std::atomic<uint64_t> allocations{};
+  std::atomic<uint64_t> bytes{};
+  std::atomic<uint64_t> releases{};
+};
+
+//===========================================================================================================================
+// spectrum arenas
+//===========================================================================================================================
+
+// process-wide arena for spectra, color spaces and rgb tables that live until exit
+std::pmr::memory_resource* Spectrum_Resource();
+ArenaStats Spectrum_ArenaStats();
+
+// per-thread arena for temporaries, reclaimed when the outermost ScratchScope of the thread ends
+std::pmr::memory_resource* Scratch_Resource();
+ArenaStats Scratch_ArenaStats();
+
+struct ScratchScope
+{
+  ScratchScope();
+  ScratchScope(const ScratchScope&) = delete;
+  ScratchScope& operator=(const ScratchScope&) = delete;
+  ~ScratchScope();
+};
+
+void Print_ArenaStats();
+
+}  // namespace SngoEngine::Core::PBRT::Spectrum
+
+#endif
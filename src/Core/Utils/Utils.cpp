@@ -1,5 +1,6 @@
 #include "Utils.hpp"
 
+#include <charconv>
 #include <cstdlib>
 #include <fstream>
 #include <ios>
@@ -8,6 +9,7 @@
 #include <unordered_map>
 
 #include "src/Core/Device/LogicalDevice.hpp"
+#include "src/Core/Utils/FileParse.hpp"
 
 //===========================================================================================================================
 // Files Operations
@@ -61,66 +63,12 @@ FILE* SngoEngine::Core::Utils::FOpenRead(const std::string& filename)
 
 std::vector<float> SngoEngine::Core::Utils::Read_FloatFile(const std::string& filename)
 {
-  FILE* f = FOpenRead(filename);
-  if (f == nullptr)
-    {
-      throw std::runtime_error("Unable to open file " + filename);
-      return {};
-    }
+  MappedFile file{filename};
 
-  int c;
-  bool inNumber = false;
-  char curNumber[32];
-  int curNumberPos = 0;
-  int lineNumber = 1;
   std::vector<float> values;
-  while ((c = getc(f)) != EOF)
-    {
-      if (c == '\n')
-        ++lineNumber;
-      if (inNumber)
-        {
-          // Note: this is not very robust, and would accept something
-          // like 0.0.0.0eeee-+--2 as a valid number.
-          if ((isdigit(c) != 0) || c == '.' || c == 'e' || c == 'E' || c == '-' || c == '+')
-            {
-              assert(curNumberPos <= sizeof(curNumber));
-              curNumber[curNumberPos++] = c;
-            }
-          else
-            {
-              curNumber[curNumberPos++] = '\0';
-              float v{};
-              if (Atof(curNumber, &v))
-                throw std::runtime_error("UInable to parse float value in" + filename + " in "
-                                         + curNumber);
-              values.push_back(v);
-              inNumber = false;
-              curNumberPos = 0;
-            }
-        }
-      else
-        {
-          if ((isdigit(c) != 0) || c == '.' || c == '-' || c == '+')
-            {
-              inNumber = true;
-              curNumber[curNumberPos++] = c;
-            }
-          else if (c == '#')
-            {
-              while ((c = getc(f)) != '\n' && c != EOF)
-                ;
-              ++lineNumber;
-            }
-          else if (isspace(c) == 0)
-            {
-              throw std::runtime_error(filename + ": unexpected character " + std::to_string(c)
-                                       + " found at line" + std::to_string(lineNumber));
-              return {};
-            }
-        }
-    }
-  fclose(f);
+  std::string err;
+  if (!Parse_Floats(file.view(), values, &err))
+    throw std::runtime_error(filename + ": " + err);
   return values;
 }
 
@@ -201,28 +149,18 @@ VkShaderModule SngoEngine::Core::Utils::Glsl_ShaderCompiler(VkDevice device,
 
 bool SngoEngine::Core::Utils::Atof(std::string_view str, float* ptr)
 {
-  try
-    {
-      *ptr = std::stof(std::string(str.begin(), str.end()));
-    }
-  catch (...)
-    {
-      return false;
-    }
-  return true;
+  if (!str.empty() && str.front() == '+')
+    str.remove_prefix(1);
+  auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), *ptr);
+  return ec == std::errc{};
 }
 
 bool SngoEngine::Core::Utils::Atof(std::string_view str, double* ptr)
 {
-  try
-    {
-      *ptr = std::stod(std::string(str.begin(), str.end()));
-    }
-  catch (...)
-    {
-      return false;
-    }
-  return true;
+  if (!str.empty() && str.front() == '+')
+    str.remove_prefix(1);
+  auto [end, ec] = std::from_chars(str.data(), str.data() + str.size(), *ptr);
+  return ec == std::errc{};
 }
 
 //===========================================================================================================================
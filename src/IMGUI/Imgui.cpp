@@ -20,16 +20,20 @@
 #include "src/Core/Instance/Instance.hpp"
 #include "src/Core/Macro.h"
 #include "src/Core/Render/RenderPass.hpp"
-#include "src/Core/Signalis/Fence.hpp"
 #include "src/Core/Signalis/Semaphore.hpp"
+#include "src/Core/Signalis/Timeline.hpp"
 #include "src/Core/Source/Buffer/CommandBuffer.hpp"
 #include "src/Core/Source/Buffer/Descriptor.hpp"
 #include "src/Core/Source/Buffer/VertexBuffer.hpp"
+#include "src/Core/Source/Image/KtxTranscode.hpp"
+#include "src/Core/Source/Image/MipChain.hpp"
 #include "src/Core/Source/Model/Camera.hpp"
 #include "src/Core/Source/Model/Model.hpp"
 #include "src/Core/Source/Pipeline/Pipeline.hpp"
 #include "src/Core/Source/Pipeline/RenderPipline.hpp"
 #include "src/Core/Source/SwapChain/SwapChain.hpp"
+#include "src/Core/Utils/JobSystem.hpp"
+#include "src/Core/Utils/PBRT/SpectrumAllocator.hpp"
 #include "src/Core/Utils/Utils.hpp"
 #include "src/GLFWEXT/Surface.h"
 #include "src/IMGUI/include/imgui.h"
@@ -100,6 +104,8 @@ int SngoEngine::Imgui::ImguiApplication::init()
       printf("GLFW: Vulkan Not Supported\n");
       return 1;
     }
+  // starts the workers before anything loads
+  fmt::println("job system created, {} workers", Core::Utils::Job_System().worker_count());
   gui_Instance.init("imgui_pbrt", IMGUI_REQUIRED_DEVICE_EXTS);
 
   fmt::println("instance created");
@@ -125,6 +131,13 @@ int SngoEngine::Imgui::ImguiApplication::init()
   gui_Device.init(&gui_PhysicalDevice, gui_Surface.surface, device_EXTs, device_LAYERs);
   fmt::println("gui_Device created");
 
+  if (!benchmark_Ktx.empty())
+    {
+      Core::Source::Image::Benchmark_KtxTranscode(
+          &gui_Device, benchmark_Ktx, benchmark_Iterations);
+      return 0;
+    }
+
   create_IMGUI_DescriptorPoor();
   fmt::println("gui_DescriptorPool created");
 
@@ -141,11 +154,12 @@ int SngoEngine::Imgui::ImguiApplication::init()
   Image_count = swap_chain_requirements.img_count;
   sampler_flag = Core::Source::RenderPipeline::MSAA_maxAvailableSampleCount(&gui_Device);
 
+  frame_graph.init(&gui_Device);
   msaa_renderpass.init(&gui_Device,
+                       &frame_graph,
                        gui_SwapChain.extent,
                        gui_SwapChain.image_format,
                        sampler_flag,
-                       &gui_SwapChain,
                        true);
 
   fmt::println("main_RenderPass created");
@@ -169,63 +183,68 @@ int SngoEngine::Imgui::ImguiApplication::init()
 
   // ---------------------  Unibuffer  ------------------------
 
-  model_UniBuffer.init(&gui_Device, gui_Device.graphics_queue);
+  frame_uniforms.init(&gui_Device, sizeof(Core::Source::Buffer::UniformBuffer_Trans));
   // prepare for uniform binding
   {
-    std::vector<VkDescriptorPoolSize> poolSizes = {
-        Core::Source::Descriptor::Get_DescriptorPoolSize(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 4),
-        Core::Source::Descriptor::Get_DescriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-                                                         6)};
-
     std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
         Core::Source::Descriptor::GetLayoutBinding(
-            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+            VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
             VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
             0)};
 
-    uni_pool.init(&gui_Device, 4, poolSizes);
+    uni_allocator.init(&gui_Device);
     uni_setlayout.init(&gui_Device, setLayoutBindings);
-    uni_set.init(&gui_Device, &uni_setlayout, &uni_pool);
+    uni_set.init(&gui_Device, &uni_setlayout, &uni_allocator);
 
+    const VkDescriptorBufferInfo uniform_info{
+        frame_uniforms.descriptor(sizeof(Core::Source::Buffer::UniformBuffer_Trans))};
     std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
         // Binding 0 : Vertex shader uniform buffer
         Core::Source::Descriptor::GetDescriptSet_Write(uni_set.descriptor_set,
-                                                       VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+                                                       VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
                                                        0,
-                                                       &model_UniBuffer.descriptor)};
+                                                       &uniform_info)};
     uni_set.updateWrite(writeDescriptorSets);
   }
 
   // ------------------  HDR renderpass     ---------------------
   {
-    hdr_renderpass.init(&gui_Device, gui_SwapChain.extent, sampler_flag);
+    hdr_renderpass.init(&gui_Device, &frame_graph, gui_SwapChain.extent, sampler_flag);
   }
 
   // ------------------ bloom filter  ---------------------
   {
-    bloom_renderpass.init(&gui_Device, gui_SwapChain.extent);
+    bloom_renderpass.init(&gui_Device, &frame_graph, gui_SwapChain.extent);
+  }
+
+  // ------------------ render graph  ---------------------
+
+  build_render_graph();
+
+  // bloom descriptor, the graph has the images in shader read layout when they are sampled
+  {
     std::vector<VkDescriptorImageInfo> img_infos{
         VkDescriptorImageInfo{hdr_renderpass.sampler.sampler,
-                              hdr_renderpass.attchment_Resolve_0.view.image_view,
-                              VK_IMAGE_LAYOUT_GENERAL},
+                              frame_graph.view(hdr_renderpass.attchment_Resolve_0),
+                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
         VkDescriptorImageInfo{hdr_renderpass.sampler.sampler,
-                              hdr_renderpass.attchment_Resolve_1.view.image_view,
-                              VK_IMAGE_LAYOUT_GENERAL},
+                              frame_graph.view(hdr_renderpass.attchment_Resolve_1),
+                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
     };
-    bloom_renderpass.construct_descriptor(&uni_pool, img_infos);
+    bloom_renderpass.construct_descriptor(&uni_allocator, img_infos);
   }
 
   // MSAA descriptor
   {
     std::vector<VkDescriptorImageInfo> img_infos{
         VkDescriptorImageInfo{hdr_renderpass.sampler.sampler,
-                              hdr_renderpass.attchment_Resolve_0.view.image_view,
-                              VK_IMAGE_LAYOUT_GENERAL},
+                              frame_graph.view(hdr_renderpass.attchment_Resolve_0),
+                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
         VkDescriptorImageInfo{bloom_renderpass.sampler.sampler,
-                              bloom_renderpass.attchment_FloatingPoint.view.image_view,
-                              VK_IMAGE_LAYOUT_GENERAL},
+                              frame_graph.view(bloom_renderpass.attchment_FloatingPoint),
+                              VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL},
     };
-    msaa_renderpass.construct_descriptor(&uni_pool, img_infos);
+    msaa_renderpass.construct_descriptor(&uni_allocator, img_infos);
   }
 
   // ---------------------  Models  ------------------------
@@ -256,8 +275,8 @@ int SngoEngine::Imgui::ImguiApplication::init()
 
   // --------------------- Semaphore ------------------------
 
-  gui_Fences.init(&gui_Device, Core::Macro::MAX_FRAMES_IN_FLIGHT);
-  fmt::println("gui_Fences created");
+  frame_timeline.init(&gui_Device, frames_InFlight);
+  fmt::println("frame_timeline created, {} frames in flight", frame_timeline.frames_in_flight);
 
   gui_ImageAcquiredSemaphores.init(&gui_Device, semaphore_count);
   gui_RenderCompleteSemaphores.init(&gui_Device, semaphore_count);
@@ -297,8 +316,9 @@ int SngoEngine::Imgui::ImguiApplication::init()
   init_info.DescriptorPool = gui_DescriptorPool.descriptor_pool;
   init_info.RenderPass = msaa_renderpass.renderpass.render_pass;
   init_info.Subpass = 1;
-  init_info.MinImageCount = frames_InFlight;
-  init_info.ImageCount = Core::Macro::MAX_FRAMES_IN_FLIGHT;
+  init_info.MinImageCount = Image_count;
+  // imgui keeps a vertex buffer per image, enough for every frame slot
+  init_info.ImageCount = std::max<uint32_t>(Image_count, Core::Macro::MAX_FRAMES_IN_FLIGHT);
   init_info.MSAASamples = sampler_flag;
   init_info.Allocator = nullptr;
   init_info.CheckVkResultFn = check_vk_result;
@@ -324,6 +344,11 @@ int SngoEngine::Imgui::ImguiApplication::init()
       // flags.
       auto now = clock();
 
+      // low latency: let the GPU finish everything queued before the input of the next frame is
+      // sampled, so it is not displayed behind frames_InFlight older ones
+      if (low_latency)
+        frame_timeline.wait_idle();
+
       glfwPollEvents();
 
       // if (33 > 1000.0f / io.Framerate)
@@ -373,6 +398,16 @@ int SngoEngine::Imgui::ImguiApplication::init()
         ImGui::Checkbox("Bloom", &will_bloom);
 
         ImGui::InputFloat("Exposure", &exposure, 0.025f, 3);
+
+        int frames_in_flight{static_cast<int>(frames_InFlight)};
+        if (ImGui::SliderInt(
+                "frames in flight", &frames_in_flight, 1, Core::Macro::MAX_FRAMES_IN_FLIGHT))
+          {
+            // takes effect with the next frame, the slots already cover the maximum
+            frame_timeline.set_frames_in_flight(frames_in_flight);
+            frames_InFlight = frame_timeline.frames_in_flight;
+          }
+        ImGui::Checkbox("low latency", &low_latency);
         // if (ImGui::Checkbox("use MSAA", &use_sampler_shading))
         //   {
         // TODO: runtime toggle MSAA not support, waitting for better structure
@@ -436,6 +471,77 @@ int SngoEngine::Imgui::ImguiApplication::init()
 
         ImGui::Text(
             "Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+        // lazily allocated targets only show up here once the device has to back them
+        ImGui::Text("render targets: %llu of %llu MiB backed",
+                    static_cast<unsigned long long>(frame_graph.committed() >> 20),
+                    static_cast<unsigned long long>(frame_graph.report.requested >> 20));
+
+        const auto stream{texture_streamer.progress()};
+        if (!texture_streamer.idle())
+          {
+            const uint32_t done{stream.resident + stream.failed};
+            const std::string overlay{fmt::format("textures {}/{}, {:.1f} MiB uploaded",
+                                                  done,
+                                                  stream.requested,
+                                                  static_cast<double>(stream.uploaded_bytes)
+                                                      / (1 << 20))};
+            ImGui::ProgressBar(static_cast<float>(done) / static_cast<float>(stream.requested),
+                               ImVec2(-1.0f, 0.0f),
+                               overlay.c_str());
+          }
+        // requested is what the visible texel densities ask for, resident stays within budget
+        ImGui::Text("texture memory: %.1f MiB resident, %.1f MiB requested",
+                    static_cast<double>(stream.resident_bytes) / (1 << 20),
+                    static_cast<double>(stream.requested_bytes) / (1 << 20));
+        int budget_mib{static_cast<int>(texture_MemoryBudget >> 20)};
+        if (ImGui::SliderInt("texture budget (MiB)", &budget_mib, 16, 2048))
+          {
+            texture_MemoryBudget = VkDeviceSize(budget_mib) << 20;
+            texture_streamer.memory_budget = texture_MemoryBudget;
+          }
+        const auto mips{Core::Source::Image::Mip_ChainStats()};
+        if (mips.chains > 0)
+          {
+            ImGui::Text("mip chains: %u built, %.1f ms per megapixel",
+                        mips.chains,
+                        mips.ms / mips.megapixels);
+          }
+        const auto transcodes{Core::Source::Image::Ktx_TranscodeStats()};
+        if (transcodes.textures > 0)
+          {
+            ImGui::Text("ktx2 transcodes: %u, %.1f Mtexel/s, %.1f MiB read, %.1f MiB uploaded",
+                        transcodes.textures,
+                        transcodes.megatexels / (transcodes.ms * 1e-3),
+                        static_cast<double>(transcodes.encoded_bytes) / (1 << 20),
+                        static_cast<double>(transcodes.transcoded_bytes) / (1 << 20));
+          }
+
+        if (ImGui::CollapsingHeader("job system"))
+          {
+            const auto stats{Core::Utils::Job_System().stats()};
+            for (size_t i = 0; i < stats.size(); i++)
+              {
+                const double total{stats[i].busy_ms + stats[i].idle_ms};
+                ImGui::Text("%s %zu: %.0f%% busy, %llu jobs, %llu stolen",
+                            i + 1 < stats.size() ? "worker" : "callers",
+                            i,
+                            total > 0.0 ? 100.0 * stats[i].busy_ms / total : 0.0,
+                            static_cast<unsigned long long>(stats[i].executed),
+                            static_cast<unsigned long long>(stats[i].stolen));
+              }
+            if (ImGui::Button("reset"))
+              Core::Utils::Job_System().reset_stats();
+          }
+        if (ImGui::CollapsingHeader("spectrum arenas"))
+          {
+            const auto spectra{Core::PBRT::Spectrum::Spectrum_ArenaStats()};
+            ImGui::Text("spectrum: %llu allocations, %.1f KiB in %llu blocks",
+                        static_cast<unsigned long long>(spectra.allocations),
+                        static_cast<double>(spectra.upstream_bytes) / (1 << 10),
+                        static_cast<unsigned long long>(spectra.upstream_blocks));
+            if (ImGui::Button("print"))
+              Core::PBRT::Spectrum::Print_ArenaStats();
+          }
 
         ImGui::End();
       }
@@ -509,22 +615,17 @@ int SngoEngine::Imgui::ImguiApplication::init()
 void SngoEngine::Imgui::ImguiApplication::Render_Frame(ImDrawData* draw_data,
                                                        std::vector<VkClearValue>& gui_Clearvalue)
 {
+  // waits until the frame that used this slot has left the GPU
+  Frame_Index = frame_timeline.begin_frame();
   VkSemaphore img_ac_semaphore{gui_ImageAcquiredSemaphores[Frame_Index]};
   VkSemaphore render_ok_semaphore{gui_RenderCompleteSemaphores[Frame_Index]};
 
-  auto err = vkWaitForFences(gui_Device.logical_device,
-                             1,
-                             &gui_Fences[Frame_Index],
-                             VK_TRUE,
-                             UINT64_MAX);  // wait indefinitely instead of periodically checking
-  check_vk_result(err);
-
-  err = vkAcquireNextImageKHR(gui_Device.logical_device,
-                              gui_SwapChain.swap_chain,
-                              UINT64_MAX,
-                              img_ac_semaphore,
-                              VK_NULL_HANDLE,
-                              &imageIndex);
+  auto err = vkAcquireNextImageKHR(gui_Device.logical_device,
+                                   gui_SwapChain.swap_chain,
+                                   UINT64_MAX,
+                                   img_ac_semaphore,
+                                   VK_NULL_HANDLE,
+                                   &imageIndex);
 
   if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
     {
@@ -533,12 +634,7 @@ void SngoEngine::Imgui::ImguiApplication::Render_Frame(ImDrawData* draw_data,
     }
   check_vk_result(err);
 
-  {
-    update_uniform_buffer(Frame_Index);
-
-    err = vkResetFences(gui_Device.logical_device, 1, &gui_Fences[Frame_Index]);
-    check_vk_result(err);
-  }
+  update_uniform_buffer(Frame_Index);
 
   {
     err = vkResetCommandBuffer(gui_CommandBuffers[Frame_Index].command_buffer, 0);
@@ -552,21 +648,91 @@ void SngoEngine::Imgui::ImguiApplication::Render_Frame(ImDrawData* draw_data,
     check_vk_result(err);
   }
 
-  VkRenderPassBeginInfo render_pass_begin_info{};
-
-  render_pass_begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-  render_pass_begin_info.renderPass = hdr_renderpass.renderpass();
-  render_pass_begin_info.framebuffer = hdr_renderpass.framebuffer();
-  render_pass_begin_info.renderArea.offset = {0, 0};
-  render_pass_begin_info.renderArea.extent = gui_SwapChain.extent;
-  render_pass_begin_info.clearValueCount = gui_Clearvalue.size();
-  render_pass_begin_info.pClearValues = gui_Clearvalue.data();
+  // ahead of the graph, so the passes see the textures (and descriptors) it completes
+  old_school.request_mips(main_Camera.matrices.view,
+                          main_Camera.matrices.perspective,
+                          static_cast<float>(gui_SwapChain.extent.height));
+  texture_streamer.update(gui_CommandBuffers[Frame_Index](), Frame_Index);
+  if (indirect_draws)
+    {
+      old_school.update_indirect(
+          Frame_Index, main_Camera.matrices.view, main_Camera.matrices.perspective);
+    }
 
-  vkCmdBeginRenderPass(gui_CommandBuffers[Frame_Index].command_buffer,
-                       &render_pass_begin_info,
-                       VK_SUBPASS_CONTENTS_INLINE);
+  // barriers, culling and attachment memory are the graph's, see build_render_graph
+  gui_DrawData = draw_data;
+  frame_graph.bind_import(msaa_renderpass.attchment_Present,
+                          gui_SwapChain.images[imageIndex],
+                          gui_SwapChain.image_views[imageIndex]);
+  frame_graph.execute(gui_CommandBuffers[Frame_Index]());
 
   {
+    // the binary semaphore is for presenting, the timeline value retires the frame's slot
+    const std::array<VkSemaphore, 2> signal_semaphores{render_ok_semaphore,
+                                                       frame_timeline.semaphore};
+    const std::array<uint64_t, 2> signal_values{0, frame_timeline.signal_value()};
+    VkTimelineSemaphoreSubmitInfo timeline_info{};
+    timeline_info.sType = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+    timeline_info.signalSemaphoreValueCount = static_cast<uint32_t>(signal_values.size());
+    timeline_info.pSignalSemaphoreValues = signal_values.data();
+
+    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+    VkSubmitInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    info.pNext = &timeline_info;
+    info.waitSemaphoreCount = 1;
+    info.pWaitSemaphores = &img_ac_semaphore;
+    info.pWaitDstStageMask = &wait_stage;
+    info.commandBufferCount = 1;
+    info.pCommandBuffers = &gui_CommandBuffers[Frame_Index].command_buffer;
+    info.signalSemaphoreCount = static_cast<uint32_t>(signal_semaphores.size());
+    info.pSignalSemaphores = signal_semaphores.data();
+
+    err = vkEndCommandBuffer(gui_CommandBuffers[Frame_Index].command_buffer);
+    check_vk_result(err);
+    err = vkQueueSubmit(gui_Device.graphics_queue, 1, &info, VK_NULL_HANDLE);
+    check_vk_result(err);
+    frame_timeline.end_frame();
+  }
+}
+
+void SngoEngine::Imgui::ImguiApplication::Present_Frame()
+{
+  if (gui_SwapChainRebuild)
+    return;
+  VkSemaphore render_complete_semaphore{gui_RenderCompleteSemaphores[Frame_Index]};
+  VkPresentInfoKHR info = {};
+  info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
+  info.waitSemaphoreCount = 1;
+  info.pWaitSemaphores = &render_complete_semaphore;
+  info.swapchainCount = 1;
+  info.pSwapchains = &gui_SwapChain.swap_chain;
+  info.pImageIndices = &imageIndex;
+  VkResult err = vkQueuePresentKHR(gui_Device.graphics_queue, &info);
+  if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
+    {
+      gui_SwapChainRebuild = true;
+      return;
+    }
+  check_vk_result(err);
+}
+
+void SngoEngine::Imgui::ImguiApplication::build_render_graph()
+{
+  // HDR scene into the floating point attachments
+  auto scene{[this](VkCommandBuffer command_buffer) {
+    VkRenderPassBeginInfo render_pass_begin_info{};
+
+    render_pass_begin_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    render_pass_begin_info.renderPass = hdr_renderpass.renderpass();
+    render_pass_begin_info.framebuffer = hdr_renderpass.framebuffer();
+    render_pass_begin_info.renderArea.offset = {0, 0};
+    render_pass_begin_info.renderArea.extent = gui_SwapChain.extent;
+    render_pass_begin_info.clearValueCount = gui_Clearvalue.size();
+    render_pass_begin_info.pClearValues = gui_Clearvalue.data();
+
+    vkCmdBeginRenderPass(command_buffer, &render_pass_begin_info, VK_SUBPASS_CONTENTS_INLINE);
+
     VkViewport viewport{};
     viewport.x = 0.0f;
     viewport.y = 0.0f;
@@ -574,21 +740,20 @@ void SngoEngine::Imgui::ImguiApplication::Render_Frame(ImDrawData* draw_data,
     viewport.height = static_cast<float>(gui_SwapChain.extent.height);
     viewport.minDepth = 0.0f;
     viewport.maxDepth = 1.0f;
-    vkCmdSetViewport(gui_CommandBuffers[Frame_Index].command_buffer, 0, 1, &viewport);
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
 
     VkRect2D scissor{};
     scissor.offset = {0, 0};
     scissor.extent = gui_SwapChain.extent;
-    vkCmdSetScissor(gui_CommandBuffers[Frame_Index].command_buffer, 0, 1, &scissor);
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
     // skybox_pipeline
-    vkCmdBindPipeline(gui_CommandBuffers[Frame_Index].command_buffer,
-                      VK_PIPELINE_BIND_POINT_GRAPHICS,
-                      skybox_GraphicPipeline.pipeline);
+    vkCmdBindPipeline(
+        command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, skybox_GraphicPipeline.pipeline);
 
     if (render_skybox)
       {
-        vkCmdBindDescriptorSets(gui_CommandBuffers[Frame_Index].command_buffer,
+        vkCmdBindDescriptorSets(command_buffer,
                                 VK_PIPELINE_BIND_POINT_GRAPHICS,
                                 skybox_Pipelinelayout.pipeline_layout,
                                 1,
@@ -597,93 +762,121 @@ void SngoEngine::Imgui::ImguiApplication::Render_Frame(ImDrawData* draw_data,
                                 0,
                                 nullptr);
 
-        vkCmdBindDescriptorSets(gui_CommandBuffers[Frame_Index].command_buffer,
+        vkCmdBindDescriptorSets(command_buffer,
                                 VK_PIPELINE_BIND_POINT_GRAPHICS,
                                 skybox_Pipelinelayout.pipeline_layout,
                                 0,
                                 1,
                                 &uni_set.descriptor_set,
-                                0,
-                                nullptr);
+                                1,
+                                &uniform_offset);
 
-        sky_box.draw(gui_CommandBuffers[Frame_Index].command_buffer,
-                     skybox_Pipelinelayout.pipeline_layout,
-                     1);
+        sky_box.draw(command_buffer, skybox_Pipelinelayout.pipeline_layout, 1);
       }
 
     // render model
-    vkCmdBindPipeline(gui_CommandBuffers[Frame_Index].command_buffer,
-                      VK_PIPELINE_BIND_POINT_GRAPHICS,
-                      model_GraphicPipeline.pipeline);
+    vkCmdBindPipeline(
+        command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, model_GraphicPipeline.pipeline);
 
-    vkCmdBindDescriptorSets(gui_CommandBuffers[Frame_Index].command_buffer,
+    vkCmdBindDescriptorSets(command_buffer,
                             VK_PIPELINE_BIND_POINT_GRAPHICS,
                             model_Pipelinelayout.pipeline_layout,
                             0,
                             1,
                             &uni_set.descriptor_set,
-                            0,
-                            nullptr);
+                            1,
+                            &uniform_offset);
+    if (old_school.bindless.enabled)
+      old_school.bind_bindless(
+          command_buffer, model_Pipelinelayout.pipeline_layout, Frame_Index, 1);
 
-    old_school.bind_buffers(gui_CommandBuffers[Frame_Index].command_buffer);
-    old_school.draw(gui_CommandBuffers[Frame_Index].command_buffer,
-                    model_Pipelinelayout.pipeline_layout);
-  }
+    // indirect batches carry every alpha mode, renderFlags 0 draws them all
+    if (model_CompactPipelines.empty())
+      {
+        old_school.bind_buffers(command_buffer);
+        if (indirect_draws)
+          old_school.draw_indirect(
+              command_buffer, model_Pipelinelayout.pipeline_layout, Frame_Index, 2, 0);
+        else
+          old_school.draw(command_buffer, model_Pipelinelayout.pipeline_layout);
+      }
+    for (uint32_t r = 0; r < model_CompactPipelines.size(); r++)
+      {
+        vkCmdBindPipeline(command_buffer,
+                          VK_PIPELINE_BIND_POINT_GRAPHICS,
+                          model_CompactPipelines[r].pipeline);
+        old_school.bind_compactBuffers(command_buffer, r);
+        if (indirect_draws)
+          old_school.draw_indirect(command_buffer,
+                                   model_Pipelinelayout.pipeline_layout,
+                                   Frame_Index,
+                                   2,
+                                   0,
+                                   static_cast<int32_t>(r));
+        else
+          old_school.draw_compact(command_buffer, model_Pipelinelayout.pipeline_layout, r);
+      }
 
-  // Submit command buffer
-  vkCmdEndRenderPass(gui_CommandBuffers[Frame_Index].command_buffer);
+    vkCmdEndRenderPass(command_buffer);
+  }};
+  hdr_renderpass.add_pass(&frame_graph, scene);
 
-  if (will_bloom)
-    {
-      std::vector<VkClearValue> clearValues{2};
-      clearValues[0].color = {{0.0f, 0.0f, 0.0f, 0.0f}};
-      clearValues[1].depthStencil = {1.0f, 0};
-
-      // Bloom filter
-      VkRenderPassBeginInfo renderPassBeginInfo{};
-      renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-      renderPassBeginInfo.framebuffer = bloom_renderpass.framebuffer();
-      renderPassBeginInfo.renderPass = bloom_renderpass.renderpass();
-      renderPassBeginInfo.clearValueCount = 1;
-      renderPassBeginInfo.renderArea.extent.width = bloom_renderpass.extent.width;
-      renderPassBeginInfo.renderArea.extent.height = bloom_renderpass.extent.height;
-      renderPassBeginInfo.pClearValues = clearValues.data();
-
-      vkCmdBeginRenderPass(
-          gui_CommandBuffers[Frame_Index](), &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-      VkViewport viewport = Core::Render::RenderPass::Get_ViewPort(
-          (float)bloom_renderpass.extent.width, (float)bloom_renderpass.extent.height, 0.0f, 1.0f);
-      vkCmdSetViewport(gui_CommandBuffers[Frame_Index](), 0, 1, &viewport);
-
-      VkRect2D scissor = Core::Render::RenderPass::Get_Rect2D(
-          bloom_renderpass.extent.width, bloom_renderpass.extent.height, 0, 0);
-      vkCmdSetScissor(gui_CommandBuffers[Frame_Index](), 0, 1, &scissor);
-
-      vkCmdBindDescriptorSets(gui_CommandBuffers[Frame_Index](),
-                              VK_PIPELINE_BIND_POINT_GRAPHICS,
-                              bloom_renderpass.pipeline_layout(),
-                              0,
-                              1,
-                              &bloom_renderpass.bloom_set.descriptor_set,
-                              0,
-                              nullptr);
-
-      vkCmdBindPipeline(gui_CommandBuffers[Frame_Index](),
-                        VK_PIPELINE_BIND_POINT_GRAPHICS,
-                        bloom_renderpass.pipelines[1]());
-      vkCmdDraw(gui_CommandBuffers[Frame_Index](), 3, 1, 0, 0);
-
-      vkCmdEndRenderPass(gui_CommandBuffers[Frame_Index]());
-    }
+  // Bloom filter, still clears its target when bloom is off so the composition adds nothing
+  auto bloom{[this](VkCommandBuffer command_buffer) {
+    std::vector<VkClearValue> clearValues{1};
+    clearValues[0].color = {{0.0f, 0.0f, 0.0f, 0.0f}};
 
-  {
+    VkRenderPassBeginInfo renderPassBeginInfo{};
+    renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    renderPassBeginInfo.framebuffer = bloom_renderpass.framebuffer();
+    renderPassBeginInfo.renderPass = bloom_renderpass.renderpass();
+    renderPassBeginInfo.clearValueCount = 1;
+    renderPassBeginInfo.renderArea.extent.width = bloom_renderpass.extent.width;
+    renderPassBeginInfo.renderArea.extent.height = bloom_renderpass.extent.height;
+    renderPassBeginInfo.pClearValues = clearValues.data();
+
+    vkCmdBeginRenderPass(command_buffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+    if (will_bloom)
+      {
+        VkViewport viewport =
+            Core::Render::RenderPass::Get_ViewPort((float)bloom_renderpass.extent.width,
+                                                   (float)bloom_renderpass.extent.height,
+                                                   0.0f,
+                                                   1.0f);
+        vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+
+        VkRect2D scissor = Core::Render::RenderPass::Get_Rect2D(
+            bloom_renderpass.extent.width, bloom_renderpass.extent.height, 0, 0);
+        vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+
+        vkCmdBindDescriptorSets(command_buffer,
+                                VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                bloom_renderpass.pipeline_layout(),
+                                0,
+                                1,
+                                &bloom_renderpass.bloom_set.descriptor_set,
+                                0,
+                                nullptr);
+
+        vkCmdBindPipeline(
+            command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bloom_renderpass.pipelines[1]());
+        vkCmdDraw(command_buffer, 3, 1, 0, 0);
+      }
+
+    vkCmdEndRenderPass(command_buffer);
+  }};
+  bloom_renderpass.add_pass(&frame_graph, bloom)
+      .read(hdr_renderpass.attchment_Resolve_0, Core::Render::GraphUsage::Sampled)
+      .read(hdr_renderpass.attchment_Resolve_1, Core::Render::GraphUsage::Sampled);
+
+  // Final composition and gui into the swap chain image
+  auto composition{[this](VkCommandBuffer command_buffer) {
     VkClearValue clearValues[3];
     clearValues[0].color = {{0.0f, 0.0f, 0.0f, 0.0f}};
     clearValues[1].color = {{0.0f, 0.0f, 0.0f, 0.0f}};
     clearValues[2].depthStencil = {1.0f, 0};
 
-    // Final composition
     VkRenderPassBeginInfo renderPassBeginInfo{};
     renderPassBeginInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
     renderPassBeginInfo.framebuffer = msaa_renderpass.framebuffers[imageIndex];
@@ -693,19 +886,17 @@ void SngoEngine::Imgui::ImguiApplication::Render_Frame(ImDrawData* draw_data,
     renderPassBeginInfo.renderArea.extent.height = msaa_renderpass.extent.height;
     renderPassBeginInfo.pClearValues = clearValues;
 
-    vkCmdBeginRenderPass(
-        gui_CommandBuffers[Frame_Index](), &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdBeginRenderPass(command_buffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
 
     VkViewport viewport = Core::Render::RenderPass::Get_ViewPort(
         (float)msaa_renderpass.extent.width, (float)msaa_renderpass.extent.height, 0.0f, 1.0f);
-    vkCmdSetViewport(gui_CommandBuffers[Frame_Index](), 0, 1, &viewport);
+    vkCmdSetViewport(command_buffer, 0, 1, &viewport);
 
     VkRect2D scissor = Core::Render::RenderPass::Get_Rect2D(
         msaa_renderpass.extent.width, msaa_renderpass.extent.height, 0, 0);
+    vkCmdSetScissor(command_buffer, 0, 1, &scissor);
 
-    vkCmdSetScissor(gui_CommandBuffers[Frame_Index](), 0, 1, &scissor);
-
-    vkCmdBindDescriptorSets(gui_CommandBuffers[Frame_Index](),
+    vkCmdBindDescriptorSets(command_buffer,
                             VK_PIPELINE_BIND_POINT_GRAPHICS,
                             msaa_renderpass.pipeline_layout(),
                             0,
@@ -715,70 +906,48 @@ void SngoEngine::Imgui::ImguiApplication::Render_Frame(ImDrawData* draw_data,
                             nullptr);
 
     // Scene
-    vkCmdBindPipeline(gui_CommandBuffers[Frame_Index](),
-                      VK_PIPELINE_BIND_POINT_GRAPHICS,
-                      msaa_renderpass.pipeline());
-    vkCmdDraw(gui_CommandBuffers[Frame_Index](), 3, 1, 0, 0);
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, msaa_renderpass.pipeline());
+    vkCmdDraw(command_buffer, 3, 1, 0, 0);
 
-    vkCmdNextSubpass(gui_CommandBuffers[Frame_Index].command_buffer, VK_SUBPASS_CONTENTS_INLINE);
+    vkCmdNextSubpass(command_buffer, VK_SUBPASS_CONTENTS_INLINE);
     // Record dear imgui primitives into command buffer
-    ImGui_ImplVulkan_RenderDrawData(draw_data, gui_CommandBuffers[Frame_Index]());
-
-    vkCmdEndRenderPass(gui_CommandBuffers[Frame_Index].command_buffer);
-  }
-
-  {
-    VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    VkSubmitInfo info = {};
-    info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    info.waitSemaphoreCount = 1;
-    info.pWaitSemaphores = &img_ac_semaphore;
-    info.pWaitDstStageMask = &wait_stage;
-    info.commandBufferCount = 1;
-    info.pCommandBuffers = &gui_CommandBuffers[Frame_Index].command_buffer;
-    info.signalSemaphoreCount = 1;
-    info.pSignalSemaphores = &render_ok_semaphore;
-
-    err = vkEndCommandBuffer(gui_CommandBuffers[Frame_Index].command_buffer);
-    check_vk_result(err);
-    err = vkQueueSubmit(gui_Device.graphics_queue, 1, &info, gui_Fences[Frame_Index]);
-    check_vk_result(err);
-  }
-}
-
-void SngoEngine::Imgui::ImguiApplication::Present_Frame()
-{
-  if (gui_SwapChainRebuild)
-    return;
-  VkSemaphore render_complete_semaphore{gui_RenderCompleteSemaphores[Frame_Index]};
-  VkPresentInfoKHR info = {};
-  info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
-  info.waitSemaphoreCount = 1;
-  info.pWaitSemaphores = &render_complete_semaphore;
-  info.swapchainCount = 1;
-  info.pSwapchains = &gui_SwapChain.swap_chain;
-  info.pImageIndices = &imageIndex;
-  VkResult err = vkQueuePresentKHR(gui_Device.graphics_queue, &info);
-  if (err == VK_ERROR_OUT_OF_DATE_KHR || err == VK_SUBOPTIMAL_KHR)
-    {
-      gui_SwapChainRebuild = true;
-      return;
-    }
-  check_vk_result(err);
-  Frame_Index = (Frame_Index + 1) % Core::Macro::MAX_FRAMES_IN_FLIGHT;
+    ImGui_ImplVulkan_RenderDrawData(gui_DrawData, command_buffer);
+
+    vkCmdEndRenderPass(command_buffer);
+  }};
+  msaa_renderpass.add_pass(&frame_graph, composition)
+      .read(hdr_renderpass.attchment_Resolve_0, Core::Render::GraphUsage::Sampled)
+      .read(bloom_renderpass.attchment_FloatingPoint, Core::Render::GraphUsage::Sampled);
+
+  frame_graph.compile();
+
+  hdr_renderpass.construct_framebuffer(&frame_graph);
+  bloom_renderpass.construct_framebuffer(&frame_graph);
+  msaa_renderpass.construct_framebuffer(&frame_graph, &gui_SwapChain);
+
+  fmt::println(
+      "render graph compiled: {} passes culled, {} of {} MiB in {} memory blocks, {} MiB lazily "
+      "allocated, {} MiB saved",
+      frame_graph.report.culled,
+      frame_graph.report.allocated >> 20,
+      frame_graph.report.requested >> 20,
+      frame_graph.report.blocks,
+      frame_graph.report.lazy >> 20,
+      (frame_graph.report.requested - frame_graph.committed()) >> 20);
 }
 
 void SngoEngine::Imgui::ImguiApplication::construct_pipeline()
 {
+  // attributes and shader prologue have to agree on the input locations
+  const int model_components{Core::Source::Model::GLTF_EngineModelVertexData::POS
+                             | Core::Source::Model::GLTF_EngineModelVertexData::NORMAL
+                             | Core::Source::Model::GLTF_EngineModelVertexData::UV
+                             | Core::Source::Model::GLTF_EngineModelVertexData::TANGENT};
   std::vector<VkVertexInputBindingDescription> binding_description = {
       Core::Source::Model::GLTF_EngineModelVertexData::getBindingDescription()};
   auto attribute_descriptions =
-      Core::Source::Model::GLTF_EngineModelVertexData::getAttributeDescriptions(
-          Core::Source::Model::GLTF_EngineModelVertexData::POS
-              | Core::Source::Model::GLTF_EngineModelVertexData::NORMAL
-              | Core::Source::Model::GLTF_EngineModelVertexData::UV
-              | Core::Source::Model::GLTF_EngineModelVertexData::TANGENT,
-          0);
+      Core::Source::Model::GLTF_EngineModelVertexData::getAttributeDescriptions(model_components,
+                                                                                0);
   VkPipelineVertexInputStateCreateInfo vertex_input{
       Core::Data::GetVertexInput_Info(binding_description, attribute_descriptions)};
 
@@ -798,11 +967,20 @@ void SngoEngine::Imgui::ImguiApplication::construct_pipeline()
 
   // -------------------- pipeline layout ---------------------
 
+  // the loader drops BindlessMaterials when the device has no descriptor indexing
+  const bool bindless{old_school.bindless.enabled};
+  std::string material_prologue{bindless ? "#define SNGO_BINDLESS 1\n" : ""};
+  std::vector<VkDescriptorSetLayout> model_setlayouts{
+      uni_setlayout.layout,
+      bindless ? old_school.layouts.bindless.layout : old_school.layouts.texture.layout};
+  if (indirect_draws)
+    {
+      material_prologue += "#define SNGO_INDIRECT 1\n";
+      model_setlayouts.push_back(old_school.layouts.draws.layout);
+    }
+
   std::vector<VkPushConstantRange> ranges{};
-  model_Pipelinelayout.init(
-      &gui_Device,
-      std::vector<VkDescriptorSetLayout>{uni_setlayout.layout, old_school.layouts.texture.layout},
-      ranges);
+  model_Pipelinelayout.init(&gui_Device, model_setlayouts, ranges);
 
   skybox_Pipelinelayout.init(
       &gui_Device,
@@ -811,8 +989,15 @@ void SngoEngine::Imgui::ImguiApplication::construct_pipeline()
 
   // -------------------- shader code ---------------------
 
+  // only the variant shaders know the bindless set
   auto model_shader_stages{Core::Source::Pipeline::EngineShaderStage(
-      &gui_Device, MODEL_VertexShader_code, MODEL_FragmentShader_code)};
+      &gui_Device,
+      bindless ? MODEL_VariantVertexShader_code : MODEL_VertexShader_code,
+      bindless ? MODEL_VariantFragmentShader_code : MODEL_FragmentShader_code,
+      "main",
+      "main",
+      Core::Source::Model::Vertex_ShaderPrologue(model_components) + material_prologue,
+      material_prologue)};
 
   auto skybox_shader_stages{Core::Source::Pipeline::EngineShaderStage(
       &gui_Device, SKYBOX_VertexShader_code, SKYBOX_FragmentShader_code)};
@@ -826,6 +1011,33 @@ void SngoEngine::Imgui::ImguiApplication::construct_pipeline()
                              &pipeline_info,
                              0);
 
+  // every compact region packs its vertices differently, so each gets its own permutation
+  model_CompactPipelines.resize(old_school.compact.regions.size());
+  for (size_t r = 0; r < old_school.compact.regions.size(); r++)
+    {
+      const auto& layout{old_school.compact.regions[r].layout};
+      std::vector<VkVertexInputBindingDescription> compact_binding{layout.getBindingDescription(0)};
+      auto compact_attributes{layout.getAttributeDescriptions(model_components, 0)};
+      pipeline_info.vertex_input =
+          Core::Data::GetVertexInput_Info(compact_binding, compact_attributes);
+
+      auto compact_stages{
+          Core::Source::Pipeline::EngineShaderStage(&gui_Device,
+                                                    MODEL_VariantVertexShader_code,
+                                                    MODEL_VariantFragmentShader_code,
+                                                    "main",
+                                                    "main",
+                                                    layout.shader_prologue(model_components)
+                                                        + material_prologue,
+                                                    material_prologue)};
+      model_CompactPipelines[r].init(&gui_Device,
+                                     &model_Pipelinelayout,
+                                     &hdr_renderpass.renderpass,
+                                     compact_stages.stages,
+                                     &pipeline_info,
+                                     0);
+    }
+
   auto sky_box_attribute_descriptions =
       Core::Source::Model::GLTF_EngineModelVertexData::getAttributeDescriptions(
           Core::Source::Model::GLTF_EngineModelVertexData::POS, 0);
@@ -846,10 +1058,29 @@ void SngoEngine::Imgui::ImguiApplication::construct_pipeline()
 
 void SngoEngine::Imgui::ImguiApplication::load_model()
 {
-  old_school.init(MAIN_OLD_SCHOOL, &gui_Device, &gui_CommandPool);
+  // the window opens with placeholder textures, Render_Frame uploads the real ones as they decode
+  texture_streamer.init(&gui_Device, texture_StreamBudget, texture_MemoryBudget);
+  old_school.init(MAIN_OLD_SCHOOL,
+                  &gui_Device,
+                  &gui_CommandPool,
+                  nullptr,
+                  Core::Source::Model::PreTransformVertices | Core::Source::Model::FlipY
+                      | Core::Source::Model::CompressTextures
+                      | (compact_vertices ? Core::Source::Model::CompactVertices : 0u)
+                      | (bindless_materials || indirect_draws
+                             ? Core::Source::Model::BindlessMaterials
+                             : 0u)
+                      | (indirect_draws ? Core::Source::Model::IndirectDraws : 0u),
+                  &texture_streamer);
+  // indirect commands skip the material binds, the shaders need the bindless table instead
+  if (indirect_draws && !old_school.bindless.enabled)
+    {
+      fmt::println("[warn] indirect draws need bindless materials, drawing node by node");
+      indirect_draws = false;
+    }
   sky_box.init(CUBEMAP_FILE, CUBEMAP_TEXTURE, &gui_Device, &gui_CommandPool);
 
-  sky_box.generate_descriptor(uni_pool, skybox_setlayout, skybox_set, 1);
+  sky_box.generate_descriptor(uni_allocator, skybox_setlayout, skybox_set, 1);
 }
 
 void SngoEngine::Imgui::ImguiApplication::update_uniform_buffer(uint32_t current_frame)
@@ -860,7 +1091,8 @@ void SngoEngine::Imgui::ImguiApplication::update_uniform_buffer(uint32_t current
   ubo.inverseModelview = glm::inverse(main_Camera.matrices.view);
   ubo.lodBias = exposure;
 
-  memcpy(model_UniBuffer.mapped, &ubo, sizeof(ubo));
+  frame_uniforms.begin_frame(current_frame);
+  uniform_offset = frame_uniforms.push(ubo);
 }
 
 void SngoEngine::Imgui::ImguiApplication::binding_keymapping(ImGuiIO& io)
@@ -906,11 +1138,16 @@ void SngoEngine::Imgui::ImguiApplication::create_IMGUI_DescriptorPoor()
 void SngoEngine::Imgui::ImguiApplication::destroyer()
 {
   check_vk_result(vkDeviceWaitIdle(gui_Device.logical_device));
-  gui_Fences.destroyer();
+  frame_timeline.destroyer();
+  frame_uniforms.destroyer();
+  texture_streamer.destroyer();
   gui_ImageAcquiredSemaphores.destroyer();
   gui_RenderCompleteSemaphores.destroyer();
 
   model_GraphicPipeline.destroyer();
+  for (auto& pipeline : model_CompactPipelines)
+    pipeline.destroyer();
+  model_CompactPipelines.clear();
   model_Pipelinelayout.destroyer();
   skybox_GraphicPipeline.destroyer();
   skybox_Pipelinelayout.destroyer();
@@ -918,13 +1155,14 @@ void SngoEngine::Imgui::ImguiApplication::destroyer()
   uni_setlayout.destroyer();
   skybox_setlayout.destroyer();
   gui_DescriptorPool.destroyer();
-  uni_pool.destroyer();
+  uni_allocator.destroyer();
 
   old_school.destroyer();
   sky_box.destroyer();
   gui_CommandPool.destroyer();
 
   gui_SwapChain.destroyer();
+  frame_graph.destroyer();
 
   gui_Device.destroyer();
   gui_Surface.destroyer();
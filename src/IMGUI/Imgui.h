@@ -12,13 +12,16 @@
 #include "src/Core/Instance/DebugMessenger.hpp"
 #include "src/Core/Instance/Instance.hpp"
 #include "src/Core/Render/FrameBuffer.hpp"
+#include "src/Core/Render/RenderGraph.hpp"
 #include "src/Core/Render/RenderPass.hpp"
-#include "src/Core/Signalis/Fence.hpp"
 #include "src/Core/Signalis/Semaphore.hpp"
+#include "src/Core/Signalis/Timeline.hpp"
 #include "src/Core/Source/Buffer/CommandBuffer.hpp"
 #include "src/Core/Source/Buffer/Descriptor.hpp"
+#include "src/Core/Source/Buffer/FrameAllocator.hpp"
 #include "src/Core/Source/Buffer/UniformBuffer.hpp"
 #include "src/Core/Source/Image/DepthResource.hpp"
+#include "src/Core/Source/Image/TextureStreamer.hpp"
 #include "src/Core/Source/Model/Camera.hpp"
 #include "src/Core/Source/Model/Model.hpp"
 #include "src/Core/Source/Pipeline/Pipeline.hpp"
@@ -35,6 +38,9 @@ const std::string MODEL_texture_directory{"./textures/viking_room"};
 
 const std::string MODEL_VertexShader_code{"./shader/vertex_shader_normal.vs"};
 const std::string MODEL_FragmentShader_code{"./shader/frag_shader_normal.fs"};
+// sources in _shader/, read their inputs through the Vertex_ShaderPrologue macros
+const std::string MODEL_VariantVertexShader_code{"./shader/vertex_shader_model.vs"};
+const std::string MODEL_VariantFragmentShader_code{"./shader/frag_shader_model.fs"};
 
 const std::string SKYBOX_VertexShader_code{"./shader/vertex_shader_cubemap.vs"};
 const std::string SKYBOX_FragmentShader_code{"./shader/frag_shader_cubemap.fs"};
@@ -93,20 +99,28 @@ struct ImguiApplication
   Core::Source::RenderPipeline::EngineMSAA_RenderPass msaa_renderpass;
   Core::Source::RenderPipeline::EngineOffscreenHDR_RenderPass hdr_renderpass;
   Core::Source::RenderPipeline::EngineBloomFilter_RenderPass bloom_renderpass;
+  // owns the attachments of the three passes above and orders them
+  Core::Render::EngineRenderGraph frame_graph;
 
   Core::Source::Buffer::EngineCommandPool gui_CommandPool;
+  // one per frame slot, like the semaphores below
   std::vector<Core::Source::Buffer::EngineCommandBuffer> gui_CommandBuffers;
-  Core::Siganlis::EngineFences gui_Fences;
+  Core::Siganlis::EngineFrameTimeline frame_timeline;
   Core::Siganlis::EngineSemaphores gui_ImageAcquiredSemaphores;
   Core::Siganlis::EngineSemaphores gui_RenderCompleteSemaphores;
 
   Core::Source::Pipeline::EnginePipelineLayout model_Pipelinelayout;
   Core::Source::Pipeline::EngineGraphicPipeline model_GraphicPipeline;
+  // compact_vertices only: one per old_school.compact.regions entry
+  std::vector<Core::Source::Pipeline::EngineGraphicPipeline> model_CompactPipelines;
   Core::Source::Pipeline::EnginePipelineLayout skybox_Pipelinelayout;
   Core::Source::Pipeline::EngineGraphicPipeline skybox_GraphicPipeline;
 
-  Core::Source::Buffer::TransUniBuffer model_UniBuffer;
-  Core::Source::Descriptor::EngineDescriptorPool uni_pool;
+  // camera uniforms, a slice per frame slot bound with a dynamic offset
+  Core::Source::Buffer::EngineFrameAllocator frame_uniforms;
+  uint32_t uniform_offset{};
+  // grows with the scene instead of fixed pool counts
+  Core::Source::Descriptor::EngineDescriptorAllocator uni_allocator;
 
   Core::Source::Descriptor::EngineDescriptorSetLayout uni_setlayout;
   Core::Source::Descriptor::EngineDescriptorSet uni_set;
@@ -116,6 +130,8 @@ struct ImguiApplication
 
   Core::Device::LogicalDevice::EngineDevice gui_Device;
 
+  // decodes the model's images on the job system and uploads them from Render_Frame
+  Core::Source::Image::EngineTextureStreamer texture_streamer;
   Core::Source::Model::EngineGltfModel old_school;
   Core::Source::Model::EngineCubeMap sky_box;
   EngineCamera main_Camera;
@@ -138,6 +154,7 @@ struct ImguiApplication
   void Render_Frame(ImDrawData* draw_data, std::vector<VkClearValue>& gui_Clearvalue);
   void Present_Frame();
   void record_command_buffer(VkCommandBuffer m_command_buffer);
+  void build_render_graph();
   void construct_pipeline();
   void load_model();
   void update_uniform_buffer(uint32_t current_frame);
@@ -146,12 +163,33 @@ struct ImguiApplication
 
   std::string window_name{"imgui_pbrt Window"};
   VkExtent2D mainWindow_extent{1280, 720};
-  uint32_t frames_InFlight{2};
+  // 1 to MAX_FRAMES_IN_FLIGHT, set before init and adjustable in the gui; more frames in flight
+  // keep the GPU busier at the cost of input latency
+  uint32_t frames_InFlight{Core::Macro::DEFAULT_FRAMES_IN_FLIGHT};
+  // waits for the GPU to drain right before input is sampled
+  bool low_latency{false};
+  // staging bytes texture_streamer may copy per frame, set before init
+  VkDeviceSize texture_StreamBudget{VkDeviceSize{8} << 20};
+  // device memory for the model's mip chains, adjustable from the GUI
+  VkDeviceSize texture_MemoryBudget{VkDeviceSize{256} << 20};
+  // set before init: init only runs Benchmark_KtxTranscode on this file once the device exists
+  std::string benchmark_Ktx;
+  // set before init: loads the model with CompactVertices and draws it region by region
+  bool compact_vertices{false};
+  // set before init: one texture table and material buffer for the model instead of a set per
+  // material, ignored without descriptor indexing
+  bool bindless_materials{false};
+  // set before init: culls on the CPU and draws the model with one multi-draw per batch, needs
+  // bindless_materials and falls back to per-node draws without them
+  bool indirect_draws{false};
+  uint32_t benchmark_Iterations{16};
   uint32_t semaphore_count{};
   uint32_t Image_count{};
   uint32_t Frame_Index{};
   uint32_t Semaphore_Index{};
   uint32_t imageIndex{};
+  // read by the composition pass while the graph executes
+  ImDrawData* gui_DrawData{};
   bool render_skybox{true};
   bool use_sampler_shading{true};
   float exposure{1.00f};